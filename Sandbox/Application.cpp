@@ -52,11 +52,11 @@ int main(int argc, char* argv[]) {
 	renderer->SetCamera(&camera);
 
 	// basic shapes
-	vantor::Graphics::Geometry::Primitives::Plane plane(16, 16);
-	vantor::Graphics::Geometry::Primitives::Sphere sphere(64, 64);
-	vantor::Graphics::Geometry::Primitives::Sphere tSphere(256, 256);
-	vantor::Graphics::Geometry::Primitives::Torus torus(2.0f, 0.4f, 32, 32);
-	vantor::Graphics::Geometry::Primitives::Cube cube;
+	vantor::Graphics::Geometry::Primitives::Plane* plane = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetPlane(16, 16);
+	vantor::Graphics::Geometry::Primitives::Sphere* sphere = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetSphere(64, 64);
+	vantor::Graphics::Geometry::Primitives::Sphere* tSphere = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetSphere(256, 256);
+	vantor::Graphics::Geometry::Primitives::Torus* torus = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetTorus(2.0f, 0.4f, 32, 32);
+	vantor::Graphics::Geometry::Primitives::Cube* cube = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetCube();
 
 	// material setup
 	vantor::Graphics::RenderDevice::OpenGL::Material* matPbr = renderer->CreateMaterial();
@@ -73,10 +73,10 @@ int main(int argc, char* argv[]) {
 	camera.SetPerspective(glm::radians(60.0f), renderer->GetRenderSize().x / renderer->GetRenderSize().y, 0.1f, 100.0f);
 
 	// scene setup
-	vantor::SceneNode* mainTorus = vantor::Scene::MakeSceneNode(&torus, matPbr);
-	vantor::SceneNode* secondTorus = vantor::Scene::MakeSceneNode(&torus, matPbr);
-	vantor::SceneNode* thirdTorus = vantor::Scene::MakeSceneNode(&torus, matPbr);
-	vantor::SceneNode* plasmaOrb = vantor::Scene::MakeSceneNode(&tSphere, matPlasmaOrb);
+	vantor::SceneNode* mainTorus = vantor::Scene::MakeSceneNode(torus, matPbr);
+	vantor::SceneNode* secondTorus = vantor::Scene::MakeSceneNode(torus, matPbr);
+	vantor::SceneNode* thirdTorus = vantor::Scene::MakeSceneNode(torus, matPbr);
+	vantor::SceneNode* plasmaOrb = vantor::Scene::MakeSceneNode(tSphere, matPlasmaOrb);
 
 	mainTorus->AddChild(secondTorus);
 	secondTorus->AddChild(thirdTorus);
@@ -30,6 +30,8 @@
 #include <atomic>
 #include <thread>
 #include <condition_variable>
+#include <cstdlib>
+#include <memory>
 #include <sstream>
 #include <assert.h>
 
@@ -87,12 +89,31 @@ namespace vantor::Core::JobSystem
                                                               // threads just sleep when there is no job, and the main
                                                               // thread can wake them up
     std::mutex            wakeMutex;                          // used in conjunction with the wakeCondition above
-    uint64_t              currentLabel = 0;                   // tracks the state of execution of the main thread
+    std::atomic<uint64_t> currentLabel{0};                    // jobs submitted so far; atomic as ParallelFor may run in jobs
     std::atomic<uint64_t> finishedLabel;                      // track the state of execution across
                                                               // background worker threads
+    std::atomic<bool>     running{false};                     // cleared by shutdown() to let the workers return
+    std::atomic<uint32_t> liveWorkers{0};                     // workers which didn't return yet
+
+    // The workers are detached and would otherwise still sleep on
+    // wakeCondition while it is destroyed at exit, which blocks forever.
+    void shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            running.store(false);
+        }
+        wakeCondition.notify_all();
+        while (liveWorkers.load() > 0)
+        {
+            std::this_thread::yield();
+        }
+    }
 
     void Initialize()
     {
+        if (numThreads > 0) return;
+
         // Initialize the worker execution state to 0:
         finishedLabel.store(0);
 
@@ -101,6 +122,11 @@ namespace vantor::Core::JobSystem
 
         // Calculate the actual number of worker threads we want:
         numThreads = std::max(1u, numCores);
+        running.store(true);
+        liveWorkers.store(numThreads);
+        // registered after the statics above are constructed, so it runs
+        // before they are destroyed
+        std::atexit(shutdown);
 
         // Create all our worker threads while immediately starting them:
         for (uint32_t threadID = 0; threadID < numThreads; ++threadID)
@@ -111,8 +137,8 @@ namespace vantor::Core::JobSystem
                     std::function<void()> job; // the current job for the
                                                // thread, it's empty at start.
 
-                    // This is the infinite loop that a worker thread will do
-                    while (true)
+                    // This is the loop that a worker thread will do until shutdown
+                    while (running.load())
                     {
                         if (jobPool.pop_front(job)) // try to grab a job from
                                                     // the jobPool queue
@@ -125,9 +151,10 @@ namespace vantor::Core::JobSystem
                         {
                             // no job, put thread to sleep
                             std::unique_lock<std::mutex> lock(wakeMutex);
-                            wakeCondition.wait(lock);
+                            if (running.load()) wakeCondition.wait(lock);
                         }
                     }
+                    liveWorkers.fetch_sub(1);
                 });
 
 #ifdef _WIN32
@@ -165,6 +192,13 @@ namespace vantor::Core::JobSystem
 
     void Execute(const std::function<void()> &job)
     {
+        // nobody would ever pick it up
+        if (numThreads == 0)
+        {
+            job();
+            return;
+        }
+
         // The main thread label state is updated:
         currentLabel += 1;
 
@@ -236,4 +270,44 @@ namespace vantor::Core::JobSystem
             wakeCondition.notify_one(); // wake one thread
         }
     }
+
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t)> &job)
+    {
+        // indices are claimed one by one, so a helper that only gets to run
+        // after everything is done finds nothing left and never touches job
+        // (which may be gone by then); the state outlives it by refcount.
+        struct State
+        {
+                std::atomic<uint32_t> next{0};
+                std::atomic<uint32_t> done{0};
+        };
+        auto                                 state = std::make_shared<State>();
+        const std::function<void(uint32_t)> *body  = &job;
+        const auto                          &work  = [state, body, count]()
+        {
+            uint32_t i;
+            while ((i = state->next.fetch_add(1)) < count)
+            {
+                (*body)(i);
+                state->done.fetch_add(1);
+            }
+        };
+
+        // helpers are optional: when the queue is full, e.g. because this
+        // runs inside a job itself, waiting for space could block every
+        // worker, so the calling thread just does more of the work.
+        const uint32_t helpers = count > 0 ? std::min(numThreads, count - 1) : 0;
+        for (uint32_t i = 0; i < helpers; ++i)
+        {
+            if (!jobPool.push_back(work)) break;
+            currentLabel += 1;
+            wakeCondition.notify_one();
+        }
+
+        work();
+        while (state->done.load() < count)
+        {
+            std::this_thread::yield();
+        }
+    }
 } // namespace vantor::Core::JobSystem
\ No newline at end of file
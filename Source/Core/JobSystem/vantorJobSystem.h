@@ -39,8 +39,14 @@ struct JobDispatchArgs
 namespace vantor::Core::JobSystem
 {
     void Initialize();
+    // runs job on a worker; inline before Initialize()
     void Execute(const std::function<void()> &job);
     void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)> &job);
     bool IsBusy();
     void Wait();
+    // Runs job(i) for every i in [0, count) on the workers and the calling
+    // thread, returning once all indices ran. Unlike Dispatch + Wait it
+    // doesn't wait for unrelated jobs, runs inline before Initialize() and
+    // may be called from within jobs.
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t)> &job);
 } // namespace vantor::Core::JobSystem
\ No newline at end of file
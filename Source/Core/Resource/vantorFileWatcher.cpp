@@ -0,0 +1,158 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorFileWatcher.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorFileWatcher.hpp"
+#include "../BackLog/vantorBacklog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+#ifdef __LINUX__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace vantor
+{
+    namespace
+    {
+        // directory a watch has to be placed on; "" for the working directory
+        std::string directoryOf(const std::string &path) { return std::filesystem::path(path).parent_path().generic_string(); }
+    } // namespace
+
+    // --------------------------------------------------------------------------------------------
+    FileWatcher::FileWatcher()
+    {
+#ifdef __LINUX__
+        m_Inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_Inotify < 0) vantor::Backlog::Log("FileWatcher", "inotify is not available, file changes won't be detected.", vantor::Backlog::LogLevel::WARNING);
+#endif
+    }
+    // --------------------------------------------------------------------------------------------
+    FileWatcher::~FileWatcher()
+    {
+        Stop();
+#ifdef __LINUX__
+        if (m_Inotify >= 0) close(m_Inotify);
+#endif
+    }
+    // --------------------------------------------------------------------------------------------
+    void FileWatcher::Watch(const std::string &path)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Files.insert(path).second) return;
+
+#ifdef __LINUX__
+        if (m_Inotify < 0) return;
+
+        // watching the directory instead of the file survives editors that
+        // save by writing a temporary file and renaming it over the original.
+        std::string directory = directoryOf(path);
+        int         wd        = inotify_add_watch(m_Inotify, directory.empty() ? "." : directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd < 0)
+        {
+            vantor::Backlog::Log("FileWatcher", "Failed to watch: " + path + ".", vantor::Backlog::LogLevel::WARNING);
+            return;
+        }
+        // the same directory always yields the same descriptor
+        m_Directories[wd] = directory;
+#else
+        std::error_code error;
+        m_WriteTimes[path] = std::filesystem::last_write_time(path, error);
+#endif
+    }
+    // --------------------------------------------------------------------------------------------
+    void FileWatcher::Start()
+    {
+        if (m_Running) return;
+        m_Running = true;
+        m_Thread  = std::thread(&FileWatcher::run, this);
+    }
+    // --------------------------------------------------------------------------------------------
+    void FileWatcher::Stop()
+    {
+        if (!m_Running) return;
+        m_Running = false;
+        if (m_Thread.joinable()) m_Thread.join();
+    }
+    // --------------------------------------------------------------------------------------------
+    void FileWatcher::PollChanges(std::vector<std::string> &changes)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        changes.insert(changes.end(), m_Changes.begin(), m_Changes.end());
+        m_Changes.clear();
+    }
+    // --------------------------------------------------------------------------------------------
+    void FileWatcher::queueChange(const std::string &path)
+    {
+        // expects m_Mutex to be held
+        if (std::find(m_Changes.begin(), m_Changes.end(), path) == m_Changes.end()) m_Changes.push_back(path);
+    }
+    // --------------------------------------------------------------------------------------------
+    void FileWatcher::run()
+    {
+#ifdef __LINUX__
+        if (m_Inotify < 0) return;
+
+        alignas(inotify_event) char buffer[4096];
+        pollfd                      descriptor = {m_Inotify, POLLIN, 0};
+        while (m_Running)
+        {
+            // wake up regularly to notice Stop()
+            if (poll(&descriptor, 1, 100) <= 0) continue;
+
+            ssize_t length;
+            while ((length = read(m_Inotify, buffer, sizeof(buffer))) > 0)
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                for (char *ptr = buffer; ptr < buffer + length;)
+                {
+                    const inotify_event *event = reinterpret_cast<const inotify_event *>(ptr);
+                    ptr += sizeof(inotify_event) + event->len;
+
+                    auto directory = m_Directories.find(event->wd);
+                    if (directory == m_Directories.end() || event->len == 0) continue;
+
+                    std::string path = directory->second.empty() ? std::string(event->name) : directory->second + "/" + event->name;
+                    if (m_Files.count(path)) queueChange(path);
+                }
+            }
+        }
+#else
+        while (m_Running)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            for (auto &file : m_WriteTimes)
+            {
+                std::error_code                 error;
+                std::filesystem::file_time_type time = std::filesystem::last_write_time(file.first, error);
+                if (error || time == file.second) continue;
+
+                file.second = time;
+                queueChange(file.first);
+            }
+        }
+#endif
+    }
+} // namespace vantor
@@ -0,0 +1,82 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorFileWatcher.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifndef __LINUX__
+#include <filesystem>
+#endif
+
+namespace vantor
+{
+    // Watches a set of files from a background thread and queues the ones
+    // that were written to. Uses inotify on Linux (one watch per directory)
+    // and falls back to polling modification times everywhere else.
+    //
+    // Nothing is acted upon on the watcher thread; the owner drains the
+    // queue through PollChanges() at a point that suits it (e.g. between
+    // frames), so no engine state is ever touched concurrently.
+    class FileWatcher
+    {
+        private:
+            std::thread       m_Thread;
+            std::atomic<bool> m_Running{false};
+
+            std::mutex                      m_Mutex; // guards everything below
+            std::unordered_set<std::string> m_Files;
+            std::vector<std::string>        m_Changes;
+#ifdef __LINUX__
+            int                                  m_Inotify = -1;
+            std::unordered_map<int, std::string> m_Directories; // watch descriptor -> directory
+#else
+            std::unordered_map<std::string, std::filesystem::file_time_type> m_WriteTimes;
+#endif
+
+        public:
+            FileWatcher();
+            ~FileWatcher();
+
+            FileWatcher(const FileWatcher &)            = delete;
+            FileWatcher &operator=(const FileWatcher &) = delete;
+
+            // paths are reported back exactly as they were passed in
+            void Watch(const std::string &path);
+
+            void Start();
+            void Stop();
+            bool IsRunning() const { return m_Running; }
+
+            // moves the files changed since the last call into changes; every
+            // file is listed once, no matter how often it was written.
+            void PollChanges(std::vector<std::string> &changes);
+
+        private:
+            void run();
+            void queueChange(const std::string &path);
+    };
+} // namespace vantor
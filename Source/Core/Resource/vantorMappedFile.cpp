@@ -0,0 +1,105 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMappedFile.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorMappedFile.hpp"
+#include "../../Helpers/vantorFS.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+
+#ifdef __LINUX__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vantor
+{
+    // --------------------------------------------------------------------------------------------
+    MappedFile::MappedFile() {}
+    // --------------------------------------------------------------------------------------------
+    MappedFile::~MappedFile() { Close(); }
+    // --------------------------------------------------------------------------------------------
+    bool MappedFile::Open(const std::string &path)
+    {
+        Close();
+
+#ifdef __LINUX__
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) return false;
+
+        struct stat info;
+        if (fstat(file, &info) == 0 && info.st_size > 0)
+        {
+            void *data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (data != MAP_FAILED)
+            {
+                // everything is about to be read anyway; start reading ahead
+                madvise(data, info.st_size, MADV_WILLNEED);
+                m_Data   = (const uint8_t *) data;
+                m_Size   = info.st_size;
+                m_Mapped = true;
+            }
+        }
+        // the mapping stays valid without the descriptor
+        close(file);
+        return m_Mapped;
+#else
+        m_Buffer = vantor::Helpers::FileSystem::ReadBinary(path);
+        if (m_Buffer.empty()) return false;
+        m_Data = m_Buffer.data();
+        m_Size = m_Buffer.size();
+        return true;
+#endif
+    }
+    // --------------------------------------------------------------------------------------------
+    void MappedFile::Close()
+    {
+#ifdef __LINUX__
+        if (m_Mapped) munmap((void *) m_Data, m_Size);
+#endif
+        m_Buffer = std::vector<uint8_t>();
+        m_Data   = nullptr;
+        m_Size   = 0;
+        m_Mapped = false;
+    }
+    // --------------------------------------------------------------------------------------------
+    bool WriteFileAtomic(const std::string &path, const std::vector<uint8_t> &data)
+    {
+        static const uint64_t        process = std::random_device()();
+        static std::atomic<uint64_t> writes{0};
+        char                         suffix[48];
+        snprintf(suffix, sizeof(suffix), ".%016llx.%llu.tmp", (unsigned long long) process, (unsigned long long) writes.fetch_add(1));
+
+        std::string tmpPath = path + suffix;
+        FILE       *file    = fopen(tmpPath.c_str(), "wb");
+        if (!file) return false;
+        bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+        written      = fclose(file) == 0 && written;
+
+        // rename doesn't replace existing files everywhere
+        std::remove(path.c_str());
+        if (written && std::rename(tmpPath.c_str(), path.c_str()) == 0) return true;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+} // namespace vantor
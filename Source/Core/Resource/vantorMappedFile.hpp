@@ -0,0 +1,63 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMappedFile.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vantor
+{
+    // A read only view of a whole file. Memory mapped where the platform
+    // allows it, so pages are only read in as they are touched and data can
+    // be handed to GL straight from the page cache; read into memory
+    // everywhere else.
+    class MappedFile
+    {
+        private:
+            const uint8_t       *m_Data   = nullptr;
+            size_t               m_Size   = 0;
+            bool                 m_Mapped = false;
+            std::vector<uint8_t> m_Buffer; // if not mapped
+
+        public:
+            MappedFile();
+            ~MappedFile();
+
+            MappedFile(const MappedFile &)            = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+
+            bool Open(const std::string &path);
+            void Close();
+
+            bool           IsOpen() const { return m_Data != nullptr; }
+            const uint8_t *GetData() const { return m_Data; }
+            size_t         GetSize() const { return m_Size; }
+    };
+
+    // Writes data to a temporary file next to path and renames it into
+    // place, so readers never see a partial file. The temporary name is
+    // unique per process and call, so concurrent writers of the same path
+    // don't clobber each other; the last one wins. False if nothing was
+    // written.
+    bool WriteFileAtomic(const std::string &path, const std::vector<uint8_t> &data);
+} // namespace vantor
@@ -0,0 +1,199 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMeshCache.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorMeshCache.hpp"
+#include "../BackLog/vantorBacklog.h"
+
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(__SWITCH__)
+#include <filesystem>
+#endif
+
+namespace vantor
+{
+    namespace
+    {
+        using vantor::Graphics::RenderDevice::OpenGL::Meshlet;
+        using vantor::Graphics::RenderDevice::OpenGL::MeshLOD;
+
+        // read in place out of the mapping, so nothing may hide in padding
+        static_assert(sizeof(CookedHeader) == 96 && sizeof(CookedMesh) == 288 && sizeof(CookedMaterial) == 24 && sizeof(CookedNode) == 16);
+        static_assert(sizeof(CookedDependency) == 16);
+        static_assert(sizeof(MeshLOD) == 12 && sizeof(Meshlet) == 40);
+        static_assert(std::is_trivially_copyable_v<MeshLOD> && std::is_trivially_copyable_v<Meshlet>);
+
+        bool inFile(uint64_t offset, uint64_t bytes, size_t size) { return offset % 16 == 0 && offset <= size && bytes <= size - offset; }
+
+        bool validIndices(const uint8_t *indices, uint32_t type, uint32_t count, uint32_t vertexCount)
+        {
+            if (type == GL_UNSIGNED_SHORT)
+            {
+                const uint16_t *values = (const uint16_t *) indices;
+                for (uint32_t i = 0; i < count; ++i)
+                    if (values[i] >= vertexCount) return false;
+            }
+            else
+            {
+                const uint32_t *values = (const uint32_t *) indices;
+                for (uint32_t i = 0; i < count; ++i)
+                    if (values[i] >= vertexCount) return false;
+            }
+            return true;
+        }
+
+        bool validate(const uint8_t *data, size_t size, uint64_t hash)
+        {
+            if (size < sizeof(CookedHeader)) return false;
+
+            const CookedHeader *header = (const CookedHeader *) data;
+            if (header->Magic != MeshCache::MAGIC || header->Version != MeshCache::VERSION || header->SourceHash != hash) return false;
+            if (!inFile(header->MeshOffset, (uint64_t) header->MeshCount * sizeof(CookedMesh), size) ||
+                !inFile(header->MaterialOffset, (uint64_t) header->MaterialCount * sizeof(CookedMaterial), size) ||
+                !inFile(header->NodeOffset, (uint64_t) header->NodeCount * sizeof(CookedNode), size) ||
+                !inFile(header->NodeMeshOffset, (uint64_t) header->NodeMeshCount * sizeof(uint32_t), size) ||
+                !inFile(header->DependencyOffset, (uint64_t) header->DependencyCount * sizeof(CookedDependency), size) ||
+                !inFile(header->StringOffset, header->StringBytes, size))
+                return false;
+            if (header->NodeCount == 0 || (header->StringBytes > 0 && data[header->StringOffset + header->StringBytes - 1] != 0)) return false;
+
+            const CookedMesh *meshes = (const CookedMesh *) (data + header->MeshOffset);
+            for (uint32_t i = 0; i < header->MeshCount; ++i)
+            {
+                const CookedMesh &mesh      = meshes[i];
+                const uint64_t    indexSize = mesh.IndexType == GL_UNSIGNED_SHORT ? 2 : 4;
+                if (mesh.Attributes > 5 || mesh.Material >= header->MaterialCount) return false;
+                if (mesh.IndexType != GL_UNSIGNED_SHORT && mesh.IndexType != GL_UNSIGNED_INT) return false;
+                if (!inFile(mesh.VertexOffset, mesh.VertexBytes, size) || !inFile(mesh.IndexOffset, mesh.IndexCount * indexSize, size) ||
+                    !inFile(mesh.LODOffset, (uint64_t) mesh.LODCount * sizeof(MeshLOD), size) ||
+                    !inFile(mesh.MeshletOffset, (uint64_t) mesh.MeshletCount * sizeof(Meshlet), size))
+                    return false;
+
+                // everything a draw call reads has to lie within the buffers
+                for (uint32_t a = 0; a < mesh.Attributes; ++a)
+                {
+                    const vantor::Graphics::RenderDevice::OpenGL::VertexLayout &layout = mesh.Layout[a];
+                    const uint64_t                                              stride = layout.Stride ? layout.Stride : layout.Size;
+                    if (layout.Location >= 5 || layout.Components < 1 || layout.Components > 4 || layout.Size == 0 || stride > mesh.VertexBytes) return false;
+                    if (mesh.VertexCount > 0 && layout.Offset + (mesh.VertexCount - 1) * stride + layout.Size > mesh.VertexBytes) return false;
+                }
+                if (!validIndices(data + mesh.IndexOffset, mesh.IndexType, mesh.IndexCount, mesh.VertexCount)) return false;
+
+                const MeshLOD *lods = (const MeshLOD *) (data + mesh.LODOffset);
+                for (uint32_t l = 0; l < mesh.LODCount; ++l)
+                    if ((uint64_t) lods[l].IndexOffset + lods[l].IndexCount > mesh.IndexCount) return false;
+                const Meshlet *meshlets = (const Meshlet *) (data + mesh.MeshletOffset);
+                for (uint32_t m = 0; m < mesh.MeshletCount; ++m)
+                    if ((uint64_t) meshlets[m].IndexOffset + meshlets[m].IndexCount > mesh.IndexCount) return false;
+            }
+
+            const CookedMaterial *materials = (const CookedMaterial *) (data + header->MaterialOffset);
+            for (uint32_t i = 0; i < header->MaterialCount; ++i)
+                for (uint32_t texture : materials[i].Textures)
+                    if (texture != MeshCache::NO_TEXTURE && texture >= header->StringBytes) return false;
+
+            const CookedDependency *dependencies = (const CookedDependency *) (data + header->DependencyOffset);
+            for (uint32_t i = 0; i < header->DependencyCount; ++i)
+                if (dependencies[i].Path >= header->StringBytes) return false;
+
+            // children strictly after their parent rules out cycles
+            const CookedNode *nodes = (const CookedNode *) (data + header->NodeOffset);
+            for (uint32_t i = 0; i < header->NodeCount; ++i)
+            {
+                const CookedNode &node = nodes[i];
+                if ((uint64_t) node.FirstMesh + node.MeshCount > header->NodeMeshCount) return false;
+                if (node.ChildCount > 0 && (node.FirstChild <= i || (uint64_t) node.FirstChild + node.ChildCount > header->NodeCount)) return false;
+            }
+
+            const uint32_t *nodeMeshes = (const uint32_t *) (data + header->NodeMeshOffset);
+            for (uint32_t i = 0; i < header->NodeMeshCount; ++i)
+                if (nodeMeshes[i] >= header->MeshCount) return false;
+
+            return true;
+        }
+    } // namespace
+
+    std::string MeshCache::m_Directory = "cache/meshes";
+    bool        MeshCache::m_Enabled   = true;
+    // --------------------------------------------------------------------------------------------
+    void MeshCache::SetDirectory(const std::string &directory) { m_Directory = directory; }
+    // --------------------------------------------------------------------------------------------
+    void MeshCache::SetEnabled(bool enabled) { m_Enabled = enabled; }
+    // --------------------------------------------------------------------------------------------
+    bool MeshCache::IsEnabled() { return m_Enabled; }
+    // --------------------------------------------------------------------------------------------
+    uint64_t MeshCache::HashSource(const uint8_t *data, size_t size)
+    {
+        // 64 bit FNV-1a over whole words; model files run into the tens of
+        // megabytes and are hashed on every load
+        uint64_t hash  = 14695981039346656037ull ^ size;
+        size_t   words = size / sizeof(uint64_t);
+        for (size_t i = 0; i < words; ++i)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i * sizeof(uint64_t), sizeof(uint64_t));
+            hash ^= word;
+            hash *= 1099511628211ull;
+        }
+        for (size_t i = words * sizeof(uint64_t); i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+    // --------------------------------------------------------------------------------------------
+    const CookedHeader *MeshCache::Open(MappedFile &file, uint64_t hash)
+    {
+        std::string path = getEntryPath(hash);
+        if (!m_Enabled || !file.Open(path)) return nullptr;
+
+        if (!validate(file.GetData(), file.GetSize(), hash))
+        {
+            vantor::Backlog::Log("MeshCache", "Discarding stale mesh cache entry: " + path, vantor::Backlog::LogLevel::DEBUG);
+            file.Close();
+            std::remove(path.c_str());
+            return nullptr;
+        }
+        return (const CookedHeader *) file.GetData();
+    }
+    // --------------------------------------------------------------------------------------------
+    void MeshCache::Store(uint64_t hash, const std::vector<uint8_t> &data)
+    {
+        if (!m_Enabled) return;
+#if !defined(__SWITCH__)
+        std::error_code error;
+        std::filesystem::create_directories(m_Directory, error);
+#endif
+
+        std::string path = getEntryPath(hash);
+        if (!WriteFileAtomic(path, data))
+            vantor::Backlog::Log("MeshCache", "Failed to write cooked mesh: " + path, vantor::Backlog::LogLevel::WARNING);
+    }
+    // --------------------------------------------------------------------------------------------
+    std::string MeshCache::getEntryPath(uint64_t hash)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.vmesh", (unsigned long long) hash);
+        return m_Directory + "/" + name;
+    }
+} // namespace vantor
@@ -0,0 +1,153 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMeshCache.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include "../../Graphics/RenderDevice/DeviceOpenGL/vantorOpenGLMesh.hpp"
+#include "vantorMappedFile.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vantor
+{
+    /*
+
+      Cooked models: everything MeshLoader gets out of a model file after
+      import and mesh processing, with vertex and index buffers encoded the
+      way they are uploaded. Loading one is a file mapping and a
+      glBufferData per buffer, straight from the mapping.
+
+      Offsets are in bytes from the start of the file, 16 byte aligned, and
+      the sections follow each other in this order:
+
+        CookedHeader
+        CookedMesh[MeshCount]
+        CookedMaterial[MaterialCount]
+        CookedNode[NodeCount]       the root first, siblings next to each other
+        uint32_t[NodeMeshCount]     mesh indices of every node
+        CookedDependency[DependencyCount]
+        char[StringBytes]           zero terminated texture and dependency paths
+        per mesh: vertices, indices, MeshLOD[LODCount], Meshlet[MeshletCount]
+
+    */
+    struct CookedHeader
+    {
+            uint32_t Magic;
+            uint32_t Version;
+            uint64_t SourceHash;
+            uint32_t MeshCount;
+            uint32_t MaterialCount;
+            uint32_t NodeCount;
+            uint32_t NodeMeshCount;
+            uint32_t DependencyCount;
+            uint32_t Padding;
+            uint64_t MeshOffset;
+            uint64_t MaterialOffset;
+            uint64_t NodeOffset;
+            uint64_t NodeMeshOffset;
+            uint64_t DependencyOffset;
+            uint64_t StringOffset;
+            uint64_t StringBytes;
+    };
+
+    struct CookedMesh
+    {
+            uint32_t VertexCount;
+            uint32_t IndexCount;
+            uint32_t IndexType; // GLenum
+            uint32_t Topology;
+            uint32_t Format; // VERTEX_FORMAT bits
+            uint32_t Attributes;
+            uint32_t LODCount;
+            uint32_t MeshletCount;
+            uint32_t Material;
+            uint32_t Padding;
+            float    BoxMin[3];
+            float    BoxMax[3];
+            float    PositionOffset[3];
+            float    PositionScale[3];
+
+            vantor::Graphics::RenderDevice::OpenGL::VertexLayout Layout[5];
+
+            uint64_t VertexOffset;
+            uint64_t VertexBytes;
+            uint64_t IndexOffset;
+            uint64_t LODOffset;
+            uint64_t MeshletOffset;
+    };
+
+    struct CookedMaterial
+    {
+            uint32_t Alpha;
+            uint32_t Textures[5]; // into the strings, MeshCache::NO_TEXTURE if unused
+    };
+
+    struct CookedNode
+    {
+            uint32_t FirstMesh; // into the node meshes
+            uint32_t MeshCount;
+            uint32_t FirstChild; // always past the node itself
+            uint32_t ChildCount;
+    };
+
+    // another file the model was imported from (the .mtl of an .obj, ...)
+    // and the hash of its contents at the time
+    struct CookedDependency
+    {
+            uint64_t Hash;
+            uint32_t Path; // into the strings
+            uint32_t Padding;
+    };
+
+    // On-disk cache of cooked models, keyed by a hash of the model file's
+    // contents and the import settings; like the ShaderCache, a changed
+    // source simply never finds its old entry again. Files the model pulls
+    // in are recorded as dependencies, the loader checks them on a hit.
+    class MeshCache
+    {
+        private:
+            static std::string m_Directory;
+            static bool        m_Enabled;
+
+        public:
+            static constexpr uint32_t MAGIC      = 0x48534D56; // "VMSH"
+            static constexpr uint32_t VERSION    = 2;
+            static constexpr uint32_t NO_TEXTURE = 0xFFFFFFFF;
+
+            static void SetDirectory(const std::string &directory);
+            static void SetEnabled(bool enabled);
+            static bool IsEnabled();
+
+            static uint64_t HashSource(const uint8_t *data, size_t size);
+
+            // maps the entry of hash; returns its header if there is one and
+            // every offset, count, index and range in it checks out, null
+            // otherwise.
+            static const CookedHeader *Open(MappedFile &file, uint64_t hash);
+            // through WriteFileAtomic: readers never see half an entry and
+            // concurrent stores of one model don't collide
+            static void Store(uint64_t hash, const std::vector<uint8_t> &data);
+
+        private:
+            static std::string getEntryPath(uint64_t hash);
+    };
+} // namespace vantor
@@ -29,19 +29,36 @@
 
 #include "../../Helpers/vantorString.hpp"
 #include "../BackLog/vantorBacklog.h"
+#include "../JobSystem/vantorJobSystem.h"
 
+#include "../../Graphics/Geometry/Primitives/vantorPrimitiveCache.hpp"
+#include "../../Graphics/RenderDevice/DeviceOpenGL/Shader/vantorOpenGLShaderCache.hpp"
+#include "../../Graphics/RenderDevice/DeviceOpenGL/vantorOpenGLTextureUploader.hpp"
+
+#include <algorithm>
 #include <stack>
+#include <unordered_set>
 #include <vector>
 
 namespace vantor
 {
-    std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::Shader> Resources::m_Shaders
-        = std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::Shader>();
+    std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::Shader *> Resources::m_Shaders
+        = std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::Shader *>();
+    std::map<uint64_t, vantor::Graphics::RenderDevice::OpenGL::Shader> Resources::m_ShaderPrograms
+        = std::map<uint64_t, vantor::Graphics::RenderDevice::OpenGL::Shader>();
+    std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::ShaderPermutations> Resources::m_ShaderPermutations
+        = std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::ShaderPermutations>();
     std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::Texture> Resources::m_Textures
         = std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::Texture>();
     std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::TextureCube> Resources::m_TexturesCube
         = std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::TextureCube>();
     std::map<unsigned int, SceneNode *> Resources::m_Meshes = std::map<unsigned int, SceneNode *>();
+    std::unordered_map<vantor::Graphics::RenderDevice::OpenGL::Shader *, Resources::ShaderSource> Resources::m_ShaderSources
+        = std::unordered_map<vantor::Graphics::RenderDevice::OpenGL::Shader *, Resources::ShaderSource>();
+    std::vector<vantor::Graphics::RenderDevice::OpenGL::Shader *> Resources::m_ReloadingShaders
+        = std::vector<vantor::Graphics::RenderDevice::OpenGL::Shader *>();
+    FileWatcher *Resources::m_ShaderWatcher = nullptr;
+    std::vector<Resources::MeshRequest> Resources::m_MeshRequests = std::vector<Resources::MeshRequest>();
     // --------------------------------------------------------------------------------------------
     void Resources::Init() { vantor::Graphics::RenderDevice::OpenGL::Texture placeholderTexture; }
     void Resources::Clean()
@@ -50,6 +67,11 @@ namespace vantor
         {
             delete it->second;
         }
+        vantor::Graphics::Geometry::Primitives::PrimitiveCache::Clean();
+        // workers may still be copying into the uploader's buffers
+        vantor::Core::JobSystem::Wait();
+        vantor::Graphics::RenderDevice::OpenGL::TextureUploader::Release();
+        EnableShaderHotReload(false);
     }
 
     // --------------------------------------------------------------------------------------------
@@ -58,19 +80,54 @@ namespace vantor
     {
         unsigned int id = SID(name);
 
-        if (Resources::m_Shaders.find(id) != Resources::m_Shaders.end()) return &Resources::m_Shaders[id];
+        auto found = Resources::m_Shaders.find(id);
+        if (found != Resources::m_Shaders.end()) return found->second;
+
+        std::string vsSource, fsSource;
+        if (!ShaderLoader::ReadSources(name, vsPath, fsPath, vsSource, fsSource))
+        {
+            // keep handing out an (empty) shader so callers don't have to
+            // null-check; key 0 is reserved for it.
+            Resources::m_Shaders[id] = &Resources::m_ShaderPrograms[0];
+            return Resources::m_Shaders[id];
+        }
+
+        // define order doesn't change the program, so don't let it produce
+        // separate cache entries
+        std::sort(defines.begin(), defines.end());
+        defines.erase(std::unique(defines.begin(), defines.end()), defines.end());
+
+        uint64_t key     = vantor::Graphics::RenderDevice::OpenGL::ShaderCache::ComputeKey(vsSource, fsSource, defines);
+        auto     program = Resources::m_ShaderPrograms.find(key);
+        if (program == Resources::m_ShaderPrograms.end())
+        {
+            program = Resources::m_ShaderPrograms.emplace(key, vantor::Graphics::RenderDevice::OpenGL::Shader(name, vsSource, fsSource, defines)).first;
+
+            ShaderSource &source = Resources::m_ShaderSources[&program->second];
+            source.Name          = name;
+            source.VsPath        = ShaderLoader::NormalizePath(vsPath);
+            source.FsPath        = ShaderLoader::NormalizePath(fsPath);
+            source.Defines       = defines;
+            source.Key           = key;
+            if (Resources::m_ShaderWatcher) watchShader(source);
+        }
+        else
+        {
+            vantor::Backlog::Log("ResourceLoader", "Shader: " + name + " shares its program with: " + program->second.Name + ".",
+                                 vantor::Backlog::LogLevel::DEBUG);
+        }
 
-        vantor::Graphics::RenderDevice::OpenGL::Shader shader = ShaderLoader::Load(name, vsPath, fsPath, defines);
-        Resources::m_Shaders[id]                              = shader;
-        return &Resources::m_Shaders[id];
+        Resources::m_Shaders[id] = &program->second;
+        return Resources::m_Shaders[id];
     }
     vantor::Graphics::RenderDevice::OpenGL::Shader *Resources::GetShader(std::string name)
     {
         unsigned int id = SID(name);
 
-        if (Resources::m_Shaders.find(id) != Resources::m_Shaders.end())
+        auto found = Resources::m_Shaders.find(id);
+        if (found != Resources::m_Shaders.end())
         {
-            return &Resources::m_Shaders[id];
+            return found->second;
         }
         else
         {
@@ -79,6 +136,133 @@ namespace vantor
         }
     }
     // --------------------------------------------------------------------------------------------
+    void Resources::EnableShaderHotReload(bool enable)
+    {
+        if (enable == (Resources::m_ShaderWatcher != nullptr)) return;
+
+        if (!enable)
+        {
+            delete Resources::m_ShaderWatcher;
+            Resources::m_ShaderWatcher = nullptr;
+            return;
+        }
+
+        Resources::m_ShaderWatcher = new FileWatcher();
+        for (const auto &entry : Resources::m_ShaderSources)
+            watchShader(entry.second);
+        Resources::m_ShaderWatcher->Start();
+    }
+    // --------------------------------------------------------------------------------------------
+    void Resources::watchShader(const ShaderSource &source)
+    {
+        Resources::m_ShaderWatcher->Watch(source.VsPath);
+        Resources::m_ShaderWatcher->Watch(source.FsPath);
+        for (const std::string &include : ShaderLoader::GetIncludes(source.VsPath))
+            Resources::m_ShaderWatcher->Watch(include);
+        for (const std::string &include : ShaderLoader::GetIncludes(source.FsPath))
+            Resources::m_ShaderWatcher->Watch(include);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Resources::UpdateShaders()
+    {
+        if (!Resources::m_ShaderWatcher) return;
+
+        std::vector<std::string> changes;
+        Resources::m_ShaderWatcher->PollChanges(changes);
+        if (!changes.empty())
+        {
+            // a changed include makes every file including it stale too
+            std::unordered_set<std::string> stale;
+            for (const std::string &path : changes)
+            {
+                stale.insert(path);
+                for (const std::string &dependent : ShaderLoader::Invalidate(path))
+                    stale.insert(dependent);
+            }
+
+            for (auto &entry : Resources::m_ShaderSources)
+            {
+                vantor::Graphics::RenderDevice::OpenGL::Shader *shader = entry.first;
+                ShaderSource                                   &source = entry.second;
+                if (!stale.count(source.VsPath) && !stale.count(source.FsPath)) continue;
+
+                std::string vsSource, fsSource;
+                if (!ShaderLoader::ReadSources(source.Name, source.VsPath, source.FsPath, vsSource, fsSource)) continue;
+
+                // saving without changes (or undoing one) needs no recompile
+                uint64_t key = vantor::Graphics::RenderDevice::OpenGL::ShaderCache::ComputeKey(vsSource, fsSource, source.Defines);
+                if (key == (shader->IsReloading() ? source.ReloadKey : source.Key)) continue;
+
+                vantor::Backlog::Log("ResourceLoader", "Reloading shader: " + source.Name + ".", vantor::Backlog::LogLevel::INFO);
+                source.ReloadKey = key;
+                shader->Reload(vsSource, fsSource, source.Defines);
+                auto &reloading = Resources::m_ReloadingShaders;
+                if (std::find(reloading.begin(), reloading.end(), shader) == reloading.end()) reloading.push_back(shader);
+
+                // the edit may have added includes
+                watchShader(source);
+            }
+        }
+
+        // swap finished programs in; the Shader objects stay where they are,
+        // so every pointer handed out keeps working.
+        for (unsigned int i = 0; i < Resources::m_ReloadingShaders.size();)
+        {
+            vantor::Graphics::RenderDevice::OpenGL::Shader *shader   = Resources::m_ReloadingShaders[i];
+            uint32_t                                        revision = shader->Revision;
+            if (!shader->UpdateReload())
+            {
+                ++i;
+                continue;
+            }
+            Resources::m_ReloadingShaders.erase(Resources::m_ReloadingShaders.begin() + i);
+            if (shader->Revision == revision) continue; // failed, the old program stays
+
+            // re-key the program under its new sources, unless an identical
+            // program exists already; then it stays under the old key.
+            ShaderSource &source = Resources::m_ShaderSources[shader];
+            auto          node   = Resources::m_ShaderPrograms.extract(source.Key);
+            node.key()           = source.ReloadKey;
+            auto result          = Resources::m_ShaderPrograms.insert(std::move(node));
+            if (result.inserted)
+            {
+                source.Key = source.ReloadKey;
+            }
+            else
+            {
+                result.node.key() = source.Key;
+                Resources::m_ShaderPrograms.insert(std::move(result.node));
+            }
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    vantor::Graphics::RenderDevice::OpenGL::ShaderPermutations *
+    Resources::LoadShaderPermutations(std::string name, std::string vsPath, std::string fsPath, std::vector<std::string> keywords)
+    {
+        unsigned int id = SID(name);
+
+        auto found = Resources::m_ShaderPermutations.find(id);
+        if (found != Resources::m_ShaderPermutations.end()) return &found->second;
+
+        Resources::m_ShaderPermutations[id] = vantor::Graphics::RenderDevice::OpenGL::ShaderPermutations(name, vsPath, fsPath, keywords);
+        return &Resources::m_ShaderPermutations[id];
+    }
+    vantor::Graphics::RenderDevice::OpenGL::ShaderPermutations *Resources::GetShaderPermutations(std::string name)
+    {
+        unsigned int id = SID(name);
+
+        auto found = Resources::m_ShaderPermutations.find(id);
+        if (found != Resources::m_ShaderPermutations.end())
+        {
+            return &found->second;
+        }
+        else
+        {
+            vantor::Backlog::Log("ResourceLoader", "Requested shader permutations: " + name + " not found!", vantor::Backlog::LogLevel::WARNING);
+            return nullptr;
+        }
+    }
+    // --------------------------------------------------------------------------------------------
     vantor::Graphics::RenderDevice::OpenGL::Texture *Resources::LoadTexture(std::string name, std::string path, GLenum target, GLenum format, bool srgb)
     {
         unsigned int id = SID(name);
@@ -102,6 +286,30 @@ namespace vantor
         }
     }
     // --------------------------------------------------------------------------------------------
+    vantor::Graphics::RenderDevice::OpenGL::Texture *
+    Resources::LoadTexture(std::string name, const TextureData &data, GLenum target, GLenum format, bool srgb)
+    {
+        unsigned int id = SID(name);
+
+        if (Resources::m_Textures.find(id) != Resources::m_Textures.end())
+        {
+            if (data.Staged >= 0) vantor::Graphics::RenderDevice::OpenGL::TextureUploader::Cancel(data.Staged);
+            return &Resources::m_Textures[id];
+        }
+
+        vantor::Graphics::RenderDevice::OpenGL::Texture texture = TextureLoader::UploadTexture(data, target, format, srgb);
+
+        if (texture.Width > 0)
+        {
+            Resources::m_Textures[id] = texture;
+            return &Resources::m_Textures[id];
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+    // --------------------------------------------------------------------------------------------
     vantor::Graphics::RenderDevice::OpenGL::Texture *Resources::LoadHDR(std::string name, std::string path)
     {
         unsigned int id = SID(name);
@@ -191,4 +399,66 @@ namespace vantor
             return nullptr;
         }
     }
+    // --------------------------------------------------------------------------------------------
+    std::shared_ptr<MeshLoad> Resources::LoadMeshAsync(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, std::string name, std::string path)
+    {
+        unsigned int              id     = SID(name);
+        std::shared_ptr<MeshLoad> handle = std::make_shared<MeshLoad>();
+
+        if (Resources::m_Meshes.find(id) != Resources::m_Meshes.end())
+        {
+            handle->m_Node = Scene::MakeSceneNode(Resources::m_Meshes[id]);
+            handle->m_State.store(MESH_LOAD_DONE, std::memory_order_release);
+            return handle;
+        }
+
+        // the same model requested again while it is still loading
+        for (MeshRequest &request : Resources::m_MeshRequests)
+        {
+            if (request.ID == id)
+            {
+                request.Handles.push_back(handle);
+                return handle;
+            }
+        }
+
+        Resources::m_MeshRequests.push_back({id, MeshLoader::LoadMeshAsync(renderer, path), {handle}});
+        return handle;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Resources::UpdateMeshes(float budgetMs)
+    {
+        if (Resources::m_MeshRequests.empty()) return;
+
+        MeshLoader::UpdateLoads(budgetMs);
+
+        for (unsigned int i = 0; i < Resources::m_MeshRequests.size();)
+        {
+            MeshRequest &request = Resources::m_MeshRequests[i];
+            if (!request.Load->IsDone())
+            {
+                ++i;
+                continue;
+            }
+
+            SceneNode *node = request.Load->GetNode();
+            if (node)
+            {
+                // loaded synchronously in the meantime; keep what others already use
+                if (Resources::m_Meshes.find(request.ID) != Resources::m_Meshes.end())
+                {
+                    delete node;
+                    node = Resources::m_Meshes[request.ID];
+                }
+                Resources::m_Meshes[request.ID] = node;
+            }
+            for (std::shared_ptr<MeshLoad> &handle : request.Handles)
+            {
+                if (node) handle->m_Node = Scene::MakeSceneNode(node);
+                handle->m_State.store(node ? MESH_LOAD_DONE : MESH_LOAD_FAILED, std::memory_order_release);
+            }
+
+            Resources::m_MeshRequests.erase(Resources::m_MeshRequests.begin() + i);
+        }
+    }
 } // namespace vantor
\ No newline at end of file
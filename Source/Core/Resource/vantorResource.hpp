@@ -24,29 +24,70 @@
 #pragma once
 
 #include "../../Graphics/RenderDevice/DeviceOpenGL/vantorOpenGLShader.hpp"
+#include "../../Graphics/RenderDevice/DeviceOpenGL/Shader/vantorOpenGLShaderPermutations.hpp"
 #include "../../Graphics/RenderDevice/DeviceOpenGL/vantorOpenGLTexture.hpp"
 #include "../../Graphics/RenderDevice/DeviceOpenGL/vantorOpenGLRenderer.hpp"
 #include "../Scene/vantorSceneNode.hpp"
+#include "vantorFileWatcher.hpp"
 
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace vantor
 {
+    class MeshLoad;
+    struct TextureData;
 
     class Resources
     {
         private:
             // Store every Resource with a hashed string
-            static std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::Shader>      m_Shaders;
-            static std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::Texture>     m_Textures;
-            static std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::TextureCube> m_TexturesCube;
-            static std::map<unsigned int, SceneNode *>                                         m_Meshes;
+            static std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::Shader *>           m_Shaders;
+            static std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::ShaderPermutations> m_ShaderPermutations;
+            static std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::Texture>            m_Textures;
+            static std::map<unsigned int, vantor::Graphics::RenderDevice::OpenGL::TextureCube>        m_TexturesCube;
+            static std::map<unsigned int, SceneNode *>                                                m_Meshes;
+
+            // unique programs keyed by a hash of their sources and defines;
+            // shader names (and permutation variants) with identical code all
+            // point into this so each program is only compiled once.
+            static std::map<uint64_t, vantor::Graphics::RenderDevice::OpenGL::Shader> m_ShaderPrograms;
+
+            // where each unique program came from, for hot reloading; paths
+            // are normalized (see ShaderLoader::NormalizePath).
+            struct ShaderSource
+            {
+                    std::string              Name;
+                    std::string              VsPath;
+                    std::string              FsPath;
+                    std::vector<std::string> Defines;
+                    uint64_t                 Key       = 0; // in m_ShaderPrograms
+                    uint64_t                 ReloadKey = 0; // of the sources being recompiled
+            };
+            static std::unordered_map<vantor::Graphics::RenderDevice::OpenGL::Shader *, ShaderSource> m_ShaderSources;
+            static std::vector<vantor::Graphics::RenderDevice::OpenGL::Shader *>                      m_ReloadingShaders;
+            static FileWatcher                                                                       *m_ShaderWatcher; // null while hot reload is off
+
+            // models loading in the background, one per name; every caller
+            // gets its own handle and with it its own copy of the scene nodes.
+            struct MeshRequest
+            {
+                    unsigned int                           ID;
+                    std::shared_ptr<MeshLoad>              Load; // the template, goes into m_Meshes
+                    std::vector<std::shared_ptr<MeshLoad>> Handles;
+            };
+            static std::vector<MeshRequest> m_MeshRequests;
 
         public:
         private:
             Resources();
 
+            static void watchShader(const ShaderSource &source);
+
         public:
             static void Init();
             static void Clean();
@@ -55,9 +96,21 @@ namespace vantor
             static vantor::Graphics::RenderDevice::OpenGL::Shader *
             LoadShader(std::string name, std::string vsPath, std::string fsPath, std::vector<std::string> defines = std::vector<std::string>());
             static vantor::Graphics::RenderDevice::OpenGL::Shader *GetShader(std::string name);
+            static vantor::Graphics::RenderDevice::OpenGL::ShaderPermutations *
+            LoadShaderPermutations(std::string name, std::string vsPath, std::string fsPath, std::vector<std::string> keywords);
+            static vantor::Graphics::RenderDevice::OpenGL::ShaderPermutations *GetShaderPermutations(std::string name);
+            // watches every shader file and its includes; an edit recompiles
+            // just the programs depending on it, in the background.
+            static void EnableShaderHotReload(bool enable);
+            // once per frame, before anything is drawn: starts recompiling
+            // changed programs and swaps in the ones that finished.
+            static void UpdateShaders();
             // texture resources
             static vantor::Graphics::RenderDevice::OpenGL::Texture *
             LoadTexture(std::string name, std::string path, GLenum target = GL_TEXTURE_2D, GLenum format = GL_RGBA, bool srgb = false);
+            // from pixels decoded up front (see TextureLoader::DecodeTexture)
+            static vantor::Graphics::RenderDevice::OpenGL::Texture *
+            LoadTexture(std::string name, const TextureData &data, GLenum target = GL_TEXTURE_2D, GLenum format = GL_RGBA, bool srgb = false);
             static vantor::Graphics::RenderDevice::OpenGL::Texture     *LoadHDR(std::string name, std::string path);
             static vantor::Graphics::RenderDevice::OpenGL::TextureCube *LoadTextureCube(std::string name, std::string folder);
             static vantor::Graphics::RenderDevice::OpenGL::Texture     *GetTexture(std::string name);
@@ -65,5 +118,11 @@ namespace vantor
             // mesh/scene resources
             static SceneNode *LoadMesh(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, std::string name, std::string path);
             static SceneNode *GetMesh(std::string name);
+            // returns right away, the node is set once the handle is done;
+            // see MeshLoader::LoadMeshAsync.
+            static std::shared_ptr<MeshLoad> LoadMeshAsync(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, std::string name, std::string path);
+            // once per frame on the render thread: uploads (part of) the
+            // finished loads and completes their handles.
+            static void UpdateMeshes(float budgetMs = 2.0f);
     };
 } // namespace vantor
\ No newline at end of file
@@ -25,13 +25,31 @@
 
 #include "vantorResourceLoader.hpp"
 #include "vantorResource.hpp"
+#include "vantorMeshCache.hpp"
+#include "vantorTextureCache.hpp"
 #include "../Scene/vantorSceneNode.hpp"
 #include "../BackLog/vantorBacklog.h"
+#include "../JobSystem/vantorJobSystem.h"
+#include "../../Graphics/Geometry/vantorMeshOptimizer.hpp"
+#include "../../Graphics/Geometry/vantorMeshSimplifier.hpp"
+#include "../../Graphics/Geometry/vantorMeshletBuilder.hpp"
+#include "../../Graphics/RenderDevice/DeviceOpenGL/vantorOpenGLExtensions.hpp"
+#include "../../Graphics/RenderDevice/DeviceOpenGL/vantorOpenGLTextureUploader.hpp"
 
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stack>
+
 namespace vantor
 {
     /*
@@ -39,84 +57,235 @@ namespace vantor
       Mesh loading
 
     */
-    std::vector<vantor::Graphics::RenderDevice::OpenGL::Mesh *> MeshLoader::meshStore = std::vector<vantor::Graphics::RenderDevice::OpenGL::Mesh *>();
-    // --------------------------------------------------------------------------------------------
-    void MeshLoader::Clean()
+    namespace
     {
-        for (unsigned int i = 0; i < MeshLoader::meshStore.size(); ++i)
+        /* TEXTURE TYPES:
+
+            - aiTextureType_DIFFUSE:   Albedo
+            - aiTextureType_NORMALS:   Normal
+            - aiTextureType_SPECULAR:  metallic
+            - aiTextureType_SHININESS: roughness
+            - aiTextureType_AMBIENT:   AO (ambient occlusion)
+            - aiTextureType_EMISSIVE:  Emissive
+
+        */
+        struct MaterialSlot
         {
-            delete MeshLoader::meshStore[i];
-        }
-    }
-    // --------------------------------------------------------------------------------------------
-    vantor::SceneNode *MeshLoader::LoadMesh(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, std::string path, bool setDefaultMaterial)
-    {
-        vantor::Backlog::Log("ResourceLoader", "Loading mesh file at: " + path + ".", vantor::Backlog::LogLevel::INFO);
+                aiTextureType       Type;
+                const char         *Uniform;
+                unsigned int        Unit;
+                bool                Srgb;
+                TEXTURE_COMPRESSION Compression; // shaders only read what the format keeps
+        };
+        const MaterialSlot MATERIAL_SLOTS[] = {
+            {aiTextureType_DIFFUSE, "TexAlbedo", 3, true, TEXTURE_BC1},
+            {aiTextureType_DISPLACEMENT, "TexNormal", 4, false, TEXTURE_BC5},
+            {aiTextureType_SPECULAR, "TexMetallic", 5, false, TEXTURE_BC4},
+            {aiTextureType_SHININESS, "TexRoughness", 6, false, TEXTURE_BC4},
+            {aiTextureType_AMBIENT, "TexAO", 7, false, TEXTURE_BC4},
+        };
+        constexpr unsigned int MATERIAL_SLOT_COUNT = sizeof(MATERIAL_SLOTS) / sizeof(MATERIAL_SLOTS[0]);
 
-        Assimp::Importer importer;
-        const aiScene   *scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_CalcTangentSpace);
+        // what a material is built from; read from assimp on any thread
+        struct MaterialDescription
+        {
+                bool        Alpha = false;                 // "_alpha" albedo, alpha tested
+                std::string Textures[MATERIAL_SLOT_COUNT]; // file per slot, empty if unused
+        };
 
-        if (!scene || scene->mFlags == AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+        GLenum slotFormat(const MaterialDescription &description, unsigned int slot) { return slot == 0 && !description.Alpha ? GL_RGB : GL_RGBA; }
+
+        // color goes to BC7 if the driver lacks S3TC, which is an extension even in 4.x
+        TEXTURE_COMPRESSION slotCompression(const MaterialDescription &description, unsigned int slot)
         {
-            vantor::Backlog::Log("ResourceLoader", "Assimp failed to load model at path: " + path, vantor::Backlog::LogLevel::ERR);
-            return nullptr;
+            TEXTURE_COMPRESSION compression = slot == 0 && description.Alpha ? TEXTURE_BC3 : MATERIAL_SLOTS[slot].Compression;
+            if ((compression == TEXTURE_BC1 || compression == TEXTURE_BC3) && !vantor::Graphics::RenderDevice::OpenGL::Extensions::TextureCompressionS3TC)
+                compression = TEXTURE_BC7;
+            return compression;
         }
 
-        std::string directory = path.substr(0, path.find_last_of("/"));
+        std::string resolvePath(const aiString &file, const std::string &directory)
+        {
+            std::string path = std::string(file.C_Str());
+            if (path.find(":/") == std::string::npos || path.find(":\\") == std::string::npos) path = directory + "/" + path;
+            return path;
+        }
 
-        vantor::Backlog::Log("ResourceLoader", "Succesfully loaded: " + path + ".", vantor::Backlog::LogLevel::INFO);
+        MaterialDescription describeMaterial(const aiMaterial *aMaterial, const std::string &directory)
+        {
+            MaterialDescription description;
 
-        return MeshLoader::processNode(renderer, scene->mRootNode, scene, directory, setDefaultMaterial);
-    }
-    // --------------------------------------------------------------------------------------------
-    SceneNode *MeshLoader::processNode(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer,
-                                       aiNode                                           *aNode,
-                                       const aiScene                                    *aScene,
-                                       std::string                                       directory,
-                                       bool                                              setDefaultMaterial)
-    {
-        SceneNode *node = new SceneNode(0);
+            aiString file;
+            aMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &file);
+            description.Alpha = std::string(file.C_Str()).find("_alpha") != std::string::npos;
 
-        for (unsigned int i = 0; i < aNode->mNumMeshes; ++i)
-        {
-            glm::vec3                                         boxMin, boxMax;
-            aiMesh                                           *assimpMesh = aScene->mMeshes[aNode->mMeshes[i]];
-            aiMaterial                                       *assimpMat  = aScene->mMaterials[assimpMesh->mMaterialIndex];
-            vantor::Graphics::RenderDevice::OpenGL::Mesh     *mesh       = MeshLoader::parseMesh(assimpMesh, aScene, boxMin, boxMax);
-            vantor::Graphics::RenderDevice::OpenGL::Material *material   = nullptr;
-            if (setDefaultMaterial)
+            for (unsigned int slot = 0; slot < MATERIAL_SLOT_COUNT; ++slot)
             {
-                material = MeshLoader::parseMaterial(renderer, assimpMat, aScene, directory);
+                if (aMaterial->GetTextureCount(MATERIAL_SLOTS[slot].Type) == 0) continue;
+                aMaterial->GetTexture(MATERIAL_SLOTS[slot].Type, 0, &file);
+                description.Textures[slot] = resolvePath(file, directory);
             }
+            return description;
+        }
+
+        // render thread only; textures come from (or go into) the Resources cache
+        vantor::Graphics::RenderDevice::OpenGL::Material *createMaterial(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer,
+                                                                         const MaterialDescription                        &description)
+        {
+            vantor::Graphics::RenderDevice::OpenGL::Material *material
+                = description.Alpha ? renderer->CreateMaterial("alpha discard") : renderer->CreateMaterial();
 
-            if (aNode->mNumMeshes == 1)
+            for (unsigned int slot = 0; slot < MATERIAL_SLOT_COUNT; ++slot)
             {
-                node->Mesh = mesh;
-                if (setDefaultMaterial)
+                const std::string &path = description.Textures[slot];
+                if (path.empty()) continue;
+
+                vantor::Graphics::RenderDevice::OpenGL::Texture *texture
+                    = Resources::LoadTexture(path, path, GL_TEXTURE_2D, slotFormat(description, slot), MATERIAL_SLOTS[slot].Srgb);
+                if (texture) material->SetTexture(MATERIAL_SLOTS[slot].Uniform, texture, MATERIAL_SLOTS[slot].Unit);
+            }
+            return material;
+        }
+
+        // bump with any change to the processing in MeshLoader::parseMesh;
+        // cooked models of an older pipeline are then no longer found
+        constexpr uint32_t     IMPORT_PIPELINE_VERSION = 1;
+        constexpr unsigned int IMPORT_FLAGS            = aiProcess_Triangulate | aiProcess_CalcTangentSpace;
+
+        // cooked models are keyed by the model file and everything the
+        // import depends on that isn't a file
+        uint64_t hashModel(const uint8_t *data, size_t size)
+        {
+            const uint32_t settings[] = {IMPORT_PIPELINE_VERSION,
+                                         IMPORT_FLAGS,
+                                         vantor::Graphics::RenderDevice::OpenGL::VERTEX_COMPACT,
+                                         vantor::Graphics::Geometry::MeshOptimizer::CACHE_SIZE,
+                                         vantor::Graphics::Geometry::MeshSimplifier::MAX_LODS,
+                                         vantor::Graphics::Geometry::MeshletBuilder::MAX_VERTICES,
+                                         vantor::Graphics::Geometry::MeshletBuilder::MAX_TRIANGLES};
+            uint64_t       hash       = MeshCache::HashSource(data, size);
+            hash ^= MeshCache::HashSource((const uint8_t *) settings, sizeof(settings));
+            hash *= 1099511628211ull;
+            return hash;
+        }
+
+        // the hash a dependency is recorded with, 0 if it can't be read
+        uint64_t hashFile(const std::string &path)
+        {
+            MappedFile file;
+            if (!file.Open(path)) return 0;
+            return MeshCache::HashSource(file.GetData(), file.GetSize());
+        }
+
+        // remembers every file assimp opens besides the model itself (.mtl
+        // files, external buffers, ...), which the cooked model then depends on
+        class RecordingIOSystem : public Assimp::DefaultIOSystem
+        {
+            public:
+                RecordingIOSystem(const std::string &model, std::vector<std::string> &files) : m_Model(model), m_Files(files) {}
+
+                Assimp::IOStream *Open(const char *file, const char *mode) override
                 {
-                    node->Material = material;
+                    Assimp::IOStream *stream = Assimp::DefaultIOSystem::Open(file, mode);
+                    if (stream && !ComparePaths(file, m_Model.c_str()) && std::find(m_Files.begin(), m_Files.end(), file) == m_Files.end())
+                        m_Files.push_back(file);
+                    return stream;
                 }
-                node->BoxMin = boxMin;
-                node->BoxMax = boxMax;
-            }
 
-            else
+            private:
+                std::string               m_Model;
+                std::vector<std::string> &m_Files;
+        };
+    } // namespace
+
+    struct MeshLoad::Data
+    {
+            // the aiNode hierarchy, by mesh index
+            struct Node
             {
-                SceneNode *child = new SceneNode(0);
-                child->Mesh      = mesh;
-                child->Material  = material;
-                child->BoxMin    = boxMin;
-                child->BoxMax    = boxMax;
-                node->AddChild(child);
-            }
-        }
+                    std::vector<unsigned int> Meshes;
+                    std::vector<Node>         Children;
+            };
+            struct Texture
+            {
+                    std::string         Path;
+                    GLenum              Format;
+                    bool                Srgb;
+                    TEXTURE_COMPRESSION Compression;
+                    TextureData         Pixels;
+            };
 
-        for (unsigned int i = 0; i < aNode->mNumChildren; ++i)
+            vantor::Graphics::RenderDevice::OpenGL::Renderer *Renderer;
+            std::string                                       Path;
+            std::string                                       Directory;
+            bool                                              SetDefaultMaterial;
+
+            Node                                                        Root;
+            std::vector<vantor::Graphics::RenderDevice::OpenGL::Mesh *> Meshes; // by aiMesh index
+            std::vector<glm::vec3>                                      BoxMin;
+            std::vector<glm::vec3>                                      BoxMax;
+            std::vector<unsigned int>                                   MeshMaterials;
+            std::vector<MaterialDescription>                            Materials;
+            std::vector<Texture>                                        Textures;     // every distinct file, decoded
+            std::vector<std::string>                                    Dependencies; // other files assimp read
+
+            // set if read from or written to the MeshCache: the buffers are
+            // uploaded from the cooked file instead of being encoded again,
+            // from the mapping on a hit and from memory after cooking. Read
+            // meshes hold no CPU side attributes.
+            MappedFile                      Cooked;
+            std::vector<uint8_t>            CookedFile;
+            const uint8_t                  *CookedData = nullptr;
+            std::vector<const CookedMesh *> CookedMeshes;
+
+            // textures are copied into the uploader's buffers on a worker,
+            // a batch at a time, before the render thread uploads them
+            struct Copy
+            {
+                    const void *Source;
+                    uint8_t    *Target;
+                    size_t      Bytes;
+            };
+            unsigned int      StagedTextures   = 0;
+            std::atomic<bool> Staging          = false;
+            unsigned int      UploadedTextures = 0;
+            unsigned int      UploadedMeshes   = 0;
+    };
+    // --------------------------------------------------------------------------------------------
+    MeshLoad::MeshLoad() {}
+    // --------------------------------------------------------------------------------------------
+    MeshLoad::~MeshLoad()
+    {
+        // whatever was not handed over yet
+        if (!m_Data) return;
+        for (unsigned int i = m_Data->UploadedTextures; i < m_Data->Textures.size(); ++i)
+            TextureLoader::FreeTexture(m_Data->Textures[i].Pixels);
+        for (unsigned int i = m_Data->UploadedMeshes; i < m_Data->Meshes.size(); ++i)
+            delete m_Data->Meshes[i];
+    }
+
+    std::vector<vantor::Graphics::RenderDevice::OpenGL::Mesh *> MeshLoader::meshStore = std::vector<vantor::Graphics::RenderDevice::OpenGL::Mesh *>();
+    std::vector<std::shared_ptr<MeshLoad>>                       MeshLoader::pendingLoads = std::vector<std::shared_ptr<MeshLoad>>();
+    // --------------------------------------------------------------------------------------------
+    void MeshLoader::Clean()
+    {
+        for (unsigned int i = 0; i < MeshLoader::meshStore.size(); ++i)
         {
-            node->AddChild(MeshLoader::processNode(renderer, aNode->mChildren[i], aScene, directory, setDefaultMaterial));
+            delete MeshLoader::meshStore[i];
         }
+    }
+    // --------------------------------------------------------------------------------------------
+    vantor::SceneNode *MeshLoader::LoadMesh(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, std::string path, bool setDefaultMaterial)
+    {
+        vantor::Backlog::Log("ResourceLoader", "Loading mesh file at: " + path + ".", vantor::Backlog::LogLevel::INFO);
+
+        // the asynchronous load, run to completion right here
+        std::shared_ptr<MeshLoad> load = MeshLoader::createLoad(renderer, path, setDefaultMaterial);
+        MeshLoader::parseAsync(load.get());
+        if (load->GetState() == MESH_LOAD_FAILED) return nullptr;
+        MeshLoader::uploadAsync(load, std::chrono::steady_clock::time_point::max());
 
-        return node;
+        return load->GetNode();
     }
     // --------------------------------------------------------------------------------------------
     vantor::Graphics::RenderDevice::OpenGL::Mesh *MeshLoader::parseMesh(aiMesh *aMesh, const aiScene *aScene, glm::vec3 &out_Min, glm::vec3 &out_Max)
@@ -144,7 +313,7 @@ namespace vantor
         for (unsigned int i = 0; i < aMesh->mNumVertices; ++i)
         {
             positions[i] = glm::vec3(aMesh->mVertices[i].x, aMesh->mVertices[i].y, aMesh->mVertices[i].z);
-            normals[i]   = glm::vec3(aMesh->mNormals[i].x, aMesh->mNormals[i].y, aMesh->mNormals[i].z);
+            if (aMesh->mNormals) normals[i] = glm::vec3(aMesh->mNormals[i].x, aMesh->mNormals[i].y, aMesh->mNormals[i].z);
             if (aMesh->mTextureCoords[0])
             {
                 uv[i] = glm::vec2(aMesh->mTextureCoords[0][i].x, aMesh->mTextureCoords[0][i].y);
@@ -177,7 +346,31 @@ namespace vantor
         mesh->Bitangents                                   = bitangents;
         mesh->Indices                                      = indices;
         mesh->Topology                                     = vantor::Graphics::RenderDevice::OpenGL::TRIANGLES;
-        mesh->Finalize(true);
+        // the engine's mesh shaders all decode the compact formats
+        mesh->Format = vantor::Graphics::RenderDevice::OpenGL::VERTEX_COMPACT;
+
+        // aiProcess_CalcTangentSpace needs normals, so files without them
+        // get both here
+        if (!aMesh->mNormals) mesh->CalculateNormals();
+        if (aMesh->mTextureCoords[0] && !aMesh->mTangents) mesh->CalculateTangents();
+
+        // assimp's triangle order ignores the post-transform cache
+        vantor::Graphics::Geometry::VertexCacheStats before = vantor::Graphics::Geometry::MeshOptimizer::AnalyzeVertexCache(indices, positions.size());
+        vantor::Graphics::Geometry::VertexCacheStats after  = vantor::Graphics::Geometry::MeshOptimizer::Optimize(mesh);
+        char                                         stats[160];
+        std::snprintf(stats, sizeof(stats), "Optimized mesh: %u triangles, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f.", after.Triangles, before.ACMR, after.ACMR,
+                      before.ATVR, after.ATVR);
+        vantor::Backlog::Log("ResourceLoader", stats, vantor::Backlog::LogLevel::DEBUG);
+
+        // the levels share the vertex buffer, so this comes after the vertex
+        // fetch order is settled
+        unsigned int lods = vantor::Graphics::Geometry::MeshSimplifier::GenerateLODs(mesh);
+        if (lods > 1)
+        {
+            std::snprintf(stats, sizeof(stats), "Generated %u LODs down to %u triangles.", lods - 1, mesh->LODs.back().IndexCount / 3);
+            vantor::Backlog::Log("ResourceLoader", stats, vantor::Backlog::LogLevel::DEBUG);
+        }
+        vantor::Graphics::Geometry::MeshletBuilder::Build(mesh);
 
         out_Min.x = pMin.x;
         out_Min.y = pMin.y;
@@ -186,109 +379,430 @@ namespace vantor
         out_Max.y = pMax.y;
         out_Max.z = pMax.z;
 
-        MeshLoader::meshStore.push_back(mesh);
-
         return mesh;
     }
     // --------------------------------------------------------------------------------------------
-    vantor::Graphics::RenderDevice::OpenGL::Material *
-    MeshLoader::parseMaterial(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, aiMaterial *aMaterial, const aiScene *aScene, std::string directory)
+    std::shared_ptr<MeshLoad>
+    MeshLoader::createLoad(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, const std::string &path, bool setDefaultMaterial)
+    {
+        std::shared_ptr<MeshLoad> load   = std::make_shared<MeshLoad>();
+        load->m_Data                     = std::make_unique<MeshLoad::Data>();
+        load->m_Data->Renderer           = renderer;
+        load->m_Data->Path               = path;
+        load->m_Data->Directory          = path.substr(0, path.find_last_of("/"));
+        load->m_Data->SetDefaultMaterial = setDefaultMaterial;
+        return load;
+    }
+    // --------------------------------------------------------------------------------------------
+    std::shared_ptr<MeshLoad> MeshLoader::LoadMeshAsync(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, std::string path, bool setDefaultMaterial)
     {
-        vantor::Graphics::RenderDevice::OpenGL::Material *material;
+        vantor::Backlog::Log("ResourceLoader", "Loading mesh file asynchronously at: " + path + ".", vantor::Backlog::LogLevel::INFO);
 
-        aiString file;
-        aMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &file);
-        std::string diffPath = std::string(file.C_Str());
-        bool        alpha    = false;
-        if (diffPath.find("_alpha") != std::string::npos)
-        {
-            material = renderer->CreateMaterial("alpha discard");
-            alpha    = true;
-        }
-        else
-        {
-            material = renderer->CreateMaterial();
-        }
+        std::shared_ptr<MeshLoad> load = MeshLoader::createLoad(renderer, path, setDefaultMaterial);
+        MeshLoader::pendingLoads.push_back(load);
 
-        /* TEXTURE TYPES:
+        // the job keeps the load alive even if every handle is dropped meanwhile
+        vantor::Core::JobSystem::Execute([load]() { MeshLoader::parseAsync(load.get()); });
 
-            - aiTextureType_DIFFUSE:   Albedo
-            - aiTextureType_NORMALS:   Normal
-            - aiTextureType_SPECULAR:  metallic
-            - aiTextureType_SHININESS: roughness
-            - aiTextureType_AMBIENT:   AO (ambient occlusion)
-            - aiTextureType_EMISSIVE:  Emissive
+        return load;
+    }
+    // --------------------------------------------------------------------------------------------
+    void MeshLoader::parseAsync(MeshLoad *load)
+    {
+        MeshLoad::Data                       &data  = *load->m_Data;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-        */
-        if (aMaterial->GetTextureCount(aiTextureType_DIFFUSE) > 0)
+        // cooked models skip assimp and all of the mesh processing
+        uint64_t hash   = 0;
+        bool     cooked = false;
+        if (MeshCache::IsEnabled())
         {
-            aiString file;
-            aMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &file);
-            std::string                                      fileName = MeshLoader::processPath(&file, directory);
-            vantor::Graphics::RenderDevice::OpenGL::Texture *texture
-                = Resources::LoadTexture(fileName, fileName, GL_TEXTURE_2D, alpha ? GL_RGBA : GL_RGB, true);
-            if (texture)
+            MappedFile source;
+            if (source.Open(data.Path))
             {
-                material->SetTexture("TexAlbedo", texture, 3);
+                hash   = hashModel(source.GetData(), source.GetSize());
+                cooked = MeshLoader::readCooked(data, hash);
             }
         }
-        if (aMaterial->GetTextureCount(aiTextureType_DISPLACEMENT) > 0)
+        if (!cooked)
         {
-            aiString file;
-            aMaterial->GetTexture(aiTextureType_DISPLACEMENT, 0, &file);
-            std::string fileName = MeshLoader::processPath(&file, directory);
-
-            vantor::Graphics::RenderDevice::OpenGL::Texture *texture = Resources::LoadTexture(fileName, fileName);
-            if (texture)
+            if (!MeshLoader::importScene(data))
             {
-                material->SetTexture("TexNormal", texture, 4);
+                load->m_State.store(MESH_LOAD_FAILED, std::memory_order_release);
+                return;
             }
+            if (hash) MeshLoader::writeCooked(data, hash);
         }
-        if (aMaterial->GetTextureCount(aiTextureType_SPECULAR) > 0)
-        {
-            aiString file;
-            aMaterial->GetTexture(aiTextureType_SPECULAR, 0, &file);
-            std::string fileName = MeshLoader::processPath(&file, directory);
 
-            vantor::Graphics::RenderDevice::OpenGL::Texture *texture = Resources::LoadTexture(fileName, fileName);
-            if (texture)
+        // every texture file is decoded once, no matter how many materials share it
+        if (data.SetDefaultMaterial)
+        {
+            std::unordered_map<std::string, unsigned int> textures;
+            for (const MaterialDescription &material : data.Materials)
             {
-                material->SetTexture("TexMetallic", texture, 5);
+                for (unsigned int slot = 0; slot < MATERIAL_SLOT_COUNT; ++slot)
+                {
+                    const std::string &path = material.Textures[slot];
+                    if (path.empty() || !textures.emplace(path, (unsigned int) data.Textures.size()).second) continue;
+                    data.Textures.push_back({path, slotFormat(material, slot), MATERIAL_SLOTS[slot].Srgb, slotCompression(material, slot), TextureData()});
+                }
             }
+            vantor::Core::JobSystem::ParallelFor((unsigned int) data.Textures.size(),
+                                                 [&](unsigned int i)
+                                                 {
+                                                     MeshLoad::Data::Texture &texture = data.Textures[i];
+                                                     texture.Pixels = TextureLoader::CookTexture(texture.Path, texture.Compression, texture.Srgb);
+                                                 });
         }
-        if (aMaterial->GetTextureCount(aiTextureType_SHININESS) > 0)
+
+        char        stats[128];
+        double      milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const char *source       = cooked ? "from the mesh cache" : "with assimp";
+        std::snprintf(stats, sizeof(stats), "Parsed %u meshes %s in %.1f ms.", (unsigned int) data.Meshes.size(), source, milliseconds);
+        vantor::Backlog::Log("ResourceLoader", data.Path + ": " + stats, vantor::Backlog::LogLevel::INFO);
+
+        // publishes everything written above to the render thread
+        load->m_State.store(MESH_LOAD_UPLOADING, std::memory_order_release);
+    }
+    // --------------------------------------------------------------------------------------------
+    bool MeshLoader::importScene(MeshLoad::Data &data)
+    {
+        Assimp::Importer importer;
+        importer.SetIOHandler(new RecordingIOSystem(data.Path, data.Dependencies)); // owned by the importer
+        const aiScene *scene = importer.ReadFile(data.Path, IMPORT_FLAGS);
+
+        if (!scene || scene->mFlags == AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
         {
-            aiString file;
-            aMaterial->GetTexture(aiTextureType_SHININESS, 0, &file);
-            std::string fileName = MeshLoader::processPath(&file, directory);
+            vantor::Backlog::Log("ResourceLoader", "Assimp failed to load model at path: " + data.Path, vantor::Backlog::LogLevel::ERR);
+            return false;
+        }
 
-            vantor::Graphics::RenderDevice::OpenGL::Texture *texture = Resources::LoadTexture(fileName, fileName);
-            if (texture)
+        // meshes are independent of each other; parse (and optimize) them side by side
+        data.Meshes.resize(scene->mNumMeshes);
+        data.BoxMin.resize(scene->mNumMeshes);
+        data.BoxMax.resize(scene->mNumMeshes);
+        data.MeshMaterials.resize(scene->mNumMeshes);
+        vantor::Core::JobSystem::ParallelFor(scene->mNumMeshes,
+                                             [&](unsigned int i)
+                                             {
+                                                 data.Meshes[i]        = MeshLoader::parseMesh(scene->mMeshes[i], scene, data.BoxMin[i], data.BoxMax[i]);
+                                                 data.MeshMaterials[i] = scene->mMeshes[i]->mMaterialIndex;
+                                             });
+
+        // described even if unused, the cooked model shouldn't depend on it
+        data.Materials.resize(scene->mNumMaterials);
+        for (unsigned int i = 0; i < scene->mNumMaterials; ++i)
+            data.Materials[i] = describeMaterial(scene->mMaterials[i], data.Directory);
+
+        std::function<void(const aiNode *, MeshLoad::Data::Node &)> copyNode = [&](const aiNode *aNode, MeshLoad::Data::Node &node)
+        {
+            node.Meshes.assign(aNode->mMeshes, aNode->mMeshes + aNode->mNumMeshes);
+            node.Children.resize(aNode->mNumChildren);
+            for (unsigned int i = 0; i < aNode->mNumChildren; ++i)
+                copyNode(aNode->mChildren[i], node.Children[i]);
+        };
+        copyNode(scene->mRootNode, data.Root);
+
+        return true;
+    }
+    // --------------------------------------------------------------------------------------------
+    bool MeshLoader::readCooked(MeshLoad::Data &data, uint64_t hash)
+    {
+        const CookedHeader *header = MeshCache::Open(data.Cooked, hash);
+        if (!header) return false;
+
+        const uint8_t          *base         = data.Cooked.GetData();
+        const CookedDependency *dependencies = (const CookedDependency *) (base + header->DependencyOffset);
+        for (unsigned int i = 0; i < header->DependencyCount; ++i)
+        {
+            const char *path = (const char *) (base + header->StringOffset + dependencies[i].Path);
+            if (hashFile(path) != dependencies[i].Hash)
             {
-                material->SetTexture("TexRoughness", texture, 6);
+                vantor::Backlog::Log("ResourceLoader", data.Path + ": " + path + " changed, cooking the model again.", vantor::Backlog::LogLevel::DEBUG);
+                data.Cooked.Close();
+                return false;
             }
         }
-        if (aMaterial->GetTextureCount(aiTextureType_AMBIENT) > 0)
+
+        const CookedMesh     *meshes     = (const CookedMesh *) (base + header->MeshOffset);
+        const CookedMaterial *materials  = (const CookedMaterial *) (base + header->MaterialOffset);
+        const CookedNode     *nodes      = (const CookedNode *) (base + header->NodeOffset);
+        const uint32_t       *nodeMeshes = (const uint32_t *) (base + header->NodeMeshOffset);
+        const char           *strings    = (const char *) (base + header->StringOffset);
+
+        data.Meshes.resize(header->MeshCount);
+        data.BoxMin.resize(header->MeshCount);
+        data.BoxMax.resize(header->MeshCount);
+        data.MeshMaterials.resize(header->MeshCount);
+        data.CookedMeshes.resize(header->MeshCount);
+        for (unsigned int i = 0; i < header->MeshCount; ++i)
         {
-            aiString file;
-            aMaterial->GetTexture(aiTextureType_AMBIENT, 0, &file);
-            std::string fileName = MeshLoader::processPath(&file, directory);
+            const CookedMesh                                      &cooked = meshes[i];
+            const vantor::Graphics::RenderDevice::OpenGL::MeshLOD *lods   = (const vantor::Graphics::RenderDevice::OpenGL::MeshLOD *) (base + cooked.LODOffset);
+            const vantor::Graphics::RenderDevice::OpenGL::Meshlet *meshlets
+                = (const vantor::Graphics::RenderDevice::OpenGL::Meshlet *) (base + cooked.MeshletOffset);
+
+            vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh = new vantor::Graphics::RenderDevice::OpenGL::Mesh();
+            mesh->Topology                                     = (vantor::Graphics::RenderDevice::OpenGL::TOPOLOGY) cooked.Topology;
+            mesh->Format                                       = cooked.Format;
+            mesh->m_PositionOffset                             = glm::vec3(cooked.PositionOffset[0], cooked.PositionOffset[1], cooked.PositionOffset[2]);
+            mesh->m_PositionScale                              = glm::vec3(cooked.PositionScale[0], cooked.PositionScale[1], cooked.PositionScale[2]);
+            mesh->LODs.assign(lods, lods + cooked.LODCount);
+            mesh->Meshlets.assign(meshlets, meshlets + cooked.MeshletCount);
 
-            vantor::Graphics::RenderDevice::OpenGL::Texture *texture = Resources::LoadTexture(fileName, fileName);
-            if (texture)
+            data.Meshes[i]        = mesh;
+            data.BoxMin[i]        = glm::vec3(cooked.BoxMin[0], cooked.BoxMin[1], cooked.BoxMin[2]);
+            data.BoxMax[i]        = glm::vec3(cooked.BoxMax[0], cooked.BoxMax[1], cooked.BoxMax[2]);
+            data.MeshMaterials[i] = cooked.Material;
+            data.CookedMeshes[i]  = &cooked;
+        }
+
+        data.Materials.resize(header->MaterialCount);
+        for (unsigned int i = 0; i < header->MaterialCount; ++i)
+        {
+            data.Materials[i].Alpha = materials[i].Alpha;
+            for (unsigned int slot = 0; slot < MATERIAL_SLOT_COUNT; ++slot)
+                if (materials[i].Textures[slot] != MeshCache::NO_TEXTURE) data.Materials[i].Textures[slot] = strings + materials[i].Textures[slot];
+        }
+
+        std::function<void(unsigned int, MeshLoad::Data::Node &)> readNode = [&](unsigned int index, MeshLoad::Data::Node &node)
+        {
+            const CookedNode &cooked = nodes[index];
+            node.Meshes.assign(nodeMeshes + cooked.FirstMesh, nodeMeshes + cooked.FirstMesh + cooked.MeshCount);
+            node.Children.resize(cooked.ChildCount);
+            for (unsigned int i = 0; i < cooked.ChildCount; ++i)
+                readNode(cooked.FirstChild + i, node.Children[i]);
+        };
+        readNode(0, data.Root);
+
+        data.CookedData = base;
+        return true;
+    }
+    // --------------------------------------------------------------------------------------------
+    void MeshLoader::writeCooked(MeshLoad::Data &data, uint64_t hash)
+    {
+        std::vector<uint8_t> file;
+        auto                 append = [&file](const void *bytes, size_t size) -> uint64_t
+        {
+            uint64_t offset = (file.size() + 15) & ~(uint64_t) 15;
+            file.resize(offset + size);
+            if (bytes && size > 0) std::memcpy(file.data() + offset, bytes, size);
+            return offset;
+        };
+
+        // the root first and the children of every node next to each other
+        std::vector<CookedNode>                   nodes;
+        std::vector<uint32_t>                     nodeMeshes;
+        std::vector<const MeshLoad::Data::Node *> queue = {&data.Root};
+        for (unsigned int i = 0; i < queue.size(); ++i)
+        {
+            const MeshLoad::Data::Node *node = queue[i];
+            nodes.push_back({(uint32_t) nodeMeshes.size(), (uint32_t) node->Meshes.size(), (uint32_t) queue.size(), (uint32_t) node->Children.size()});
+            nodeMeshes.insert(nodeMeshes.end(), node->Meshes.begin(), node->Meshes.end());
+            for (const MeshLoad::Data::Node &child : node->Children)
+                queue.push_back(&child);
+        }
+
+        std::vector<CookedMaterial> materials(data.Materials.size());
+        std::vector<char>           strings;
+        for (unsigned int i = 0; i < data.Materials.size(); ++i)
+        {
+            materials[i].Alpha = data.Materials[i].Alpha;
+            for (unsigned int slot = 0; slot < MATERIAL_SLOT_COUNT; ++slot)
             {
-                material->SetTexture("TexAO", texture, 7);
+                const std::string &path     = data.Materials[i].Textures[slot];
+                materials[i].Textures[slot] = path.empty() ? MeshCache::NO_TEXTURE : (uint32_t) strings.size();
+                strings.insert(strings.end(), path.begin(), path.end());
+                if (!path.empty()) strings.push_back(0);
             }
         }
 
-        return material;
+        std::vector<CookedDependency> dependencies(data.Dependencies.size());
+        for (unsigned int i = 0; i < data.Dependencies.size(); ++i)
+        {
+            const std::string &path = data.Dependencies[i];
+            dependencies[i]         = {hashFile(path), (uint32_t) strings.size(), 0};
+            strings.insert(strings.end(), path.begin(), path.end());
+            strings.push_back(0);
+        }
+
+        CookedHeader header    = {};
+        header.Magic           = MeshCache::MAGIC;
+        header.Version         = MeshCache::VERSION;
+        header.SourceHash      = hash;
+        header.MeshCount       = data.Meshes.size();
+        header.MaterialCount   = materials.size();
+        header.NodeCount       = nodes.size();
+        header.NodeMeshCount   = nodeMeshes.size();
+        header.DependencyCount = dependencies.size();
+        header.StringBytes     = strings.size();
+        append(&header, sizeof(header));
+        header.MeshOffset       = append(nullptr, data.Meshes.size() * sizeof(CookedMesh)); // filled in below
+        header.MaterialOffset   = append(materials.data(), materials.size() * sizeof(CookedMaterial));
+        header.NodeOffset       = append(nodes.data(), nodes.size() * sizeof(CookedNode));
+        header.NodeMeshOffset   = append(nodeMeshes.data(), nodeMeshes.size() * sizeof(uint32_t));
+        header.DependencyOffset = append(dependencies.data(), dependencies.size() * sizeof(CookedDependency));
+        header.StringOffset     = append(strings.data(), strings.size());
+
+        std::vector<CookedMesh> meshes(data.Meshes.size());
+        std::vector<uint8_t>    vertices, indices;
+        for (unsigned int i = 0; i < data.Meshes.size(); ++i)
+        {
+            vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh   = data.Meshes[i];
+            CookedMesh                                   &cooked = meshes[i];
+            cooked                                               = {};
+
+            // the exact buffers Finalize() would upload; uploadAsync uses them
+            cooked.Attributes    = mesh->Encode(true, vertices, cooked.Layout, indices);
+            cooked.VertexCount   = mesh->Positions.size();
+            cooked.IndexCount    = mesh->Indices.size();
+            cooked.IndexType     = mesh->m_IndexType;
+            cooked.Topology      = mesh->Topology;
+            cooked.Format        = mesh->Format;
+            cooked.LODCount      = mesh->LODs.size();
+            cooked.MeshletCount  = mesh->Meshlets.size();
+            cooked.Material      = data.MeshMaterials[i];
+            cooked.VertexBytes   = vertices.size();
+            cooked.VertexOffset  = append(vertices.data(), vertices.size());
+            cooked.IndexOffset   = append(indices.data(), indices.size());
+            cooked.LODOffset     = append(mesh->LODs.data(), mesh->LODs.size() * sizeof(vantor::Graphics::RenderDevice::OpenGL::MeshLOD));
+            cooked.MeshletOffset = append(mesh->Meshlets.data(), mesh->Meshlets.size() * sizeof(vantor::Graphics::RenderDevice::OpenGL::Meshlet));
+            std::memcpy(cooked.BoxMin, &data.BoxMin[i], sizeof(cooked.BoxMin));
+            std::memcpy(cooked.BoxMax, &data.BoxMax[i], sizeof(cooked.BoxMax));
+            std::memcpy(cooked.PositionOffset, &mesh->m_PositionOffset, sizeof(cooked.PositionOffset));
+            std::memcpy(cooked.PositionScale, &mesh->m_PositionScale, sizeof(cooked.PositionScale));
+        }
+
+        std::memcpy(file.data(), &header, sizeof(header));
+        if (!meshes.empty()) std::memcpy(file.data() + header.MeshOffset, meshes.data(), meshes.size() * sizeof(CookedMesh));
+        MeshCache::Store(hash, file);
+
+        // uploaded from here, like a cache hit
+        data.CookedFile = std::move(file);
+        data.CookedData = data.CookedFile.data();
+        data.CookedMeshes.resize(data.Meshes.size());
+        for (unsigned int i = 0; i < data.Meshes.size(); ++i)
+            data.CookedMeshes[i] = (const CookedMesh *) (data.CookedData + header.MeshOffset) + i;
     }
     // --------------------------------------------------------------------------------------------
-    std::string MeshLoader::processPath(aiString *aPath, std::string directory)
+    void MeshLoader::UpdateLoads(float budgetMs)
     {
-        std::string path = std::string(aPath->C_Str());
-        if (path.find(":/") == std::string::npos || path.find(":\\") == std::string::npos) path = directory + "/" + path;
-        return path;
+        std::chrono::duration<float, std::milli> budget(budgetMs);
+        std::chrono::steady_clock::time_point    deadline = std::chrono::steady_clock::now();
+        deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(budget);
+        vantor::Graphics::RenderDevice::OpenGL::TextureUploader::NewFrame();
+
+        for (unsigned int i = 0; i < MeshLoader::pendingLoads.size(); ++i)
+        {
+            const std::shared_ptr<MeshLoad> &load = MeshLoader::pendingLoads[i];
+            if (load->GetState() == MESH_LOAD_UPLOADING && std::chrono::steady_clock::now() < deadline) MeshLoader::uploadAsync(load, deadline);
+        }
+
+        std::erase_if(MeshLoader::pendingLoads, [](const std::shared_ptr<MeshLoad> &load) { return load->GetState() >= MESH_LOAD_DONE; });
+    }
+    // --------------------------------------------------------------------------------------------
+    bool MeshLoader::uploadAsync(const std::shared_ptr<MeshLoad> &load, std::chrono::steady_clock::time_point deadline)
+    {
+        using vantor::Graphics::RenderDevice::OpenGL::TextureUploader;
+        MeshLoad::Data &data = *load->m_Data;
+
+        // one upload at a time, checking the budget in between; always makes
+        // progress. Textures also wait for a later frame once the uploader is
+        // out of bytes for this one, unless called without a deadline.
+        const bool bounded = deadline != std::chrono::steady_clock::time_point::max();
+        if (data.Staging.load(std::memory_order_acquire)) return false;
+        while (data.UploadedTextures < data.Textures.size())
+        {
+            // bounded loads copy on a worker: reserve uploader buffers for as
+            // many textures as fit, fill them in a job and upload them once
+            // it's done, so only the GL calls are left to the render thread
+            if (bounded && data.UploadedTextures == data.StagedTextures)
+            {
+                std::vector<MeshLoad::Data::Copy> copies;
+                for (; data.StagedTextures < data.Textures.size(); ++data.StagedTextures)
+                {
+                    TextureData &pixels = data.Textures[data.StagedTextures].Pixels;
+                    size_t       bytes  = TextureLoader::GetUploadBytes(pixels);
+                    if (!pixels.IsValid()) continue;
+                    if (!TextureUploader::CanUpload(bytes)) break;
+                    // too large ones stream from client memory, as with Begin()
+                    pixels.Staged = TextureUploader::Reserve(bytes);
+                    if (pixels.Staged < 0) continue;
+                    const void *source = pixels.CompressedFormat ? (const void *) pixels.Compressed.data() : (const void *) pixels.Pixels;
+                    copies.push_back({source, TextureUploader::GetMapping(pixels.Staged), bytes});
+                }
+                if (!copies.empty())
+                {
+                    data.Staging.store(true, std::memory_order_relaxed);
+                    // the job keeps the load alive; the sources stay untouched until it's done
+                    vantor::Core::JobSystem::Execute(
+                        [load, copies = std::move(copies)]()
+                        {
+                            for (const MeshLoad::Data::Copy &copy : copies)
+                                std::memcpy(copy.Target, copy.Source, copy.Bytes);
+                            load->m_Data->Staging.store(false, std::memory_order_release);
+                        });
+                    return false;
+                }
+                if (data.UploadedTextures == data.StagedTextures) return false; // out of bytes for this frame
+            }
+
+            MeshLoad::Data::Texture &texture = data.Textures[data.UploadedTextures];
+            ++data.UploadedTextures;
+            if (texture.Pixels.IsValid()) Resources::LoadTexture(texture.Path, texture.Pixels, GL_TEXTURE_2D, texture.Format, texture.Srgb);
+            TextureLoader::FreeTexture(texture.Pixels);
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+        }
+        while (data.UploadedMeshes < data.Meshes.size())
+        {
+            vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh = data.Meshes[data.UploadedMeshes];
+            if (data.CookedMeshes.empty())
+                mesh->Finalize(true);
+            else
+            {
+                const CookedMesh &cooked = *data.CookedMeshes[data.UploadedMeshes];
+                const uint8_t    *base   = data.CookedData;
+                mesh->Upload(cooked.Layout, cooked.Attributes, base + cooked.VertexOffset, cooked.VertexBytes, cooked.VertexCount, base + cooked.IndexOffset,
+                             cooked.IndexType, cooked.IndexCount);
+            }
+            MeshLoader::meshStore.push_back(mesh);
+            ++data.UploadedMeshes;
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+        }
+
+        // the textures are cached by now, so building materials is cheap
+        std::vector<vantor::Graphics::RenderDevice::OpenGL::Material *> materials(data.Materials.size());
+        for (unsigned int i = 0; i < data.Materials.size(); ++i)
+            materials[i] = createMaterial(data.Renderer, data.Materials[i]);
+
+        // same hierarchy as processNode builds
+        std::function<SceneNode *(const MeshLoad::Data::Node &)> buildNode = [&](const MeshLoad::Data::Node &source)
+        {
+            SceneNode *node = new SceneNode(0);
+            for (unsigned int mesh : source.Meshes)
+            {
+                SceneNode *target = node;
+                if (source.Meshes.size() > 1)
+                {
+                    target = new SceneNode(0);
+                    node->AddChild(target);
+                }
+                target->Mesh     = data.Meshes[mesh];
+                target->Material = data.SetDefaultMaterial ? materials[data.MeshMaterials[mesh]] : nullptr;
+                target->BoxMin   = data.BoxMin[mesh];
+                target->BoxMax   = data.BoxMax[mesh];
+            }
+            for (const MeshLoad::Data::Node &child : source.Children)
+                node->AddChild(buildNode(child));
+            return node;
+        };
+        load->m_Node = buildNode(data.Root);
+
+        vantor::Backlog::Log("ResourceLoader", "Succesfully loaded: " + data.Path + ".", vantor::Backlog::LogLevel::INFO);
+
+        load->m_Data.reset();
+        load->m_State.store(MESH_LOAD_DONE, std::memory_order_release);
+        return true;
     }
 
     /*
@@ -296,8 +810,22 @@ namespace vantor
       Shader loading
 
     */
+    std::unordered_map<std::string, std::string>                     ShaderLoader::includeCache = std::unordered_map<std::string, std::string>();
+    std::unordered_map<std::string, std::unordered_set<std::string>> ShaderLoader::includes
+        = std::unordered_map<std::string, std::unordered_set<std::string>>();
+    std::unordered_map<std::string, std::unordered_set<std::string>> ShaderLoader::includedBy
+        = std::unordered_map<std::string, std::unordered_set<std::string>>();
+    // --------------------------------------------------------------------------------------------
     vantor::Graphics::RenderDevice::OpenGL::Shader
     ShaderLoader::Load(std::string name, std::string vsPath, std::string fsPath, std::vector<std::string> defines)
+    {
+        std::string vsSource, fsSource;
+        if (!ReadSources(name, vsPath, fsPath, vsSource, fsSource)) return vantor::Graphics::RenderDevice::OpenGL::Shader();
+
+        return vantor::Graphics::RenderDevice::OpenGL::Shader(name, vsSource, fsSource, defines);
+    }
+    // --------------------------------------------------------------------------------------------
+    bool ShaderLoader::ReadSources(const std::string &name, const std::string &vsPath, const std::string &fsPath, std::string &vsSource, std::string &fsSource)
     {
         std::ifstream vsFile, fsFile;
         vsFile.open(vsPath);
@@ -306,35 +834,107 @@ namespace vantor
         if (!vsFile.is_open() || !fsFile.is_open())
         {
             vantor::Backlog::Log("ResourceLoader", "Shader failed to load at path: " + vsPath + " and " + fsPath, vantor::Backlog::LogLevel::ERR);
-            return vantor::Graphics::RenderDevice::OpenGL::Shader();
+            return false;
         }
 
-        std::string vsDirectory = vsPath.substr(0, vsPath.find_last_of("/\\"));
-        std::string fsDirectory = fsPath.substr(0, fsPath.find_last_of("/\\"));
-        std::string vsSource    = readShader(vsFile, name, vsPath);
-        std::string fsSource    = readShader(fsFile, name, fsPath);
-
-        vantor::Graphics::RenderDevice::OpenGL::Shader shader(name, vsSource, fsSource, defines);
+        vsSource = readShader(vsFile, name, NormalizePath(vsPath));
+        fsSource = readShader(fsFile, name, NormalizePath(fsPath));
 
         vsFile.close();
         fsFile.close();
 
-        return shader;
+        return true;
+    }
+    // --------------------------------------------------------------------------------------------
+    std::string ShaderLoader::NormalizePath(const std::string &path) { return std::filesystem::path(path).lexically_normal().generic_string(); }
+    // --------------------------------------------------------------------------------------------
+    std::vector<std::string> ShaderLoader::GetIncludes(const std::string &path)
+    {
+        std::vector<std::string>        result;
+        std::unordered_set<std::string> visited = {path};
+        std::stack<std::string>         open;
+        open.push(path);
+        while (!open.empty())
+        {
+            auto found = includes.find(open.top());
+            open.pop();
+            if (found == includes.end()) continue;
+
+            for (const std::string &include : found->second)
+            {
+                if (!visited.insert(include).second) continue;
+                result.push_back(include);
+                open.push(include);
+            }
+        }
+        return result;
+    }
+    // --------------------------------------------------------------------------------------------
+    std::vector<std::string> ShaderLoader::GetDependents(const std::string &path)
+    {
+        std::vector<std::string>        result;
+        std::unordered_set<std::string> visited = {path};
+        std::stack<std::string>         open;
+        open.push(path);
+        while (!open.empty())
+        {
+            auto found = includedBy.find(open.top());
+            open.pop();
+            if (found == includedBy.end()) continue;
+
+            for (const std::string &dependent : found->second)
+            {
+                if (!visited.insert(dependent).second) continue;
+                result.push_back(dependent);
+                open.push(dependent);
+            }
+        }
+        return result;
+    }
+    // --------------------------------------------------------------------------------------------
+    std::vector<std::string> ShaderLoader::Invalidate(const std::string &path)
+    {
+        // a cached include has all of its own includes baked in, so every
+        // file above the changed one is stale as well.
+        std::vector<std::string> dependents = GetDependents(path);
+        includeCache.erase(path);
+        for (const std::string &dependent : dependents)
+            includeCache.erase(dependent);
+        return dependents;
     }
     // --------------------------------------------------------------------------------------------
     std::string ShaderLoader::readShader(std::ifstream &file, const std::string &name, std::string path)
     {
+        // the file is parsed anew, so are its edges in the include graph
+        for (const std::string &include : includes[path])
+            includedBy[include].erase(path);
+        includes[path].clear();
+
         std::string directory = path.substr(0, path.find_last_of("/\\"));
         std::string source, line;
         while (std::getline(file, line))
         {
             if (line.substr(0, 8) == "#include")
             {
-                std::string   includePath = directory + "/" + line.substr(9);
+                std::string includePath = NormalizePath(directory + "/" + line.substr(9));
+                includes[path].insert(includePath);
+                includedBy[includePath].insert(path);
+
+                // common includes are shared by nearly every shader, resolve
+                // them once per run instead of once per shader.
+                auto cached = includeCache.find(includePath);
+                if (cached != includeCache.end())
+                {
+                    source += cached->second;
+                    continue;
+                }
+
                 std::ifstream includeFile(includePath);
                 if (includeFile.is_open())
                 {
-                    source += readShader(includeFile, name, includePath);
+                    std::string includeSource = readShader(includeFile, name, includePath);
+                    includeCache[includePath] = includeSource;
+                    source += includeSource;
                 }
                 else
                 {
@@ -354,7 +954,126 @@ namespace vantor
       Texture loading
 
     */
-    vantor::Graphics::RenderDevice::OpenGL::Texture TextureLoader::LoadTexture(std::string path, GLenum target, GLenum internalFormat, bool srgb)
+    namespace
+    {
+        // stb_image's flip-on-load switch is global to every thread, so
+        // images are decoded unflipped and flipped here instead.
+        void flipRows(void *pixels, int width, int height, size_t pixelSize)
+        {
+            size_t                     rowSize = (size_t) width * pixelSize;
+            std::vector<unsigned char> row(rowSize);
+            unsigned char             *bytes = (unsigned char *) pixels;
+            for (int y = 0; y < height / 2; ++y)
+            {
+                unsigned char *top    = bytes + (size_t) y * rowSize;
+                unsigned char *bottom = bytes + (size_t) (height - 1 - y) * rowSize;
+                std::memcpy(row.data(), top, rowSize);
+                std::memcpy(top, bottom, rowSize);
+                std::memcpy(bottom, row.data(), rowSize);
+            }
+        }
+
+        // immutable storage takes sized formats only
+        GLenum sizedFormat(GLenum internalFormat)
+        {
+            switch (internalFormat)
+            {
+                case GL_RED:
+                    return GL_R8;
+                case GL_RG:
+                    return GL_RG8;
+                case GL_RGB:
+                    return GL_RGB8;
+                case GL_SRGB:
+                    return GL_SRGB8;
+                case GL_RGBA:
+                    return GL_RGBA8;
+                case GL_SRGB_ALPHA:
+                    return GL_SRGB8_ALPHA8;
+                default:
+                    return internalFormat;
+            }
+        }
+    } // namespace
+    // --------------------------------------------------------------------------------------------
+    TextureData TextureLoader::DecodeTexture(std::string path)
+    {
+        TextureData data;
+        data.Pixels = stbi_load(path.c_str(), &data.Width, &data.Height, &data.Components, 0);
+        if (data.Pixels)
+            flipRows(data.Pixels, data.Width, data.Height, data.Components);
+        else
+            vantor::Backlog::Log("ResourceLoader", "Texture failed to load at path: " + path, vantor::Backlog::LogLevel::ERR);
+        return data;
+    }
+    // --------------------------------------------------------------------------------------------
+    TextureData TextureLoader::CookTexture(std::string path, TEXTURE_COMPRESSION compression, bool srgb)
+    {
+        if (!TextureCache::IsEnabled()) return TextureLoader::DecodeTexture(path);
+
+        TextureData data;
+        MappedFile  source;
+        if (!source.Open(path))
+        {
+            vantor::Backlog::Log("ResourceLoader", "Texture failed to load at path: " + path, vantor::Backlog::LogLevel::ERR);
+            return data;
+        }
+
+        uint64_t                   hash   = TextureCache::HashSource(source.GetData(), source.GetSize(), compression, srgb);
+        MappedFile                 cooked;
+        const CookedTextureHeader *header = TextureCache::Open(cooked, hash);
+        if (header)
+        {
+            data.Width            = header->Width;
+            data.Height           = header->Height;
+            data.Components       = header->Components;
+            data.CompressedFormat = header->Format;
+            data.BlockBytes       = TextureCompressor::GetBlockBytes((TEXTURE_COMPRESSION) header->Compression);
+            data.Levels           = header->Levels;
+            data.Compressed.assign(cooked.GetData() + sizeof(CookedTextureHeader), cooked.GetData() + sizeof(CookedTextureHeader) + header->DataBytes);
+            return data;
+        }
+
+        // decoded from the mapping, the file is only read once
+        unsigned char *pixels = stbi_load_from_memory(source.GetData(), (int) source.GetSize(), &data.Width, &data.Height, &data.Components, 4);
+        if (!pixels)
+        {
+            vantor::Backlog::Log("ResourceLoader", "Texture failed to load at path: " + path, vantor::Backlog::LogLevel::ERR);
+            return data;
+        }
+        flipRows(pixels, data.Width, data.Height, 4);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        data.CompressedFormat                       = TextureCompressor::GetFormat(compression, srgb);
+        data.BlockBytes                             = TextureCompressor::GetBlockBytes(compression);
+        data.Levels                                 = TextureCompressor::Compress(compression, srgb, pixels, data.Width, data.Height, data.Compressed);
+        stbi_image_free(pixels);
+
+        CookedTextureHeader cookedHeader;
+        cookedHeader.Magic       = TextureCache::MAGIC;
+        cookedHeader.Version     = TextureCache::VERSION;
+        cookedHeader.SourceHash  = hash;
+        cookedHeader.Width       = data.Width;
+        cookedHeader.Height      = data.Height;
+        cookedHeader.Components  = data.Components;
+        cookedHeader.Compression = compression;
+        cookedHeader.Format      = data.CompressedFormat;
+        cookedHeader.Levels      = data.Levels;
+        cookedHeader.DataBytes   = data.Compressed.size();
+        std::vector<uint8_t> file(sizeof(CookedTextureHeader) + data.Compressed.size());
+        std::memcpy(file.data(), &cookedHeader, sizeof(CookedTextureHeader));
+        std::memcpy(file.data() + sizeof(CookedTextureHeader), data.Compressed.data(), data.Compressed.size());
+        TextureCache::Store(hash, file);
+
+        char   stats[128];
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::snprintf(stats, sizeof(stats), ": cooked %dx%d, %u levels, %zu bytes in %.1f ms.", data.Width, data.Height, data.Levels, data.Compressed.size(),
+                      milliseconds);
+        vantor::Backlog::Log("ResourceLoader", path + stats, vantor::Backlog::LogLevel::DEBUG);
+        return data;
+    }
+    // --------------------------------------------------------------------------------------------
+    vantor::Graphics::RenderDevice::OpenGL::Texture TextureLoader::UploadTexture(const TextureData &data, GLenum target, GLenum internalFormat, bool srgb)
     {
         vantor::Graphics::RenderDevice::OpenGL::Texture texture;
         texture.Target         = target;
@@ -362,34 +1081,70 @@ namespace vantor
         if (texture.InternalFormat == GL_RGB || texture.InternalFormat == GL_SRGB) texture.InternalFormat = srgb ? GL_SRGB : GL_RGB;
         if (texture.InternalFormat == GL_RGBA || texture.InternalFormat == GL_SRGB_ALPHA) texture.InternalFormat = srgb ? GL_SRGB_ALPHA : GL_RGBA;
 
-        stbi_set_flip_vertically_on_load(true);
-
-        int            width, height, nrComponents;
-        unsigned char *data = stbi_load(path.c_str(), &width, &height, &nrComponents, 0);
-        if (data)
+        // streamed through the uploader's pixel buffers either way, unless
+        // the bytes were staged in one already
+        using vantor::Graphics::RenderDevice::OpenGL::TextureUploader;
+        if (data.CompressedFormat && target == GL_TEXTURE_2D)
         {
-            GLenum format;
-            if (nrComponents == 1)
-                format = GL_RED;
-            else if (nrComponents == 3)
-                format = GL_RGB;
-            else if (nrComponents == 4)
-                format = GL_RGBA;
-
-            if (target == GL_TEXTURE_1D)
-                texture.Generate(width, texture.InternalFormat, format, GL_UNSIGNED_BYTE, data);
-            else if (target == GL_TEXTURE_2D)
-                texture.Generate(width, height, texture.InternalFormat, format, GL_UNSIGNED_BYTE, data);
-            stbi_image_free(data);
+            const void *levels =
+                data.Staged >= 0 ? TextureUploader::Submit(data.Staged) : TextureUploader::Begin(data.Compressed.data(), data.Compressed.size());
+            texture.GenerateCompressed(data.Width, data.Height, data.CompressedFormat, data.Levels, data.BlockBytes, levels);
+            TextureUploader::End();
+            return texture;
         }
-        else
+        if (!data.Pixels)
         {
-            vantor::Backlog::Log("ResourceLoader", "Texture failed to load at path: " + path, vantor::Backlog::LogLevel::ERR);
-            stbi_image_free(data);
+            if (data.Staged >= 0) TextureUploader::Cancel(data.Staged);
             return texture;
         }
-        texture.Width  = width;
-        texture.Height = height;
+
+        GLenum format;
+        if (data.Components == 1)
+            format = GL_RED;
+        else if (data.Components == 3)
+            format = GL_RGB;
+        else if (data.Components == 4)
+            format = GL_RGBA;
+
+        // stb_image rows are tightly packed; the unpack alignment is global
+        // state, so it's only lowered for rows off the current one and
+        // restored afterwards
+        int alignment = 4;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+        const bool unaligned = (data.Width * data.Components) % alignment != 0;
+        if (unaligned) glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        const void *staged = data.Staged >= 0 ? TextureUploader::Submit(data.Staged) : TextureUploader::Begin(data.Pixels, TextureLoader::GetUploadBytes(data));
+        void       *pixels = (void *) staged;
+        if (target == GL_TEXTURE_1D)
+            texture.Generate(data.Width, texture.InternalFormat, format, GL_UNSIGNED_BYTE, pixels);
+        else if (target == GL_TEXTURE_2D)
+            texture.GenerateImmutable(data.Width, data.Height, sizedFormat(texture.InternalFormat), format, GL_UNSIGNED_BYTE, pixels);
+        TextureUploader::End();
+        if (unaligned) glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+        texture.Width  = data.Width;
+        texture.Height = data.Height;
+
+        return texture;
+    }
+    // --------------------------------------------------------------------------------------------
+    size_t TextureLoader::GetUploadBytes(const TextureData &data)
+    {
+        if (data.CompressedFormat) return data.Compressed.size();
+        return data.Pixels ? (size_t) data.Width * data.Height * data.Components : 0;
+    }
+    // --------------------------------------------------------------------------------------------
+    void TextureLoader::FreeTexture(TextureData &data)
+    {
+        stbi_image_free(data.Pixels);
+        data.Pixels = nullptr;
+        std::vector<uint8_t>().swap(data.Compressed);
+    }
+    // --------------------------------------------------------------------------------------------
+    vantor::Graphics::RenderDevice::OpenGL::Texture TextureLoader::LoadTexture(std::string path, GLenum target, GLenum internalFormat, bool srgb)
+    {
+        TextureData                                     data    = TextureLoader::DecodeTexture(path);
+        vantor::Graphics::RenderDevice::OpenGL::Texture texture = TextureLoader::UploadTexture(data, target, internalFormat, srgb);
+        TextureLoader::FreeTexture(data);
 
         return texture;
     }
@@ -401,14 +1156,14 @@ namespace vantor
         texture.FilterMin  = GL_LINEAR;
         texture.Mipmapping = false;
 
-        stbi_set_flip_vertically_on_load(true);
-
         if (stbi_is_hdr(path.c_str()))
         {
             int    width, height, nrComponents;
             float *data = stbi_loadf(path.c_str(), &width, &height, &nrComponents, 0);
             if (data)
             {
+                flipRows(data, width, height, nrComponents * sizeof(float));
+
                 GLenum internalFormat, format;
                 if (nrComponents == 3)
                 {
@@ -444,8 +1199,6 @@ namespace vantor
     {
         vantor::Graphics::RenderDevice::OpenGL::TextureCube texture;
 
-        stbi_set_flip_vertically_on_load(false);
-
         std::vector<std::string> faces = {top, bottom, left, right, front, back};
         for (unsigned int i = 0; i < faces.size(); ++i)
         {
@@ -23,20 +23,24 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "../../Graphics/RenderDevice/vantorRenderDevice.hpp"
 #include "../Scene/vantorSceneNode.hpp"
+#include "vantorTextureCompressor.hpp"
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
-struct aiNode;
 struct aiScene;
 struct aiMesh;
-struct aiMaterial;
-struct aiString;
 
 namespace vantor
 {
@@ -45,26 +49,94 @@ namespace vantor
       Mesh loading
 
     */
+    enum MESH_LOAD_STATE
+    {
+        MESH_LOAD_PARSING,   // file read, assimp, mesh processing and texture decoding on the job system
+        MESH_LOAD_UPLOADING, // GL uploads on the render thread, a time slice per frame
+        MESH_LOAD_DONE,
+        MESH_LOAD_FAILED,
+    };
+
+    // A model loading in the background, see MeshLoader::LoadMeshAsync and
+    // Resources::LoadMeshAsync. Poll it from the render thread; the node is
+    // set once the state is MESH_LOAD_DONE.
+    class MeshLoad
+    {
+            friend class MeshLoader;
+            friend class Resources;
+
+        public:
+            MeshLoad();
+            ~MeshLoad();
+
+            MESH_LOAD_STATE GetState() const { return m_State.load(std::memory_order_acquire); }
+            bool            IsDone() const { return GetState() == MESH_LOAD_DONE || GetState() == MESH_LOAD_FAILED; }
+            SceneNode      *GetNode() const { return m_Node; }
+
+        private:
+            struct Data; // everything parsed, until it is uploaded
+
+            std::atomic<MESH_LOAD_STATE> m_State{MESH_LOAD_PARSING};
+            SceneNode                   *m_Node = nullptr;
+            std::unique_ptr<Data>        m_Data;
+    };
+
+    // pixels as stb_image decoded them, see TextureLoader::DecodeTexture
+    struct TextureData
+    {
+            int            Width      = 0;
+            int            Height     = 0;
+            int            Components = 0;
+            unsigned char *Pixels     = nullptr; // null if decoding failed
+
+            // cooked textures (see TextureLoader::CookTexture) carry a block
+            // compressed mip chain instead of Pixels
+            GLenum               CompressedFormat = 0;
+            unsigned int         BlockBytes       = 0;
+            unsigned int         Levels           = 0;
+            std::vector<uint8_t> Compressed;
+
+            // TextureUploader buffer the upload bytes were copied to ahead of
+            // UploadTexture, -1 if they are streamed from Pixels/Compressed
+            int Staged = -1;
+
+            bool IsValid() const { return Pixels || CompressedFormat; }
+    };
+
     class MeshLoader
     {
         private:
             static std::vector<vantor::Graphics::RenderDevice::OpenGL::Mesh *> meshStore;
+            static std::vector<std::shared_ptr<MeshLoad>>                       pendingLoads;
 
         public:
-            static void       Clean();
+            static void Clean();
+            // both load through the MeshCache (see vantorMeshCache.hpp):
+            // assimp and the mesh processing only run for models not cooked
+            // yet, which are then cooked for the next time.
             static SceneNode *LoadMesh(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, std::string path, bool setDefaultMaterial = true);
+            // returns right away; reading, parsing, mesh processing and
+            // texture decoding run on the job system, UpdateLoads() does
+            // the GL uploads. Meshes referenced by several nodes are shared.
+            static std::shared_ptr<MeshLoad>
+            LoadMeshAsync(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, std::string path, bool setDefaultMaterial = true);
+            // once per frame on the render thread: uploads textures and
+            // meshes of finished loads until budgetMs is spent (at least one
+            // upload per frame), then completes them. Textures are further
+            // held to the TextureUploader's byte budget per frame.
+            static void UpdateLoads(float budgetMs);
 
         private:
-            static SceneNode                                    *processNode(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer,
-                                                                             aiNode                                           *aNode,
-                                                                             const aiScene                                    *aScene,
-                                                                             std::string                                       directory,
-                                                                             bool                                              setDefaultMaterial);
-            static vantor::Graphics::RenderDevice::OpenGL::Mesh *parseMesh(aiMesh *aMesh, const aiScene *aScene, glm::vec3 &out_Min, glm::vec3 &out_Max);
-            static vantor::Graphics::RenderDevice::OpenGL::Material *
-            parseMaterial(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, aiMaterial *aMaterial, const aiScene *aScene, std::string directory);
+            static std::shared_ptr<MeshLoad>
+            createLoad(vantor::Graphics::RenderDevice::OpenGL::Renderer *renderer, const std::string &path, bool setDefaultMaterial);
+            static void parseAsync(MeshLoad *load);
+            static bool uploadAsync(const std::shared_ptr<MeshLoad> &load, std::chrono::steady_clock::time_point deadline);
+            // fill in what parseAsync hands over to the upload
+            static bool importScene(MeshLoad::Data &data);
+            static bool readCooked(MeshLoad::Data &data, uint64_t hash);
+            static void writeCooked(MeshLoad::Data &data, uint64_t hash);
 
-            static std::string processPath(aiString *path, std::string directory);
+            static vantor::Graphics::RenderDevice::OpenGL::Mesh *parseMesh(aiMesh *aMesh, const aiScene *aScene, glm::vec3 &out_Min, glm::vec3 &out_Max);
     };
 
     /*
@@ -74,9 +146,30 @@ namespace vantor
     */
     class ShaderLoader
     {
+        private:
+            // resolved source of every included file, keyed by (normalized) path
+            static std::unordered_map<std::string, std::string> includeCache;
+            // include graph over every file read so far: the files each file
+            // includes directly, and the reverse of that.
+            static std::unordered_map<std::string, std::unordered_set<std::string>> includes;
+            static std::unordered_map<std::string, std::unordered_set<std::string>> includedBy;
+
         public:
             static vantor::Graphics::RenderDevice::OpenGL::Shader
             Load(std::string name, std::string vsPath, std::string fsPath, std::vector<std::string> defines = std::vector<std::string>());
+            // read both stages and resolve their includes
+            static bool
+            ReadSources(const std::string &name, const std::string &vsPath, const std::string &fsPath, std::string &vsSource, std::string &fsSource);
+
+            // "a/b/../c.glsl" -> "a/c.glsl"; the form every path is tracked in
+            static std::string NormalizePath(const std::string &path);
+            // every file path pulls in, directly or through other includes
+            static std::vector<std::string> GetIncludes(const std::string &path);
+            // every file that includes path, directly or indirectly
+            static std::vector<std::string> GetDependents(const std::string &path);
+            // drops the cached source of path and of everything including it,
+            // so they are read from disk again; returns the dependents.
+            static std::vector<std::string> Invalidate(const std::string &path);
 
         private:
             static std::string readShader(std::ifstream &file, const std::string &name, std::string path);
@@ -90,6 +183,17 @@ namespace vantor
     class TextureLoader
     {
         public:
+            // decoding is thread safe, uploading needs the GL context
+            static TextureData DecodeTexture(std::string path);
+            // the block compressed mip chain of path out of the TextureCache,
+            // cooked and stored first if it isn't in there yet. Same as
+            // DecodeTexture while the cache is disabled.
+            static TextureData                                     CookTexture(std::string path, TEXTURE_COMPRESSION compression, bool srgb);
+            static vantor::Graphics::RenderDevice::OpenGL::Texture UploadTexture(const TextureData &data, GLenum target, GLenum internalFormat, bool srgb);
+            static void                                            FreeTexture(TextureData &data);
+            // what UploadTexture streams to the GPU for data
+            static size_t GetUploadBytes(const TextureData &data);
+
             static vantor::Graphics::RenderDevice::OpenGL::Texture LoadTexture(std::string path, GLenum target, GLenum internalFormat, bool srgb = false);
             static vantor::Graphics::RenderDevice::OpenGL::Texture LoadHDRTexture(std::string path);
             static vantor::Graphics::RenderDevice::OpenGL::TextureCube
@@ -0,0 +1,112 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorTextureCache.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorTextureCache.hpp"
+#include "vantorMeshCache.hpp"
+#include "../BackLog/vantorBacklog.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#if !defined(__SWITCH__)
+#include <filesystem>
+#endif
+
+namespace vantor
+{
+    namespace
+    {
+        // read in place out of the mapping, so nothing may hide in padding
+        static_assert(sizeof(CookedTextureHeader) == 48);
+
+        bool validate(const uint8_t *data, size_t size, uint64_t hash)
+        {
+            if (size < sizeof(CookedTextureHeader)) return false;
+
+            const CookedTextureHeader *header = (const CookedTextureHeader *) data;
+            if (header->Magic != TextureCache::MAGIC || header->Version != TextureCache::VERSION || header->SourceHash != hash) return false;
+            if (header->Compression > TEXTURE_BC7 || header->Width == 0 || header->Height == 0 || header->Width > 16384 || header->Height > 16384)
+                return false;
+
+            TEXTURE_COMPRESSION compression = (TEXTURE_COMPRESSION) header->Compression;
+            if (header->Format != TextureCompressor::GetFormat(compression, false) && header->Format != TextureCompressor::GetFormat(compression, true))
+                return false;
+            if (header->Levels != TextureCompressor::GetLevelCount(header->Width, header->Height)) return false;
+
+            uint64_t bytes = 0;
+            for (uint32_t level = 0; level < header->Levels; ++level)
+                bytes += TextureCompressor::GetLevelBytes(compression, std::max(header->Width >> level, 1u), std::max(header->Height >> level, 1u));
+            return header->DataBytes == bytes && bytes <= size - sizeof(CookedTextureHeader);
+        }
+    } // namespace
+
+    std::string TextureCache::m_Directory = "cache/textures";
+    bool        TextureCache::m_Enabled   = true;
+    // --------------------------------------------------------------------------------------------
+    void TextureCache::SetDirectory(const std::string &directory) { m_Directory = directory; }
+    // --------------------------------------------------------------------------------------------
+    void TextureCache::SetEnabled(bool enabled) { m_Enabled = enabled; }
+    // --------------------------------------------------------------------------------------------
+    bool TextureCache::IsEnabled() { return m_Enabled; }
+    // --------------------------------------------------------------------------------------------
+    uint64_t TextureCache::HashSource(const uint8_t *data, size_t size, TEXTURE_COMPRESSION compression, bool srgb)
+    {
+        // the contents the same way cooked models are keyed, then the settings
+        uint64_t hash = MeshCache::HashSource(data, size);
+        hash ^= (uint64_t) compression << 1 | (srgb ? 1 : 0);
+        hash *= 1099511628211ull;
+        return hash;
+    }
+    // --------------------------------------------------------------------------------------------
+    const CookedTextureHeader *TextureCache::Open(MappedFile &file, uint64_t hash)
+    {
+        std::string path = getEntryPath(hash);
+        if (!m_Enabled || !file.Open(path)) return nullptr;
+
+        if (!validate(file.GetData(), file.GetSize(), hash))
+        {
+            vantor::Backlog::Log("TextureCache", "Discarding stale texture cache entry: " + path, vantor::Backlog::LogLevel::DEBUG);
+            file.Close();
+            std::remove(path.c_str());
+            return nullptr;
+        }
+        return (const CookedTextureHeader *) file.GetData();
+    }
+    // --------------------------------------------------------------------------------------------
+    void TextureCache::Store(uint64_t hash, const std::vector<uint8_t> &data)
+    {
+        if (!m_Enabled) return;
+#if !defined(__SWITCH__)
+        std::error_code error;
+        std::filesystem::create_directories(m_Directory, error);
+#endif
+
+        std::string path = getEntryPath(hash);
+        if (!WriteFileAtomic(path, data))
+            vantor::Backlog::Log("TextureCache", "Failed to write cooked texture: " + path, vantor::Backlog::LogLevel::WARNING);
+    }
+    // --------------------------------------------------------------------------------------------
+    std::string TextureCache::getEntryPath(uint64_t hash)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.vtex", (unsigned long long) hash);
+        return m_Directory + "/" + name;
+    }
+} // namespace vantor
@@ -0,0 +1,81 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorTextureCache.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include "vantorMappedFile.hpp"
+#include "vantorTextureCompressor.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vantor
+{
+    /*
+
+      Cooked textures: a block compressed mip chain down to 1x1, stored the
+      way it is uploaded. The CookedTextureHeader is followed by every
+      level, largest first and tightly packed.
+
+    */
+    struct CookedTextureHeader
+    {
+            uint32_t Magic;
+            uint32_t Version;
+            uint64_t SourceHash;
+            uint32_t Width;
+            uint32_t Height;
+            uint32_t Components;  // of the source image
+            uint32_t Compression; // TEXTURE_COMPRESSION
+            uint32_t Format;      // GL internal format
+            uint32_t Levels;
+            uint64_t DataBytes;
+    };
+
+    // On-disk cache of cooked textures, next to the MeshCache. The key
+    // covers the image file's contents and how it is compressed, as the
+    // same file may be cooked differently for different material slots.
+    class TextureCache
+    {
+        private:
+            static std::string m_Directory;
+            static bool        m_Enabled;
+
+        public:
+            static constexpr uint32_t MAGIC   = 0x58455456; // "VTEX"
+            static constexpr uint32_t VERSION = 1;
+
+            static void SetDirectory(const std::string &directory);
+            static void SetEnabled(bool enabled);
+            static bool IsEnabled();
+
+            static uint64_t HashSource(const uint8_t *data, size_t size, TEXTURE_COMPRESSION compression, bool srgb);
+
+            // maps the entry of hash; returns its header if the entry is
+            // complete and consistent, null otherwise. The levels follow it.
+            static const CookedTextureHeader *Open(MappedFile &file, uint64_t hash);
+            // through WriteFileAtomic, so readers never see half an entry
+            static void Store(uint64_t hash, const std::vector<uint8_t> &data);
+
+        private:
+            static std::string getEntryPath(uint64_t hash);
+    };
+} // namespace vantor
@@ -0,0 +1,583 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorTextureCompressor.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorTextureCompressor.hpp"
+#include "../JobSystem/vantorJobSystem.h"
+#include "../../Graphics/RenderDevice/DeviceOpenGL/vantorOpenGLExtensions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace vantor
+{
+    namespace
+    {
+        // BC7 interpolation weights for 4 bit indices, out of 64
+        const int BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        // packs bits least significant first, the order every BCn format uses
+        struct BitWriter
+        {
+                uint8_t     *Out;
+                unsigned int Position = 0;
+
+                void Write(uint32_t value, unsigned int bits)
+                {
+                    for (unsigned int i = 0; i < bits; ++i, ++Position)
+                        if ((value >> i) & 1) Out[Position >> 3] |= 1 << (Position & 7);
+                }
+        };
+
+        // the 16 texels of a block, repeating the last row and column of
+        // images that are not a multiple of 4 in size
+        void loadBlock(const uint8_t *rgba, unsigned int width, unsigned int height, unsigned int blockX, unsigned int blockY, float pixels[16][4])
+        {
+            for (unsigned int y = 0; y < 4; ++y)
+            {
+                for (unsigned int x = 0; x < 4; ++x)
+                {
+                    unsigned int   sourceX = std::min(blockX * 4 + x, width - 1);
+                    unsigned int   sourceY = std::min(blockY * 4 + y, height - 1);
+                    const uint8_t *texel   = rgba + ((size_t) sourceY * width + sourceX) * 4;
+                    for (unsigned int c = 0; c < 4; ++c)
+                        pixels[y * 4 + x][c] = texel[c];
+                }
+            }
+        }
+
+        // direction of the largest spread of the first channels of the
+        // block through their mean; power iteration on the covariance
+        void principalAxis(const float pixels[16][4], unsigned int channels, float mean[4], float axis[4])
+        {
+            float covariance[4][4] = {};
+            for (unsigned int c = 0; c < 4; ++c)
+            {
+                mean[c] = 0.0f;
+                for (unsigned int i = 0; i < 16; ++i)
+                    mean[c] += pixels[i][c] / 16.0f;
+            }
+            for (unsigned int i = 0; i < 16; ++i)
+                for (unsigned int a = 0; a < channels; ++a)
+                    for (unsigned int b = 0; b < channels; ++b)
+                        covariance[a][b] += (pixels[i][a] - mean[a]) * (pixels[i][b] - mean[b]);
+
+            for (unsigned int c = 0; c < 4; ++c)
+                axis[c] = c < channels ? 1.0f : 0.0f;
+            for (unsigned int iteration = 0; iteration < 8; ++iteration)
+            {
+                float next[4] = {}, length = 0.0f;
+                for (unsigned int a = 0; a < channels; ++a)
+                {
+                    for (unsigned int b = 0; b < channels; ++b)
+                        next[a] += covariance[a][b] * axis[b];
+                    length += next[a] * next[a];
+                }
+                // flat blocks have no spread to follow
+                if (length < 1e-12f)
+                {
+                    std::fill(axis, axis + 4, 0.0f);
+                    return;
+                }
+                length = std::sqrt(length);
+                for (unsigned int c = 0; c < channels; ++c)
+                    axis[c] = next[c] / length;
+            }
+        }
+
+        // the end points along the axis that enclose every texel
+        void axisEndpoints(const float pixels[16][4], unsigned int channels, float first[4], float second[4])
+        {
+            float mean[4], axis[4];
+            principalAxis(pixels, channels, mean, axis);
+
+            float minimum = 0.0f, maximum = 0.0f;
+            for (unsigned int i = 0; i < 16; ++i)
+            {
+                float t = 0.0f;
+                for (unsigned int c = 0; c < channels; ++c)
+                    t += (pixels[i][c] - mean[c]) * axis[c];
+                minimum = std::min(minimum, t);
+                maximum = std::max(maximum, t);
+            }
+            for (unsigned int c = 0; c < 4; ++c)
+            {
+                first[c]  = std::clamp(mean[c] + axis[c] * maximum, 0.0f, 255.0f);
+                second[c] = std::clamp(mean[c] + axis[c] * minimum, 0.0f, 255.0f);
+            }
+        }
+
+        // least squares end points for texels at fixed positions weights[i]
+        // (0 = first, 1 = second) between them; false if the system is singular
+        bool fitEndpoints(const float pixels[16][4], unsigned int channels, const float weights[16], float first[4], float second[4])
+        {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[4] = {}, bx[4] = {};
+            for (unsigned int i = 0; i < 16; ++i)
+            {
+                float alpha = 1.0f - weights[i], beta = weights[i];
+                aa += alpha * alpha;
+                ab += alpha * beta;
+                bb += beta * beta;
+                for (unsigned int c = 0; c < channels; ++c)
+                {
+                    ax[c] += alpha * pixels[i][c];
+                    bx[c] += beta * pixels[i][c];
+                }
+            }
+
+            float determinant = aa * bb - ab * ab;
+            if (std::fabs(determinant) < 1e-6f) return false;
+            for (unsigned int c = 0; c < channels; ++c)
+            {
+                first[c]  = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+                second[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        /*
+
+          BC1 color
+
+        */
+        uint16_t packColor(const float color[4])
+        {
+            int r = std::clamp((int) (color[0] * 31.0f / 255.0f + 0.5f), 0, 31);
+            int g = std::clamp((int) (color[1] * 63.0f / 255.0f + 0.5f), 0, 63);
+            int b = std::clamp((int) (color[2] * 31.0f / 255.0f + 0.5f), 0, 31);
+            return (uint16_t) (r << 11 | g << 5 | b);
+        }
+
+        void unpackColor(uint16_t packed, float color[3])
+        {
+            int r    = packed >> 11;
+            int g    = (packed >> 5) & 63;
+            int b    = packed & 31;
+            color[0] = (float) (r << 3 | r >> 2);
+            color[1] = (float) (g << 2 | g >> 4);
+            color[2] = (float) (b << 3 | b >> 2);
+        }
+
+        // picks the nearest of the four palette colors for every texel;
+        // orders the end points for four color mode. Returns the squared error.
+        float fitColorIndices(const float pixels[16][4], uint16_t &color0, uint16_t &color1, uint32_t &indices)
+        {
+            if (color0 < color1) std::swap(color0, color1);
+
+            float palette[4][3];
+            unpackColor(color0, palette[0]);
+            unpackColor(color1, palette[1]);
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+                palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+            }
+
+            // equal end points select three color mode, where only index 0 is safe
+            unsigned int entries = color0 == color1 ? 1 : 4;
+            float        error   = 0.0f;
+            indices              = 0;
+            for (unsigned int i = 0; i < 16; ++i)
+            {
+                unsigned int best     = 0;
+                float        bestDist = FLT_MAX;
+                for (unsigned int entry = 0; entry < entries; ++entry)
+                {
+                    float dist = 0.0f;
+                    for (unsigned int c = 0; c < 3; ++c)
+                        dist += (pixels[i][c] - palette[entry][c]) * (pixels[i][c] - palette[entry][c]);
+                    if (dist < bestDist)
+                    {
+                        best     = entry;
+                        bestDist = dist;
+                    }
+                }
+                indices |= best << (i * 2);
+                error += bestDist;
+            }
+            return error;
+        }
+
+        void encodeColorBlock(const float pixels[16][4], uint8_t *out)
+        {
+            float first[4], second[4];
+            axisEndpoints(pixels, 3, first, second);
+
+            uint16_t color0 = packColor(first), color1 = packColor(second);
+            uint32_t indices;
+            float    error = fitColorIndices(pixels, color0, color1, indices);
+
+            // refit the end points to the chosen indices while that helps
+            const float POSITIONS[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+            for (unsigned int pass = 0; pass < 2 && error > 0.0f; ++pass)
+            {
+                float weights[16];
+                for (unsigned int i = 0; i < 16; ++i)
+                    weights[i] = POSITIONS[(indices >> (i * 2)) & 3];
+                if (!fitEndpoints(pixels, 3, weights, first, second)) break;
+
+                uint16_t refit0 = packColor(first), refit1 = packColor(second);
+                uint32_t refitIndices;
+                float    refitError = fitColorIndices(pixels, refit0, refit1, refitIndices);
+                if (refitError >= error) break;
+                color0  = refit0;
+                color1  = refit1;
+                indices = refitIndices;
+                error   = refitError;
+            }
+
+            out[0] = color0 & 0xFF;
+            out[1] = color0 >> 8;
+            out[2] = color1 & 0xFF;
+            out[3] = color1 >> 8;
+            for (unsigned int i = 0; i < 4; ++i)
+                out[4 + i] = (indices >> (i * 8)) & 0xFF;
+        }
+
+        /*
+
+          BC4 single channel
+
+        */
+        void encodeChannelBlock(const float pixels[16][4], unsigned int channel, uint8_t *out)
+        {
+            int high = 0, low = 255;
+            for (unsigned int i = 0; i < 16; ++i)
+            {
+                high = std::max(high, (int) pixels[i][channel]);
+                low  = std::min(low, (int) pixels[i][channel]);
+            }
+
+            // eight value mode: index 0 is high, 1 is low and 2..7 step from
+            // high to low, so the nearest step maps to its index through CODES
+            const uint8_t CODES[8] = {0, 2, 3, 4, 5, 6, 7, 1};
+            uint64_t      bits     = 0;
+            if (high > low)
+            {
+                int range = high - low;
+                for (unsigned int i = 0; i < 16; ++i)
+                {
+                    int step = ((high - (int) pixels[i][channel]) * 7 + range / 2) / range;
+                    bits |= (uint64_t) CODES[step] << (i * 3);
+                }
+            }
+
+            out[0] = (uint8_t) high;
+            out[1] = (uint8_t) low;
+            for (unsigned int i = 0; i < 6; ++i)
+                out[2 + i] = (bits >> (i * 8)) & 0xFF;
+        }
+
+        /*
+
+          BC7 mode 6: one subset, RGBA end points with 7 bits per channel plus
+          a p-bit each, 4 bit indices
+
+        */
+        // nearest representable end point; returns it expanded to 8 bits
+        void quantizeEndpoint(const float color[4], int quantized[4], int &pBit, int expanded[4])
+        {
+            float bestError = FLT_MAX;
+            for (int p = 0; p < 2; ++p)
+            {
+                int   candidate[4];
+                float error = 0.0f;
+                for (unsigned int c = 0; c < 4; ++c)
+                {
+                    candidate[c] = std::clamp((int) std::lround((color[c] - p) / 2.0f), 0, 127);
+                    float delta  = (float) (candidate[c] * 2 + p) - color[c];
+                    error += delta * delta;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    pBit      = p;
+                    std::copy(candidate, candidate + 4, quantized);
+                }
+            }
+            for (unsigned int c = 0; c < 4; ++c)
+                expanded[c] = quantized[c] * 2 + pBit;
+        }
+
+        float fitModeSixIndices(const float pixels[16][4], const int first[4], const int second[4], uint8_t indices[16])
+        {
+            float palette[16][4];
+            for (unsigned int entry = 0; entry < 16; ++entry)
+                for (unsigned int c = 0; c < 4; ++c)
+                    palette[entry][c] = (float) (((64 - BC7_WEIGHTS[entry]) * first[c] + BC7_WEIGHTS[entry] * second[c] + 32) >> 6);
+
+            float error = 0.0f;
+            for (unsigned int i = 0; i < 16; ++i)
+            {
+                float bestDist = FLT_MAX;
+                for (unsigned int entry = 0; entry < 16; ++entry)
+                {
+                    float dist = 0.0f;
+                    for (unsigned int c = 0; c < 4; ++c)
+                        dist += (pixels[i][c] - palette[entry][c]) * (pixels[i][c] - palette[entry][c]);
+                    if (dist < bestDist)
+                    {
+                        bestDist   = dist;
+                        indices[i] = entry;
+                    }
+                }
+                error += bestDist;
+            }
+            return error;
+        }
+
+        void encodeModeSixBlock(const float pixels[16][4], uint8_t *out)
+        {
+            float first[4], second[4];
+            axisEndpoints(pixels, 4, first, second);
+
+            int     quantized[2][4], pBits[2], expanded[2][4];
+            uint8_t indices[16];
+            quantizeEndpoint(first, quantized[0], pBits[0], expanded[0]);
+            quantizeEndpoint(second, quantized[1], pBits[1], expanded[1]);
+            float error = fitModeSixIndices(pixels, expanded[0], expanded[1], indices);
+
+            for (unsigned int pass = 0; pass < 2 && error > 0.0f; ++pass)
+            {
+                float weights[16];
+                for (unsigned int i = 0; i < 16; ++i)
+                    weights[i] = BC7_WEIGHTS[indices[i]] / 64.0f;
+                if (!fitEndpoints(pixels, 4, weights, first, second)) break;
+
+                int     refitQuantized[2][4], refitPBits[2], refitExpanded[2][4];
+                uint8_t refitIndices[16];
+                quantizeEndpoint(first, refitQuantized[0], refitPBits[0], refitExpanded[0]);
+                quantizeEndpoint(second, refitQuantized[1], refitPBits[1], refitExpanded[1]);
+                float refitError = fitModeSixIndices(pixels, refitExpanded[0], refitExpanded[1], refitIndices);
+                if (refitError >= error) break;
+                std::memcpy(quantized, refitQuantized, sizeof(quantized));
+                std::memcpy(pBits, refitPBits, sizeof(pBits));
+                std::memcpy(expanded, refitExpanded, sizeof(expanded));
+                std::memcpy(indices, refitIndices, sizeof(indices));
+                error = refitError;
+            }
+
+            // the first index is stored without its top bit, which has to be 0
+            if (indices[0] & 8)
+            {
+                std::swap(quantized[0], quantized[1]);
+                std::swap(pBits[0], pBits[1]);
+                for (unsigned int i = 0; i < 16; ++i)
+                    indices[i] = 15 - indices[i];
+            }
+
+            std::memset(out, 0, 16);
+            BitWriter writer{out};
+            writer.Write(1 << 6, 7);
+            for (unsigned int c = 0; c < 4; ++c)
+            {
+                writer.Write(quantized[0][c], 7);
+                writer.Write(quantized[1][c], 7);
+            }
+            writer.Write(pBits[0], 1);
+            writer.Write(pBits[1], 1);
+            for (unsigned int i = 0; i < 16; ++i)
+                writer.Write(indices[i], i == 0 ? 3 : 4);
+        }
+
+        /*
+
+          Mip generation
+
+        */
+        const std::array<float, 256> &srgbToLinear()
+        {
+            static const std::array<float, 256> table = []()
+            {
+                std::array<float, 256> values;
+                for (unsigned int i = 0; i < 256; ++i)
+                {
+                    float c   = i / 255.0f;
+                    values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        uint8_t linearToSrgb(float c)
+        {
+            c = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+            return (uint8_t) std::clamp((int) (c * 255.0f + 0.5f), 0, 255);
+        }
+    } // namespace
+    // --------------------------------------------------------------------------------------------
+    GLenum TextureCompressor::GetFormat(TEXTURE_COMPRESSION compression, bool srgb)
+    {
+        switch (compression)
+        {
+            case TEXTURE_BC1:
+                return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case TEXTURE_BC3:
+                return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case TEXTURE_BC4:
+                return GL_COMPRESSED_RED_RGTC1;
+            case TEXTURE_BC5:
+                return GL_COMPRESSED_RG_RGTC2;
+            default:
+                return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    unsigned int TextureCompressor::GetBlockBytes(TEXTURE_COMPRESSION compression)
+    {
+        return compression == TEXTURE_BC1 || compression == TEXTURE_BC4 ? 8 : 16;
+    }
+    // --------------------------------------------------------------------------------------------
+    size_t TextureCompressor::GetLevelBytes(TEXTURE_COMPRESSION compression, unsigned int width, unsigned int height)
+    {
+        return (size_t) ((width + 3) / 4) * ((height + 3) / 4) * GetBlockBytes(compression);
+    }
+    // --------------------------------------------------------------------------------------------
+    unsigned int TextureCompressor::GetLevelCount(unsigned int width, unsigned int height)
+    {
+        unsigned int levels = 1;
+        unsigned int size   = std::max(width, height);
+        while (size >>= 1)
+            ++levels;
+        return levels;
+    }
+    // --------------------------------------------------------------------------------------------
+    unsigned int TextureCompressor::Compress(TEXTURE_COMPRESSION compression, bool srgb, const uint8_t *rgba, unsigned int width, unsigned int height,
+                                             std::vector<uint8_t> &out)
+    {
+        unsigned int levels = GetLevelCount(width, height);
+        size_t       bytes  = 0;
+        for (unsigned int level = 0; level < levels; ++level)
+            bytes += GetLevelBytes(compression, std::max(width >> level, 1u), std::max(height >> level, 1u));
+        out.resize(bytes);
+
+        // each level is filtered from the one above, ping-ponging between two buffers
+        std::vector<uint8_t> buffers[2];
+        const uint8_t       *source = rgba;
+        size_t               offset = 0;
+        for (unsigned int level = 0; level < levels; ++level)
+        {
+            CompressLevel(compression, source, width, height, out.data() + offset);
+            offset += GetLevelBytes(compression, width, height);
+            if (level + 1 == levels) break;
+
+            std::vector<uint8_t> &target = buffers[level & 1];
+            target.resize((size_t) std::max(width / 2, 1u) * std::max(height / 2, 1u) * 4);
+            Downsample(compression, srgb, source, width, height, target.data());
+            source = target.data();
+            width  = std::max(width / 2, 1u);
+            height = std::max(height / 2, 1u);
+        }
+        return levels;
+    }
+    // --------------------------------------------------------------------------------------------
+    void TextureCompressor::CompressLevel(TEXTURE_COMPRESSION compression, const uint8_t *rgba, unsigned int width, unsigned int height, uint8_t *out)
+    {
+        unsigned int blocksX    = (width + 3) / 4;
+        unsigned int blocksY    = (height + 3) / 4;
+        unsigned int blockBytes = GetBlockBytes(compression);
+
+        // block rows are independent
+        vantor::Core::JobSystem::ParallelFor(blocksY,
+                                             [&](unsigned int blockY)
+                                             {
+                                                 float pixels[16][4];
+                                                 for (unsigned int blockX = 0; blockX < blocksX; ++blockX)
+                                                 {
+                                                     uint8_t *block = out + ((size_t) blockY * blocksX + blockX) * blockBytes;
+                                                     loadBlock(rgba, width, height, blockX, blockY, pixels);
+                                                     switch (compression)
+                                                     {
+                                                         case TEXTURE_BC1:
+                                                             encodeColorBlock(pixels, block);
+                                                             break;
+                                                         case TEXTURE_BC3:
+                                                             encodeChannelBlock(pixels, 3, block);
+                                                             encodeColorBlock(pixels, block + 8);
+                                                             break;
+                                                         case TEXTURE_BC4:
+                                                             encodeChannelBlock(pixels, 0, block);
+                                                             break;
+                                                         case TEXTURE_BC5:
+                                                             encodeChannelBlock(pixels, 0, block);
+                                                             encodeChannelBlock(pixels, 1, block + 8);
+                                                             break;
+                                                         case TEXTURE_BC7:
+                                                             encodeModeSixBlock(pixels, block);
+                                                             break;
+                                                     }
+                                                 }
+                                             });
+    }
+    // --------------------------------------------------------------------------------------------
+    void TextureCompressor::Downsample(TEXTURE_COMPRESSION compression, bool srgb, const uint8_t *rgba, unsigned int width, unsigned int height,
+                                       uint8_t *out)
+    {
+        const std::array<float, 256> &linear = srgbToLinear();
+
+        unsigned int targetWidth  = std::max(width / 2, 1u);
+        unsigned int targetHeight = std::max(height / 2, 1u);
+        for (unsigned int y = 0; y < targetHeight; ++y)
+        {
+            for (unsigned int x = 0; x < targetWidth; ++x)
+            {
+                // odd sizes drop their last row / column, 1 texel wide ones repeat it
+                const uint8_t *texels[4] = {
+                    rgba + ((size_t) std::min(y * 2, height - 1) * width + std::min(x * 2, width - 1)) * 4,
+                    rgba + ((size_t) std::min(y * 2, height - 1) * width + std::min(x * 2 + 1, width - 1)) * 4,
+                    rgba + ((size_t) std::min(y * 2 + 1, height - 1) * width + std::min(x * 2, width - 1)) * 4,
+                    rgba + ((size_t) std::min(y * 2 + 1, height - 1) * width + std::min(x * 2 + 1, width - 1)) * 4,
+                };
+                uint8_t *target = out + ((size_t) y * targetWidth + x) * 4;
+
+                if (compression == TEXTURE_BC5)
+                {
+                    float normal[3] = {};
+                    for (const uint8_t *texel : texels)
+                        for (unsigned int c = 0; c < 3; ++c)
+                            normal[c] += texel[c] / 127.5f - 1.0f;
+                    float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+                    if (length < 1e-6f)
+                    {
+                        normal[0] = normal[1] = 0.0f;
+                        normal[2] = length = 1.0f;
+                    }
+                    for (unsigned int c = 0; c < 3; ++c)
+                        target[c] = (uint8_t) std::clamp((int) ((normal[c] / length + 1.0f) * 127.5f + 0.5f), 0, 255);
+                }
+                else if (srgb)
+                {
+                    for (unsigned int c = 0; c < 3; ++c)
+                        target[c] = linearToSrgb((linear[texels[0][c]] + linear[texels[1][c]] + linear[texels[2][c]] + linear[texels[3][c]]) * 0.25f);
+                }
+                else
+                {
+                    for (unsigned int c = 0; c < 3; ++c)
+                        target[c] = (uint8_t) ((texels[0][c] + texels[1][c] + texels[2][c] + texels[3][c] + 2) / 4);
+                }
+                target[3] = (uint8_t) ((texels[0][3] + texels[1][3] + texels[2][3] + texels[3][3] + 2) / 4);
+            }
+        }
+    }
+} // namespace vantor
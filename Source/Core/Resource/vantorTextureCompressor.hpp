@@ -0,0 +1,64 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorTextureCompressor.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vantor
+{
+    // GPU block compressed formats; all of them store 4x4 texel blocks.
+    enum TEXTURE_COMPRESSION
+    {
+        TEXTURE_BC1, // RGB, 8 bytes per block
+        TEXTURE_BC3, // RGBA, BC1 color plus a BC4 alpha block
+        TEXTURE_BC4, // R, for single channel masks
+        TEXTURE_BC5, // RG, for tangent space normal maps; z is rebuilt in the shader
+        TEXTURE_BC7, // RGBA at BC3's size in better quality (mode 6 only)
+    };
+
+    // Compresses RGBA8 images into BCn mip chains at cook time. BC1 and BC3
+    // need GL_EXT_texture_compression_s3tc, BC4, BC5 and BC7 are core.
+    class TextureCompressor
+    {
+        public:
+            static GLenum       GetFormat(TEXTURE_COMPRESSION compression, bool srgb);
+            static unsigned int GetBlockBytes(TEXTURE_COMPRESSION compression);
+            static size_t       GetLevelBytes(TEXTURE_COMPRESSION compression, unsigned int width, unsigned int height);
+            // levels of a full mip chain, down to 1x1
+            static unsigned int GetLevelCount(unsigned int width, unsigned int height);
+
+            // compresses rgba (4 bytes per texel, rows top to bottom as stored)
+            // and every mip level below it into out, largest level first and
+            // tightly packed; returns the number of levels.
+            static unsigned int Compress(TEXTURE_COMPRESSION compression, bool srgb, const uint8_t *rgba, unsigned int width, unsigned int height,
+                                         std::vector<uint8_t> &out);
+
+            // single level; out holds GetLevelBytes() bytes
+            static void CompressLevel(TEXTURE_COMPRESSION compression, const uint8_t *rgba, unsigned int width, unsigned int height, uint8_t *out);
+            // 2x2 box filter into the next level. sRGB color is averaged in
+            // linear space, normal maps (BC5) are renormalized.
+            static void Downsample(TEXTURE_COMPRESSION compression, bool srgb, const uint8_t *rgba, unsigned int width, unsigned int height, uint8_t *out);
+    };
+} // namespace vantor
@@ -39,6 +39,7 @@ namespace vantor
         initialized = true;
 
         // TODO: Initializing with vantorInitializer
+        vantor::Core::JobSystem::Initialize();
         vantor::Platform::Input::Initialize();
         vantor::Backlog::Log("Application", "Using RenderDevice " + vantor::Graphics::RenderDevice::apiToString(vantor::Graphics::RenderDevice::OPENGL),
                              vantor::Backlog::LogLevel::DEBUG);
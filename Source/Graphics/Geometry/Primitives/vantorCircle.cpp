@@ -32,9 +32,12 @@ namespace vantor::Graphics::Geometry::Primitives
 {
     Circle::Circle(unsigned int edgeSegments, unsigned int ringSegments)
     {
+        Positions.resize((edgeSegments + 1) * (ringSegments + 1));
+
+        unsigned int vertex = 0;
         for (unsigned int y = 0; y <= ringSegments; ++y)
         {
-            for (unsigned int x = 0; x <= edgeSegments; ++x)
+            for (unsigned int x = 0; x <= edgeSegments; ++x, ++vertex)
             {
                 float xSegment  = static_cast<float>(x) / static_cast<float>(edgeSegments);
                 float ringDepth = static_cast<float>(y) / static_cast<float>(ringSegments);
@@ -42,10 +45,12 @@ namespace vantor::Graphics::Geometry::Primitives
                 float xPos      = std::cos(angle);
                 float yPos      = std::sin(angle);
 
-                Positions.emplace_back(xPos * ringDepth, yPos * ringDepth, 0.0f);
+                Positions[vertex] = glm::vec3(xPos * ringDepth, yPos * ringDepth, 0.0f);
             }
         }
 
+        Indices.reserve(ringSegments * (edgeSegments + 1) * 2);
+
         bool oddRow = false;
         for (int y = 0; y < ringSegments; ++y)
         {
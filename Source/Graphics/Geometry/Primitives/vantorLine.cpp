@@ -30,13 +30,15 @@ namespace vantor::Graphics::Geometry::Primitives
     LineStrip::LineStrip(float width, unsigned int segments)
     {
         float deltaX = 1.0f / segments;
+        Positions.resize((segments + 1) * 2);
+        UV.resize((segments + 1) * 2);
         for (int i = 0; i <= segments; ++i)
         {
-            Positions.push_back({-0.5f + (float) i * deltaX, 0.5f * width, 0.0f});
-            Positions.push_back({-0.5f + (float) i * deltaX, -0.5f * width, 0.0f});
+            Positions[i * 2]     = {-0.5f + (float) i * deltaX, 0.5f * width, 0.0f};
+            Positions[i * 2 + 1] = {-0.5f + (float) i * deltaX, -0.5f * width, 0.0f};
 
-            UV.push_back({(float) i * deltaX, 1.0f});
-            UV.push_back({(float) i * deltaX, 0.0f});
+            UV[i * 2]     = {(float) i * deltaX, 1.0f};
+            UV[i * 2 + 1] = {(float) i * deltaX, 0.0f};
         }
 
         Topology = vantor::Graphics::RenderDevice::OpenGL::TOPOLOGY::TRIANGLE_STRIP;
@@ -35,16 +35,25 @@ namespace vantor::Graphics::Geometry::Primitives
         float dX = 1.0f / xSegments;
         float dY = 1.0f / ySegments;
 
+        // V runs against y, so the bitangent points down
+        const unsigned int vertexCount = (xSegments + 1) * (ySegments + 1);
+        Positions.resize(vertexCount);
+        UV.resize(vertexCount);
+        Normals.assign(vertexCount, glm::vec3(0.0f, 0.0f, 1.0f));
+        Tangents.assign(vertexCount, glm::vec3(1.0f, 0.0f, 0.0f));
+        Bitangents.assign(vertexCount, glm::vec3(0.0f, -1.0f, 0.0f));
+
+        unsigned int vertex = 0;
         for (int y = 0; y <= ySegments; ++y)
         {
-            for (int x = 0; x <= xSegments; ++x)
+            for (int x = 0; x <= xSegments; ++x, ++vertex)
             {
-                Positions.push_back(glm::vec3(dX * x * 2.0f - 1.0f, dY * y * 2.0f - 1.0f, 0.0f));
-                UV.push_back(glm::vec2(dX * x, 1.0f - y * dY));
-                Normals.push_back(glm::vec3(0.0f, 0.0f, 1.0f));
+                Positions[vertex] = glm::vec3(dX * x * 2.0f - 1.0f, dY * y * 2.0f - 1.0f, 0.0f);
+                UV[vertex]        = glm::vec2(dX * x, 1.0f - y * dY);
             }
         }
 
+        Indices.reserve(ySegments * (xSegments + 1) * 2);
         for (int y = 0; y < ySegments; ++y)
         {
             if (!oddRow)
@@ -0,0 +1,71 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorPrimitiveCache.cpp
+ *  Last Change: Automatically updated
+ */
+
+// !!! Warning: Needs to be changed, when implementing Vulkan, because of GLEnum
+// and other OpenGL usage
+
+#include "vantorPrimitiveCache.hpp"
+
+namespace vantor::Graphics::Geometry::Primitives
+{
+    std::map<PrimitiveCache::Key, vantor::Graphics::RenderDevice::OpenGL::Mesh *> PrimitiveCache::m_Meshes
+        = std::map<PrimitiveCache::Key, vantor::Graphics::RenderDevice::OpenGL::Mesh *>();
+    // --------------------------------------------------------------------------------------------
+    template <typename T, typename... Args> T *PrimitiveCache::get(Args... parameters)
+    {
+        static_assert(sizeof...(Args) <= 4, "PrimitiveCache keys hold up to 4 parameters");
+
+        Key          key{std::type_index(typeid(T)), sizeof...(Args), {}};
+        unsigned int slot = 0;
+        ((key.Parameters[slot++] = (float) parameters), ...);
+
+        auto found = m_Meshes.find(key);
+        if (found != m_Meshes.end()) return static_cast<T *>(found->second);
+
+        T *mesh       = new T(parameters...);
+        m_Meshes[key] = mesh;
+        return mesh;
+    }
+    // --------------------------------------------------------------------------------------------
+    Sphere *PrimitiveCache::GetSphere(unsigned int xSegments, unsigned int ySegments) { return get<Sphere>(xSegments, ySegments); }
+    // --------------------------------------------------------------------------------------------
+    Torus *PrimitiveCache::GetTorus(float r1, float r2, unsigned int lod1, unsigned int lod2) { return get<Torus>(r1, r2, lod1, lod2); }
+    // --------------------------------------------------------------------------------------------
+    Cube *PrimitiveCache::GetCube() { return get<Cube>(); }
+    // --------------------------------------------------------------------------------------------
+    Plane *PrimitiveCache::GetPlane(unsigned int xSegments, unsigned int ySegments) { return get<Plane>(xSegments, ySegments); }
+    // --------------------------------------------------------------------------------------------
+    Quad *PrimitiveCache::GetQuad() { return get<Quad>(); }
+    // --------------------------------------------------------------------------------------------
+    Quad *PrimitiveCache::GetQuad(float width, float height) { return get<Quad>(width, height); }
+    // --------------------------------------------------------------------------------------------
+    Circle *PrimitiveCache::GetCircle(unsigned int edgeSegments, unsigned int ringSegments) { return get<Circle>(edgeSegments, ringSegments); }
+    // --------------------------------------------------------------------------------------------
+    LineStrip *PrimitiveCache::GetLineStrip(float width, unsigned int segments) { return get<LineStrip>(width, segments); }
+    // --------------------------------------------------------------------------------------------
+    void PrimitiveCache::Clean()
+    {
+        for (auto it = m_Meshes.begin(); it != m_Meshes.end(); it++)
+        {
+            delete it->second;
+        }
+        m_Meshes.clear();
+    }
+} // namespace vantor::Graphics::Geometry::Primitives
\ No newline at end of file
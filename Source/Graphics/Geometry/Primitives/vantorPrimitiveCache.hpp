@@ -0,0 +1,74 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorPrimitiveCache.hpp
+ *  Last Change: Automatically updated
+ */
+
+// !!! Warning: Needs to be changed, when implementing Vulkan, because of GLEnum
+// and other OpenGL usage
+
+#pragma once
+
+#include "vantorCircle.hpp"
+#include "vantorCube.hpp"
+#include "vantorLine.hpp"
+#include "vantorPlane.hpp"
+#include "vantorQuad.hpp"
+#include "vantorSphere.hpp"
+#include "vantorTorus.hpp"
+
+#include <array>
+#include <map>
+#include <tuple>
+#include <typeindex>
+
+namespace vantor::Graphics::Geometry::Primitives
+{
+    // Shared primitive meshes, keyed by type and parameters: every scene
+    // node asking for a Sphere(16, 16) draws from the same buffers. The
+    // meshes are owned by the cache and live until Clean(); don't delete or
+    // modify them.
+    class PrimitiveCache
+    {
+        private:
+            struct Key
+            {
+                    std::type_index      Type;
+                    unsigned int         Count; // Quad() and Quad(w, h) are different meshes
+                    std::array<float, 4> Parameters;
+
+                    bool operator<(const Key &other) const { return std::tie(Type, Count, Parameters) < std::tie(other.Type, other.Count, other.Parameters); }
+            };
+
+            static std::map<Key, vantor::Graphics::RenderDevice::OpenGL::Mesh *> m_Meshes;
+
+        public:
+            static Sphere    *GetSphere(unsigned int xSegments, unsigned int ySegments);
+            static Torus     *GetTorus(float r1, float r2, unsigned int lod1, unsigned int lod2);
+            static Cube      *GetCube();
+            static Plane     *GetPlane(unsigned int xSegments, unsigned int ySegments);
+            static Quad      *GetQuad();
+            static Quad      *GetQuad(float width, float height);
+            static Circle    *GetCircle(unsigned int edgeSegments, unsigned int ringSegments);
+            static LineStrip *GetLineStrip(float width, unsigned int segments);
+
+            static void Clean();
+
+        private:
+            template <typename T, typename... Args> static T *get(Args... parameters);
+    };
+} // namespace vantor::Graphics::Geometry::Primitives
\ No newline at end of file
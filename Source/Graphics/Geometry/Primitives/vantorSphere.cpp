@@ -32,34 +32,52 @@ namespace vantor::Graphics::Geometry::Primitives
 {
     Sphere::Sphere(unsigned int xSegments, unsigned int ySegments)
     {
+        // u runs around the y axis, v from the top pole down; tangent and
+        // bitangent are dP/du and dP/dv, normalized
+        const unsigned int vertexCount = (xSegments + 1) * (ySegments + 1);
+        Positions.resize(vertexCount);
+        UV.resize(vertexCount);
+        Normals.resize(vertexCount);
+        Tangents.resize(vertexCount);
+        Bitangents.resize(vertexCount);
+
+        unsigned int vertex = 0;
         for (unsigned int y = 0; y <= ySegments; ++y)
         {
-            for (unsigned int x = 0; x <= xSegments; ++x)
+            const float ySegment = static_cast<float>(y) / static_cast<float>(ySegments);
+            const float theta    = ySegment * glm::pi<float>();
+            // exact at the bottom pole too, sin(pi) isn't quite zero
+            const float sinTheta = y == ySegments ? 0.0f : std::sin(theta);
+            const float cosTheta = y == ySegments ? -1.0f : std::cos(theta);
+            for (unsigned int x = 0; x <= xSegments; ++x, ++vertex)
             {
-                float xSegment = static_cast<float>(x) / static_cast<float>(xSegments);
-                float ySegment = static_cast<float>(x) / static_cast<float>(ySegments);
-                float xPos     = std::cos(xSegment * glm::two_pi<float>()) * std::sin(ySegment * glm::pi<float>());
-                float yPos     = std::cos(ySegment * glm::pi<float>());
-                float zPos     = std::sin(xSegment * glm::two_pi<float>()) * std::sin(ySegment * glm::pi<float>());
+                const float xSegment = static_cast<float>(x) / static_cast<float>(xSegments);
+                const float phi      = xSegment * glm::two_pi<float>();
+                const float sinPhi   = std::sin(phi);
+                const float cosPhi   = std::cos(phi);
 
-                Positions.push_back(glm::vec3(xPos, yPos, zPos));
-                UV.push_back(glm::vec2(xSegment, ySegment));
-                Normals.push_back(glm::vec3(xPos, yPos, zPos));
+                const glm::vec3 normal(cosPhi * sinTheta, cosTheta, sinPhi * sinTheta);
+                Positions[vertex]  = normal;
+                UV[vertex]         = glm::vec2(xSegment, ySegment);
+                Normals[vertex]    = normal;
+                Tangents[vertex]   = glm::vec3(-sinPhi, 0.0f, cosPhi);
+                Bitangents[vertex] = glm::vec3(cosPhi * cosTheta, -sinTheta, sinPhi * cosTheta);
             }
         }
 
-        bool oddRow = false;
-        for (int y = 0; y < ySegments; ++y)
+        Indices.resize(xSegments * ySegments * 6);
+        unsigned int index = 0;
+        for (unsigned int y = 0; y < ySegments; ++y)
         {
-            for (int x = 0; x < xSegments; ++x)
+            for (unsigned int x = 0; x < xSegments; ++x)
             {
-                Indices.push_back((y + 1) * (xSegments + 1) + x);
-                Indices.push_back(y * (xSegments + 1) + x);
-                Indices.push_back(y * (xSegments + 1) + x + 1);
+                Indices[index++] = (y + 1) * (xSegments + 1) + x;
+                Indices[index++] = y * (xSegments + 1) + x;
+                Indices[index++] = y * (xSegments + 1) + x + 1;
 
-                Indices.push_back((y + 1) * (xSegments + 1) + x);
-                Indices.push_back(y * (xSegments + 1) + x + 1);
-                Indices.push_back((y + 1) * (xSegments + 1) + x + 1);
+                Indices[index++] = (y + 1) * (xSegments + 1) + x;
+                Indices[index++] = y * (xSegments + 1) + x + 1;
+                Indices[index++] = (y + 1) * (xSegments + 1) + x + 1;
             }
         }
 
@@ -30,6 +30,7 @@ namespace vantor::Graphics::Geometry::Primitives
     class Sphere : public vantor::Graphics::RenderDevice::OpenGL::Mesh
     {
         public:
+            // xSegments around the y axis, ySegments from pole to pole
             Sphere(unsigned int xSegments, unsigned int ySegments);
     };
 } // namespace vantor::Graphics::Geometry::Primitives
\ No newline at end of file
@@ -26,62 +26,57 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp> // for glm::two_pi
 
-#include <vector>
 #include <cmath>
 
 namespace vantor::Graphics::Geometry::Primitives
 {
     Torus::Torus(float r1, float r2, unsigned int numSteps1, unsigned int numSteps2)
     {
-        Positions.resize((numSteps1 + 1) * (numSteps2 + 1));
-        Normals.resize((numSteps1 + 1) * (numSteps2 + 1));
-        UV.resize((numSteps1 + 1) * (numSteps2 + 1));
+        // ring i sits at angle a around the z axis, tube vertex j at angle b
+        // around the ring; tangent and bitangent follow i and j
+        const unsigned int vertexCount = (numSteps1 + 1) * (numSteps2 + 1);
+        Positions.resize(vertexCount);
+        UV.resize(vertexCount);
+        Normals.resize(vertexCount);
+        Tangents.resize(vertexCount);
+        Bitangents.resize(vertexCount);
 
-        std::vector<glm::vec3> p(numSteps1 + 1);
-        float                  a    = 0.0f;
-        float                  step = 2.0f * glm::pi<float>() / numSteps1;
-        for (int i = 0; i <= numSteps1; ++i)
+        const float step1 = glm::two_pi<float>() / numSteps1;
+        const float step2 = glm::two_pi<float>() / numSteps2;
+        for (unsigned int i = 0; i <= numSteps1; ++i)
         {
-            float x = std::cos(a) * r1;
-            float y = std::sin(a) * r1;
-            p[i].x  = x;
-            p[i].y  = y;
-            p[i].z  = 0.0f;
-            a += step;
-        }
-
-        for (int i = 0; i <= numSteps1; ++i)
-        {
-            glm::vec3 u = glm::normalize(glm::vec3(0.0f) - p[i]) * r2;
-            glm::vec3 v = glm::vec3(0.0f, 0.0f, 1.0f) * r2;
+            const glm::vec3 outward(std::cos(i * step1), std::sin(i * step1), 0.0f);
+            const glm::vec3 tangent(-outward.y, outward.x, 0.0f);
+            const glm::vec3 up(0.0f, 0.0f, 1.0f);
+            const glm::vec3 ring = outward * r1;
 
-            float a    = 0.0f;
-            float step = 2.0f * glm::pi<float>() / numSteps2;
-            for (int j = 0; j <= numSteps2; ++j)
+            for (unsigned int j = 0; j <= numSteps2; ++j)
             {
-                float c = std::cos(a);
-                float s = std::sin(a);
+                const float        c      = std::cos(j * step2);
+                const float        s      = std::sin(j * step2);
+                const glm::vec3    normal = s * up - c * outward;
+                const unsigned int vertex = i * (numSteps2 + 1) + j;
 
-                Positions[i * (numSteps2 + 1) + j] = p[i] + c * u + s * v;
-                UV[i * (numSteps2 + 1) + j].x      = ((float) i) / ((float) numSteps1) * glm::two_pi<float>();
-                UV[i * (numSteps2 + 1) + j].y      = ((float) j) / ((float) numSteps2);
-                Normals[i * (numSteps2 + 1) + j]   = glm::normalize(c * u + s * v);
-                a += step;
+                Positions[vertex]  = ring + normal * r2;
+                UV[vertex]         = glm::vec2(((float) i) / ((float) numSteps1) * glm::two_pi<float>(), ((float) j) / ((float) numSteps2));
+                Normals[vertex]    = normal;
+                Tangents[vertex]   = tangent;
+                Bitangents[vertex] = s * outward + c * up;
             }
         }
 
         Indices.resize(numSteps1 * numSteps2 * 6);
 
-        int index = 0;
-        for (int i = 0; i < numSteps1; ++i)
+        unsigned int index = 0;
+        for (unsigned int i = 0; i < numSteps1; ++i)
         {
-            int i1 = i;
-            int i2 = (i1 + 1);
+            unsigned int i1 = i;
+            unsigned int i2 = (i1 + 1);
 
-            for (int j = 0; j < numSteps2; ++j)
+            for (unsigned int j = 0; j < numSteps2; ++j)
             {
-                int j1 = j;
-                int j2 = (j1 + 1);
+                unsigned int j1 = j;
+                unsigned int j2 = (j1 + 1);
 
                 Indices[index++] = i1 * (numSteps2 + 1) + j1;
                 Indices[index++] = i1 * (numSteps2 + 1) + j2;
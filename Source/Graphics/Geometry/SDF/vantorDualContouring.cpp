@@ -0,0 +1,356 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorDualContouring.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorDualContouring.hpp"
+#include "../../../Core/JobSystem/vantorJobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vantor::Graphics::Geometry::SDF
+{
+    namespace
+    {
+        constexpr unsigned int NO_VERTEX = ~0u;
+
+        // eigenvalues below this fraction of the largest are treated as zero
+        // when solving the QEF; keeps near parallel planes from throwing the
+        // vertex far off
+        constexpr float QEF_TRUNCATION = 0.1f;
+
+        // accumulated tangent planes n . (x - p) = 0 of one cell
+        struct QEF
+        {
+                glm::mat3 ATA       = glm::mat3(0.0f);
+                glm::vec3 ATb       = glm::vec3(0.0f);
+                glm::vec3 MassPoint = glm::vec3(0.0f);
+                int       Count     = 0;
+
+                void Add(const glm::vec3 &p, const glm::vec3 &n)
+                {
+                    ATA += glm::outerProduct(n, n);
+                    ATb += n * glm::dot(n, p);
+                    MassPoint += p;
+                    ++Count;
+                }
+
+                // least squares point, solved relative to the mass point
+                // through a truncated pseudo inverse
+                glm::vec3 Solve() const
+                {
+                    glm::vec3 center = MassPoint / (float) Count;
+                    glm::vec3 b      = ATb - ATA * center;
+
+                    // cyclic Jacobi; converges in a handful of sweeps for 3x3
+                    glm::mat3 a = ATA, vectors(1.0f);
+                    for (int sweep = 0; sweep < 6; ++sweep)
+                    {
+                        for (int p = 0; p < 2; ++p)
+                        {
+                            for (int q = p + 1; q < 3; ++q)
+                            {
+                                if (std::abs(a[q][p]) < 1e-12f) continue;
+                                float theta = (a[q][q] - a[p][p]) / (2.0f * a[q][p]);
+                                float t     = (theta >= 0.0f ? 1.0f : -1.0f) / (std::abs(theta) + std::sqrt(theta * theta + 1.0f));
+                                float c     = 1.0f / std::sqrt(t * t + 1.0f);
+
+                                glm::mat3 rotation(1.0f);
+                                rotation[p][p] = c;
+                                rotation[q][q] = c;
+                                rotation[q][p] = t * c;
+                                rotation[p][q] = -t * c;
+                                a              = glm::transpose(rotation) * a * rotation;
+                                vectors        = vectors * rotation;
+                            }
+                        }
+                    }
+
+                    float largest = std::max({a[0][0], a[1][1], a[2][2]});
+                    for (int i = 0; i < 3; ++i)
+                        if (a[i][i] > QEF_TRUNCATION * largest) center += vectors[i] * (glm::dot(vectors[i], b) / a[i][i]);
+                    return center;
+                }
+        };
+
+        struct Block
+        {
+                glm::ivec3                Origin; // first cell
+                glm::ivec3                Size;   // in cells
+                std::vector<float>        Samples;
+                std::vector<unsigned int> CellVertex; // by cell, block local until offset by BaseVertex
+                std::vector<glm::vec3>    Positions;
+                std::vector<glm::vec3>    Normals;
+                std::vector<unsigned int> Indices;
+                unsigned int              BaseVertex = 0;
+
+                float Sample(const glm::ivec3 &corner) const { return Samples[(corner.z * (Size.y + 1) + corner.y) * (Size.x + 1) + corner.x]; }
+                int   Cell(const glm::ivec3 &cell) const { return (cell.z * Size.y + cell.y) * Size.x + cell.x; }
+        };
+
+        struct Grid
+        {
+                const Field     &SdfField;
+                glm::vec3        BoxMin;
+                glm::vec3        CellSize;
+                int              Resolution;
+                bool             LowerSeam;
+                glm::ivec3       Blocks     = glm::ivec3(0); // per axis
+                std::vector<int> BlockIndex = {};            // into the surviving blocks, -1 if skipped
+
+                glm::vec3 Corner(const glm::ivec3 &corner) const { return BoxMin + glm::vec3(corner) * CellSize; }
+        };
+
+        // skips every node that provably doesn't intersect the surface
+        void collectBlocks(Grid &grid, std::vector<Block> &blocks, glm::ivec3 origin, int size)
+        {
+            if (origin.x >= grid.Blocks.x || origin.y >= grid.Blocks.y || origin.z >= grid.Blocks.z) return;
+
+            glm::ivec3 lo     = origin * (int) DualContouring::BLOCK_CELLS;
+            glm::ivec3 hi     = glm::min((origin + size) * (int) DualContouring::BLOCK_CELLS, glm::ivec3(grid.Resolution));
+            glm::vec3  extent = glm::vec3(hi - lo) * grid.CellSize;
+            if (std::abs(grid.SdfField.Evaluate(grid.Corner(lo) + extent * 0.5f)) > glm::length(extent) * 0.5f) return;
+
+            if (size > 1)
+            {
+                int half = size / 2;
+                for (int child = 0; child < 8; ++child)
+                    collectBlocks(grid, blocks, origin + glm::ivec3(child & 1, (child >> 1) & 1, (child >> 2) & 1) * half, half);
+                return;
+            }
+
+            Block block;
+            block.Origin = lo;
+            block.Size   = hi - lo;
+            grid.BlockIndex[(origin.z * grid.Blocks.y + origin.y) * grid.Blocks.x + origin.x] = blocks.size();
+            blocks.push_back(std::move(block));
+        }
+
+        // samples the block and places a vertex in each of its surface cells
+        void placeVertices(const Grid &grid, Block &block)
+        {
+            const glm::ivec3 corners     = block.Size + 1;
+            const int        cornerCount = corners.x * corners.y * corners.z;
+
+            // all corners of the block as one batch
+            std::vector<float> px(cornerCount), py(cornerCount), pz(cornerCount);
+            for (int z = 0, i = 0; z < corners.z; ++z)
+            {
+                for (int y = 0; y < corners.y; ++y)
+                {
+                    for (int x = 0; x < corners.x; ++x, ++i)
+                    {
+                        glm::vec3 p = grid.Corner(block.Origin + glm::ivec3(x, y, z));
+                        px[i]       = p.x;
+                        py[i]       = p.y;
+                        pz[i]       = p.z;
+                    }
+                }
+            }
+            block.Samples.resize(cornerCount);
+            grid.SdfField.Evaluate(px.data(), py.data(), pz.data(), block.Samples.data(), cornerCount);
+
+            // crossing on every sign changing edge, by (corner, axis); shared
+            // by the up to four cells around the edge
+            std::vector<int>       edgeCrossing(cornerCount * 3, -1);
+            std::vector<glm::vec3> points;
+            for (int z = 0, i = 0; z < corners.z; ++z)
+            {
+                for (int y = 0; y < corners.y; ++y)
+                {
+                    for (int x = 0; x < corners.x; ++x, ++i)
+                    {
+                        const glm::ivec3 corner(x, y, z);
+                        for (int axis = 0; axis < 3; ++axis)
+                        {
+                            glm::ivec3 other = corner;
+                            if (++other[axis] >= corners[axis]) continue;
+                            float va = block.Sample(corner), vb = block.Sample(other);
+                            if ((va < 0.0f) == (vb < 0.0f)) continue;
+
+                            edgeCrossing[i * 3 + axis] = points.size();
+                            points.push_back(glm::mix(grid.Corner(block.Origin + corner), grid.Corner(block.Origin + other), va / (va - vb)));
+                        }
+                    }
+                }
+            }
+
+            // surface normals from a tetrahedral gradient, four samples per
+            // crossing instead of six, all in one batch
+            const float     h          = 0.05f * std::min({grid.CellSize.x, grid.CellSize.y, grid.CellSize.z});
+            const glm::vec3 offsets[4] = {glm::vec3(1, -1, -1), glm::vec3(-1, -1, 1), glm::vec3(-1, 1, -1), glm::vec3(1, 1, 1)};
+            const int       taps       = points.size() * 4;
+            px.resize(taps);
+            py.resize(taps);
+            pz.resize(taps);
+            for (int i = 0; i < taps; ++i)
+            {
+                glm::vec3 p = points[i / 4] + offsets[i % 4] * h;
+                px[i]       = p.x;
+                py[i]       = p.y;
+                pz[i]       = p.z;
+            }
+            std::vector<float> tapDistances(taps);
+            grid.SdfField.Evaluate(px.data(), py.data(), pz.data(), tapDistances.data(), taps);
+
+            std::vector<glm::vec3> planeNormals(points.size());
+            for (unsigned int i = 0; i < points.size(); ++i)
+            {
+                glm::vec3 n = offsets[0] * tapDistances[i * 4] + offsets[1] * tapDistances[i * 4 + 1] + offsets[2] * tapDistances[i * 4 + 2] +
+                              offsets[3] * tapDistances[i * 4 + 3];
+                float length    = glm::length(n);
+                planeNormals[i] = length > 0.0f ? n / length : glm::vec3(0.0f);
+            }
+
+            block.CellVertex.assign(block.Size.x * block.Size.y * block.Size.z, NO_VERTEX);
+            for (int z = 0; z < block.Size.z; ++z)
+            {
+                for (int y = 0; y < block.Size.y; ++y)
+                {
+                    for (int x = 0; x < block.Size.x; ++x)
+                    {
+                        // the cell's 12 edges as (corner offset, axis)
+                        QEF       qef;
+                        glm::vec3 normal(0.0f);
+                        for (int axis = 0; axis < 3; ++axis)
+                        {
+                            for (int edge = 0; edge < 4; ++edge)
+                            {
+                                glm::ivec3 corner(x, y, z);
+                                corner[(axis + 1) % 3] += edge & 1;
+                                corner[(axis + 2) % 3] += edge >> 1;
+                                int e = edgeCrossing[((corner.z * corners.y + corner.y) * corners.x + corner.x) * 3 + axis];
+                                if (e < 0) continue;
+                                qef.Add(points[e], planeNormals[e]);
+                                normal += planeNormals[e];
+                            }
+                        }
+                        if (qef.Count == 0) continue;
+
+                        // a vertex outside its cell folds the surface over
+                        glm::vec3 cellMin = grid.Corner(block.Origin + glm::ivec3(x, y, z));
+                        block.Positions.push_back(glm::clamp(qef.Solve(), cellMin, cellMin + grid.CellSize));
+                        float length = glm::length(normal);
+                        block.Normals.push_back(length > 0.0f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f));
+                        block.CellVertex[block.Cell(glm::ivec3(x, y, z))] = block.Positions.size() - 1;
+                    }
+                }
+            }
+        }
+
+        unsigned int cellVertex(const Grid &grid, const std::vector<Block> &blocks, const glm::ivec3 &cell)
+        {
+            glm::ivec3 b     = cell / (int) DualContouring::BLOCK_CELLS;
+            int        index = grid.BlockIndex[(b.z * grid.Blocks.y + b.y) * grid.Blocks.x + b.x];
+            if (index < 0) return NO_VERTEX;
+            const Block &block  = blocks[index];
+            unsigned int vertex = block.CellVertex[block.Cell(cell - block.Origin)];
+            return vertex == NO_VERTEX ? NO_VERTEX : block.BaseVertex + vertex;
+        }
+
+        // one quad around every sign changing edge whose lower corner is a
+        // cell of this block; the other three cells may live in neighbours
+        void connectCells(const Grid &grid, const std::vector<Block> &blocks, Block &block, const std::vector<glm::vec3> &positions)
+        {
+            for (int z = 0; z < block.Size.z; ++z)
+            {
+                for (int y = 0; y < block.Size.y; ++y)
+                {
+                    for (int x = 0; x < block.Size.x; ++x)
+                    {
+                        const glm::ivec3 corner(x, y, z);
+                        const glm::ivec3 cell = block.Origin + corner;
+                        for (int axis = 0; axis < 3; ++axis)
+                        {
+                            const int u = (axis + 1) % 3, v = (axis + 2) % 3;
+                            if (cell[u] == 0 || cell[v] == 0 || (grid.LowerSeam && cell[axis] == 0)) continue;
+
+                            glm::ivec3 other = corner;
+                            ++other[axis];
+                            bool inside = block.Sample(corner) < 0.0f;
+                            if (inside == (block.Sample(other) < 0.0f)) continue;
+
+                            glm::ivec3 du(0), dv(0);
+                            du[u] = 1;
+                            dv[v] = 1;
+                            unsigned int quad[4] = {cellVertex(grid, blocks, cell), cellVertex(grid, blocks, cell - du), cellVertex(grid, blocks, cell - du - dv),
+                                                    cellVertex(grid, blocks, cell - dv)};
+                            // only if the field overestimates distances somewhere
+                            if (quad[0] == NO_VERTEX || quad[1] == NO_VERTEX || quad[2] == NO_VERTEX || quad[3] == NO_VERTEX) continue;
+                            if (!inside) std::swap(quad[1], quad[3]);
+
+                            // split along the shorter diagonal
+                            if (glm::distance(positions[quad[0]], positions[quad[2]]) <= glm::distance(positions[quad[1]], positions[quad[3]]))
+                                block.Indices.insert(block.Indices.end(), {quad[0], quad[1], quad[2], quad[0], quad[2], quad[3]});
+                            else
+                                block.Indices.insert(block.Indices.end(), {quad[1], quad[2], quad[3], quad[1], quad[3], quad[0]});
+                        }
+                    }
+                }
+            }
+        }
+    } // namespace
+
+    // --------------------------------------------------------------------------------------------
+    void DualContouring::Polygonize(const Field                &field,
+                                    glm::vec3                  boxMin,
+                                    glm::vec3                  boxMax,
+                                    unsigned int               resolution,
+                                    std::vector<glm::vec3>    &positions,
+                                    std::vector<glm::vec3>    &normals,
+                                    std::vector<unsigned int> &indices,
+                                    bool                       lowerSeam)
+    {
+        positions.clear();
+        normals.clear();
+        indices.clear();
+        if (resolution == 0) return;
+
+        Grid grid{field, boxMin, (boxMax - boxMin) / (float) resolution, (int) resolution, lowerSeam};
+        grid.Blocks = glm::ivec3((resolution + BLOCK_CELLS - 1) / BLOCK_CELLS);
+        grid.BlockIndex.assign(grid.Blocks.x * grid.Blocks.y * grid.Blocks.z, -1);
+
+        int rootSize = 1;
+        while (rootSize < grid.Blocks.x)
+            rootSize *= 2;
+        std::vector<Block> blocks;
+        collectBlocks(grid, blocks, glm::ivec3(0), rootSize);
+
+        vantor::Core::JobSystem::ParallelFor(blocks.size(), [&](uint32_t b) { placeVertices(grid, blocks[b]); });
+
+        unsigned int vertexCount = 0;
+        for (Block &block : blocks)
+        {
+            block.BaseVertex = vertexCount;
+            vertexCount += block.Positions.size();
+        }
+        positions.reserve(vertexCount);
+        normals.reserve(vertexCount);
+        for (Block &block : blocks)
+        {
+            positions.insert(positions.end(), block.Positions.begin(), block.Positions.end());
+            normals.insert(normals.end(), block.Normals.begin(), block.Normals.end());
+        }
+
+        vantor::Core::JobSystem::ParallelFor(blocks.size(), [&](uint32_t b) { connectCells(grid, blocks, blocks[b], positions); });
+
+        for (const Block &block : blocks)
+            indices.insert(indices.end(), block.Indices.begin(), block.Indices.end());
+    }
+} // namespace vantor::Graphics::Geometry::SDF
@@ -0,0 +1,61 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorDualContouring.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include "vantorField.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace vantor::Graphics::Geometry::SDF
+{
+    // Dual contouring: one vertex per surface cell, placed by minimizing the
+    // distance to the tangent planes at the cell's edge crossings (a QEF), so
+    // edges and corners of CSG shapes stay sharp at low resolutions. Flat
+    // cells have no unique minimum and fall back to the crossings' mass
+    // point, which is what surface nets would place.
+    //
+    // The grid is walked as an octree of BLOCK_CELLS^3 blocks; a node whose
+    // center lies further from the surface than its half diagonal can hold
+    // no surface and is skipped without sampling. This relies on the field
+    // never overestimating the distance, which holds for exact distances and
+    // for min/max based CSG. Surviving blocks are meshed in parallel on the
+    // job system.
+    class DualContouring
+    {
+        public:
+            static constexpr unsigned int BLOCK_CELLS = 8;
+
+            // same contract as MarchingCubes::Polygonize. With lowerSeam the
+            // first cell layer along each axis is taken to overlap the grid
+            // below: it gets vertices but no faces of its own, so neighbouring
+            // grids meshed this way join without gaps or duplicate faces.
+            static void Polygonize(const Field                &field,
+                                   glm::vec3                  boxMin,
+                                   glm::vec3                  boxMax,
+                                   unsigned int               resolution,
+                                   std::vector<glm::vec3>    &positions,
+                                   std::vector<glm::vec3>    &normals,
+                                   std::vector<unsigned int> &indices,
+                                   bool                       lowerSeam = false);
+    };
+} // namespace vantor::Graphics::Geometry::SDF
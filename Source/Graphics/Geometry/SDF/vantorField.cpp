@@ -0,0 +1,195 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorField.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorField.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// The loops below are written to be auto-vectorized: branch free bodies,
+// ternaries that map onto single min/max/blend instructions and no calls
+// besides sqrt and abs. They only vectorize with the flags this file gets
+// in CMakeLists.txt.
+
+namespace vantor::Graphics::Geometry::SDF
+{
+    namespace
+    {
+        inline float minf(float a, float b) { return a < b ? a : b; }
+        inline float maxf(float a, float b) { return a > b ? a : b; }
+        // std::floor needs SSE4.1 to vectorize; this doesn't, valid within int range
+        inline float floorFast(float a)
+        {
+            float truncated = (float) (int) a;
+            return truncated > a ? truncated - 1.0f : truncated;
+        }
+    } // namespace
+
+    // --------------------------------------------------------------------------------------------
+    void Field::Evaluate(const float *x, const float *y, const float *z, float *distances, unsigned int count) const
+    {
+        for (unsigned int first = 0; first < count; first += BATCH)
+            EvaluateBatch(x + first, y + first, z + first, distances + first, std::min(BATCH, count - first));
+    }
+    // --------------------------------------------------------------------------------------------
+    float Field::Evaluate(const glm::vec3 &p) const
+    {
+        float distance;
+        EvaluateBatch(&p.x, &p.y, &p.z, &distance, 1);
+        return distance;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Function::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                                 unsigned int count) const
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            distances[i] = m_Function(glm::vec3(x[i], y[i], z[i]));
+    }
+    // --------------------------------------------------------------------------------------------
+    void Sphere::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const
+    {
+        const float radius = m_Radius;
+        for (unsigned int i = 0; i < count; ++i)
+            distances[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]) - radius;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Box::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                            unsigned int count) const
+    {
+        const float hx = m_HalfExtents.x, hy = m_HalfExtents.y, hz = m_HalfExtents.z;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            float qx = std::abs(x[i]) - hx, qy = std::abs(y[i]) - hy, qz = std::abs(z[i]) - hz;
+            float ox = maxf(qx, 0.0f), oy = maxf(qy, 0.0f), oz = maxf(qz, 0.0f);
+            distances[i] = std::sqrt(ox * ox + oy * oy + oz * oz) + minf(maxf(qx, maxf(qy, qz)), 0.0f);
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    void Torus::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                              unsigned int count) const
+    {
+        const float radius = m_Radius, tubeRadius = m_TubeRadius;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            float ring   = std::sqrt(x[i] * x[i] + z[i] * z[i]) - radius;
+            distances[i] = std::sqrt(ring * ring + y[i] * y[i]) - tubeRadius;
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    void Plane::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                              unsigned int count) const
+    {
+        const float nx = m_Normal.x, ny = m_Normal.y, nz = m_Normal.z, offset = m_Offset;
+        for (unsigned int i = 0; i < count; ++i)
+            distances[i] = nx * x[i] + ny * y[i] + nz * z[i] - offset;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Union::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                              unsigned int count) const
+    {
+        float b[BATCH];
+        m_A->EvaluateBatch(x, y, z, distances, count);
+        m_B->EvaluateBatch(x, y, z, b, count);
+        for (unsigned int i = 0; i < count; ++i)
+            distances[i] = minf(distances[i], b[i]);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Intersection::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                                     unsigned int count) const
+    {
+        float b[BATCH];
+        m_A->EvaluateBatch(x, y, z, distances, count);
+        m_B->EvaluateBatch(x, y, z, b, count);
+        for (unsigned int i = 0; i < count; ++i)
+            distances[i] = maxf(distances[i], b[i]);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Subtraction::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                                    unsigned int count) const
+    {
+        float b[BATCH];
+        m_A->EvaluateBatch(x, y, z, distances, count);
+        m_B->EvaluateBatch(x, y, z, b, count);
+        for (unsigned int i = 0; i < count; ++i)
+            distances[i] = maxf(distances[i], -b[i]);
+    }
+    // --------------------------------------------------------------------------------------------
+    void SmoothUnion::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                                    unsigned int count) const
+    {
+        float b[BATCH];
+        m_A->EvaluateBatch(x, y, z, distances, count);
+        m_B->EvaluateBatch(x, y, z, b, count);
+
+        const float k = m_K, inverseK = 1.0f / m_K;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            float a      = distances[i];
+            float h      = minf(maxf(0.5f + 0.5f * (b[i] - a) * inverseK, 0.0f), 1.0f);
+            distances[i] = b[i] + (a - b[i]) * h - k * h * (1.0f - h);
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    void Repeat::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const
+    {
+        float        local[3][BATCH];
+        const float *source[3] = {x, y, z};
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float *in     = source[axis];
+            float       *out    = local[axis];
+            const float  period = m_Period[axis];
+            if (period <= 0.0f)
+            {
+                std::copy(in, in + count, out);
+                continue;
+            }
+            const float inversePeriod = 1.0f / period;
+            for (unsigned int i = 0; i < count; ++i)
+                out[i] = in[i] - period * floorFast(in[i] * inversePeriod + 0.5f);
+        }
+        m_Field->EvaluateBatch(local[0], local[1], local[2], distances, count);
+    }
+    // --------------------------------------------------------------------------------------------
+    Transform::Transform(FieldRef field, const glm::mat4 &transform) : m_Field(std::move(field)), m_Inverse(glm::inverse(transform))
+    {
+        m_Scale = glm::length(glm::vec3(transform[0]));
+    }
+    // --------------------------------------------------------------------------------------------
+    void Transform::EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                                  unsigned int count) const
+    {
+        float       lx[BATCH], ly[BATCH], lz[BATCH];
+        const auto &m = m_Inverse;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            lx[i] = m[0][0] * x[i] + m[1][0] * y[i] + m[2][0] * z[i] + m[3][0];
+            ly[i] = m[0][1] * x[i] + m[1][1] * y[i] + m[2][1] * z[i] + m[3][1];
+            lz[i] = m[0][2] * x[i] + m[1][2] * y[i] + m[2][2] * z[i] + m[3][2];
+        }
+        m_Field->EvaluateBatch(lx, ly, lz, distances, count);
+
+        const float scale = m_Scale;
+        for (unsigned int i = 0; i < count; ++i)
+            distances[i] *= scale;
+    }
+} // namespace vantor::Graphics::Geometry::SDF
@@ -0,0 +1,212 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorField.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <functional>
+#include <memory>
+
+namespace vantor::Graphics::Geometry::SDF
+{
+    // A signed distance field (negative inside) evaluated over batches of
+    // points given as separate x, y and z arrays. Every node handles up to
+    // BATCH points per virtual call in plain loops over restrict qualified
+    // arrays, which the compiler turns into SSE/AVX or NEON code for the
+    // target; there are no intrinsics, so the same source serves every
+    // platform. Composite nodes keep their temporaries on the stack.
+    //
+    // Fields are immutable once built and may be shared between trees and
+    // evaluated from any number of threads.
+    class Field
+    {
+        public:
+            static constexpr unsigned int BATCH = 256;
+
+            virtual ~Field() = default;
+
+            // any number of points, split into batches
+            void  Evaluate(const float *x, const float *y, const float *z, float *distances, unsigned int count) const;
+            float Evaluate(const glm::vec3 &p) const;
+
+            // at most BATCH points; the arrays must not overlap
+            virtual void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                                       unsigned int count) const = 0;
+    };
+
+    using FieldRef = std::shared_ptr<const Field>;
+
+    // ==== Adapter ====
+    // Wraps a per point function; one indirect call per point, so prefer
+    // composing the primitives below where speed matters.
+    class Function : public Field
+    {
+        public:
+            Function(std::function<float(glm::vec3)> function) : m_Function(std::move(function)) {}
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            std::function<float(glm::vec3)> m_Function;
+    };
+
+    // ==== Primitives ====
+    // Centered at the origin; place them with Transform.
+    class Sphere : public Field
+    {
+        public:
+            Sphere(float radius) : m_Radius(radius) {}
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            float m_Radius;
+    };
+
+    class Box : public Field
+    {
+        public:
+            Box(glm::vec3 halfExtents) : m_HalfExtents(halfExtents) {}
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            glm::vec3 m_HalfExtents;
+    };
+
+    // ring in the xz plane
+    class Torus : public Field
+    {
+        public:
+            Torus(float radius, float tubeRadius) : m_Radius(radius), m_TubeRadius(tubeRadius) {}
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            float m_Radius;
+            float m_TubeRadius;
+    };
+
+    // half space below dot(normal, p) = offset; normal must be unit length
+    class Plane : public Field
+    {
+        public:
+            Plane(glm::vec3 normal, float offset) : m_Normal(normal), m_Offset(offset) {}
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            glm::vec3 m_Normal;
+            float     m_Offset;
+    };
+
+    // ==== Operators ====
+    class Union : public Field
+    {
+        public:
+            Union(FieldRef a, FieldRef b) : m_A(std::move(a)), m_B(std::move(b)) {}
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            FieldRef m_A;
+            FieldRef m_B;
+    };
+
+    class Intersection : public Field
+    {
+        public:
+            Intersection(FieldRef a, FieldRef b) : m_A(std::move(a)), m_B(std::move(b)) {}
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            FieldRef m_A;
+            FieldRef m_B;
+    };
+
+    // a with b carved out
+    class Subtraction : public Field
+    {
+        public:
+            Subtraction(FieldRef a, FieldRef b) : m_A(std::move(a)), m_B(std::move(b)) {}
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            FieldRef m_A;
+            FieldRef m_B;
+    };
+
+    // union blending over a band of width k (polynomial smooth minimum)
+    class SmoothUnion : public Field
+    {
+        public:
+            SmoothUnion(FieldRef a, FieldRef b, float k) : m_A(std::move(a)), m_B(std::move(b)), m_K(k) {}
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            FieldRef m_A;
+            FieldRef m_B;
+            float    m_K;
+    };
+
+    // infinite repetition with the given period per axis, 0 to not repeat
+    // along an axis; the field should fit inside one period
+    class Repeat : public Field
+    {
+        public:
+            Repeat(FieldRef field, glm::vec3 period) : m_Field(std::move(field)), m_Period(period) {}
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            FieldRef  m_Field;
+            glm::vec3 m_Period;
+    };
+
+    // places field with transform; distances stay exact for rotations,
+    // translations and uniform scales
+    class Transform : public Field
+    {
+        public:
+            Transform(FieldRef field, const glm::mat4 &transform);
+
+            void EvaluateBatch(const float *__restrict x, const float *__restrict y, const float *__restrict z, float *__restrict distances,
+                               unsigned int count) const override;
+
+        private:
+            FieldRef  m_Field;
+            glm::mat4 m_Inverse;
+            float     m_Scale;
+    };
+} // namespace vantor::Graphics::Geometry::SDF
@@ -0,0 +1,54 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMarchingCubes.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include "vantorField.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace vantor::Graphics::Geometry::SDF
+{
+    // Welded, indexed marching cubes. The grid is split into slabs of
+    // CHUNK_SLABS cells along z, polygonized in parallel on the job system;
+    // every slab samples the field once per grid corner, and vertices on
+    // shared cell edges are reused through a rolling two layer edge cache.
+    // Normals come from the field's gradient, not from the triangles; it is
+    // sampled one corner past the grid, so grids meeting at a face (Volume
+    // chunks) get the same normals along it.
+    class MarchingCubes
+    {
+        public:
+            static constexpr unsigned int CHUNK_SLABS = 16;
+
+            // polygonizes the zero level set of field over a
+            // grid of resolution^3 cells spanning [boxMin, boxMax]; the outputs
+            // are overwritten.
+            static void Polygonize(const Field                &field,
+                                   glm::vec3                  boxMin,
+                                   glm::vec3                  boxMax,
+                                   unsigned int               resolution,
+                                   std::vector<glm::vec3>    &positions,
+                                   std::vector<glm::vec3>    &normals,
+                                   std::vector<unsigned int> &indices);
+    };
+} // namespace vantor::Graphics::Geometry::SDF
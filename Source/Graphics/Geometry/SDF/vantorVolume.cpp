@@ -0,0 +1,168 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorVolume.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorVolume.hpp"
+#include "vantorDualContouring.hpp"
+#include "vantorMarchingCubes.hpp"
+#include "../vantorTangentSpace.hpp"
+#include "../../../Core/JobSystem/vantorJobSystem.h"
+
+namespace vantor::Graphics::Geometry::SDF
+{
+    using vantor::Graphics::RenderDevice::OpenGL::DynamicMesh;
+    using vantor::Graphics::RenderDevice::OpenGL::Mesh;
+    using vantor::Graphics::RenderDevice::OpenGL::SDF_DUAL_CONTOURING;
+    using vantor::Graphics::RenderDevice::OpenGL::SDF_MESHER;
+
+    // --------------------------------------------------------------------------------------------
+    Volume::Volume(FieldRef field, glm::vec3 boxMin, glm::vec3 boxMax, glm::ivec3 chunks, unsigned int chunkResolution, SDF_MESHER mesher)
+        : m_Field(std::move(field)), m_BoxMin(boxMin), m_ChunkCounts(chunks), m_ChunkResolution(chunkResolution), m_Mesher(mesher)
+    {
+        m_CellSize = (boxMax - boxMin) / glm::vec3(chunks * (int) chunkResolution);
+        m_Chunks.resize(chunks.x * chunks.y * chunks.z);
+    }
+    // --------------------------------------------------------------------------------------------
+    Volume::~Volume()
+    {
+        // running jobs only touch their own Job, which they keep alive
+        for (Chunk &chunk : m_Chunks)
+            delete chunk.ChunkMesh;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Volume::SetField(FieldRef field, glm::vec3 editMin, glm::vec3 editMax)
+    {
+        m_Field = std::move(field);
+
+        // a chunk also reads the cell layer around it: gradients in marching
+        // cubes, the overlap with the lower neighbour in dual contouring
+        const glm::vec3  chunkSize = m_CellSize * (float) m_ChunkResolution;
+        const glm::ivec3 first     = glm::max(glm::ivec3(glm::floor((editMin - m_CellSize - m_BoxMin) / chunkSize)), glm::ivec3(0));
+        const glm::ivec3 last      = glm::min(glm::ivec3(glm::floor((editMax + m_CellSize - m_BoxMin) / chunkSize)), m_ChunkCounts - 1);
+        for (int z = first.z; z <= last.z; ++z)
+            for (int y = first.y; y <= last.y; ++y)
+                for (int x = first.x; x <= last.x; ++x)
+                    m_Chunks[(z * m_ChunkCounts.y + y) * m_ChunkCounts.x + x].Dirty = true;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Volume::SetField(FieldRef field)
+    {
+        m_Field = std::move(field);
+        for (Chunk &chunk : m_Chunks)
+            chunk.Dirty = true;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Volume::Update(unsigned int maxUploads)
+    {
+        unsigned int uploads = 0;
+        for (unsigned int i = 0; i < m_Chunks.size(); ++i)
+        {
+            Chunk &chunk = m_Chunks[i];
+            if (chunk.Pending && chunk.Pending->Done.load(std::memory_order_acquire) && uploads < maxUploads)
+            {
+                applyJob(chunk);
+                ++uploads;
+            }
+            // chunks edited while being meshed go again once their job is
+            // in; the result in between is still closer than the old one
+            if (chunk.Dirty && !chunk.Pending && m_JobsInFlight < MAX_JOBS) startJob(i);
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    bool Volume::IsBusy() const
+    {
+        for (const Chunk &chunk : m_Chunks)
+            if (chunk.Dirty || chunk.Pending) return true;
+        return false;
+    }
+    // --------------------------------------------------------------------------------------------
+    Mesh *Volume::GetChunkMesh(unsigned int chunk) const
+    {
+        Mesh *mesh = m_Chunks[chunk].ChunkMesh;
+        return mesh && !mesh->Indices.empty() ? mesh : nullptr;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Volume::startJob(unsigned int index)
+    {
+        Chunk &chunk  = m_Chunks[index];
+        chunk.Dirty   = false;
+        chunk.Pending = std::make_shared<Job>();
+        ++m_JobsInFlight;
+
+        const glm::ivec3 coords(index % m_ChunkCounts.x, (index / m_ChunkCounts.x) % m_ChunkCounts.y, index / (m_ChunkCounts.x * m_ChunkCounts.y));
+        const glm::ivec3 firstCell = coords * (int) m_ChunkResolution;
+
+        // dual contouring chunks reach one cell into their lower neighbours
+        // to connect to them, marching cubes chunks just share the border
+        const bool   dual       = m_Mesher == SDF_DUAL_CONTOURING;
+        glm::vec3    boxMin     = m_BoxMin + glm::vec3(firstCell - (dual ? 1 : 0)) * m_CellSize;
+        glm::vec3    boxMax     = m_BoxMin + glm::vec3(firstCell + (int) m_ChunkResolution) * m_CellSize;
+        unsigned int resolution = m_ChunkResolution + (dual ? 1 : 0);
+
+        // the job holds on to the field it meshes, edits may replace it meanwhile
+        FieldRef             field = m_Field;
+        std::shared_ptr<Job> job   = chunk.Pending;
+        vantor::Core::JobSystem::Execute(
+            [field, job, boxMin, boxMax, resolution, dual]()
+            {
+                if (dual)
+                    DualContouring::Polygonize(*field, boxMin, boxMax, resolution, job->Positions, job->Normals, job->Indices, true);
+                else
+                    MarchingCubes::Polygonize(*field, boxMin, boxMax, resolution, job->Positions, job->Normals, job->Indices);
+
+                // same mapping as Mesh::FromSDF
+                job->UV.resize(job->Positions.size());
+                for (unsigned int i = 0; i < job->Positions.size(); ++i)
+                    job->UV[i] = xy(job->Positions[i]);
+                TangentSpace::CalculateTangents(job->Positions, job->Normals, job->UV, job->Indices, job->Tangents, job->Bitangents);
+
+                job->Done.store(true, std::memory_order_release);
+            });
+    }
+    // --------------------------------------------------------------------------------------------
+    void Volume::applyJob(Chunk &chunk)
+    {
+        std::shared_ptr<Job> job = std::move(chunk.Pending);
+        --m_JobsInFlight;
+
+        if (!chunk.ChunkMesh)
+        {
+            if (job->Indices.empty()) return;
+            chunk.ChunkMesh = new DynamicMesh();
+        }
+
+        DynamicMesh *mesh = chunk.ChunkMesh;
+        mesh->Positions   = std::move(job->Positions);
+        mesh->Normals     = std::move(job->Normals);
+        mesh->UV          = std::move(job->UV);
+        mesh->Tangents    = std::move(job->Tangents);
+        mesh->Bitangents  = std::move(job->Bitangents);
+        mesh->Indices     = std::move(job->Indices);
+        mesh->LODs.clear();
+        mesh->Meshlets.clear();
+        mesh->Topology = vantor::Graphics::RenderDevice::OpenGL::TRIANGLES;
+        // GetChunkMesh() hides chunks without a surface; their buffers stay
+        // as they are for when it comes back
+        if (mesh->Indices.empty()) return;
+        // written into the next of the mesh's buffer sets, which only grow
+        // when the chunk's surface does
+        mesh->Invalidate();
+        mesh->Commit();
+    }
+} // namespace vantor::Graphics::Geometry::SDF
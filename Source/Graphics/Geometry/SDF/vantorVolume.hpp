@@ -0,0 +1,108 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorVolume.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include "vantorField.hpp"
+#include "../../RenderDevice/DeviceOpenGL/vantorOpenGLDynamicMesh.hpp"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace vantor::Graphics::Geometry::SDF
+{
+    // An editable SDF object, meshed as a grid of chunks with one Mesh each.
+    // Edits swap in a new field and mark the chunks they touch dirty; Update()
+    // remeshes those on the job system and hands finished chunks to their
+    // meshes, so an edit costs a few chunks instead of the whole volume and
+    // never stalls the frame. Chunk meshes are DynamicMeshes: remeshing
+    // writes into their existing buffers rather than reallocating them. Chunks share the global sample grid, so their
+    // borders line up exactly and the surface stays closed across them.
+    //
+    // Everything but the meshing itself runs on the main thread.
+    class Volume
+    {
+        public:
+            // chunks meshed at once; further dirty chunks wait for a free slot
+            static constexpr unsigned int MAX_JOBS = 16;
+
+            // chunks.x * chunks.y * chunks.z chunks of chunkResolution^3 cells
+            // spanning [boxMin, boxMax]; every chunk starts out dirty.
+            Volume(FieldRef                                           field,
+                   glm::vec3                                          boxMin,
+                   glm::vec3                                          boxMax,
+                   glm::ivec3                                         chunks,
+                   unsigned int                                       chunkResolution,
+                   vantor::Graphics::RenderDevice::OpenGL::SDF_MESHER mesher = vantor::Graphics::RenderDevice::OpenGL::SDF_MARCHING_CUBES);
+            ~Volume();
+
+            // replaces the field after an edit confined to [editMin, editMax];
+            // only chunks reaching into that box are remeshed.
+            void SetField(FieldRef field, glm::vec3 editMin, glm::vec3 editMax);
+            // replaces the field and remeshes everything
+            void SetField(FieldRef field);
+
+            // once per frame: swaps at most maxUploads finished chunks into
+            // their meshes (uploading them) and starts jobs for dirty chunks.
+            void Update(unsigned int maxUploads = 4);
+
+            // true while chunks are dirty or being meshed
+            bool IsBusy() const;
+
+            unsigned int GetChunkCount() const { return m_Chunks.size(); }
+            // null while the chunk has not been meshed yet or holds no surface
+            vantor::Graphics::RenderDevice::OpenGL::Mesh *GetChunkMesh(unsigned int chunk) const;
+
+        private:
+            // output of one meshing job, published through Done
+            struct Job
+            {
+                    std::atomic<bool>         Done{false};
+                    std::vector<glm::vec3>    Positions;
+                    std::vector<glm::vec3>    Normals;
+                    std::vector<glm::vec2>    UV;
+                    std::vector<glm::vec3>    Tangents;
+                    std::vector<glm::vec3>    Bitangents;
+                    std::vector<unsigned int> Indices;
+            };
+
+            struct Chunk
+            {
+                    vantor::Graphics::RenderDevice::OpenGL::DynamicMesh *ChunkMesh = nullptr;
+                    bool                                                 Dirty     = true;
+                    std::shared_ptr<Job>                                 Pending;
+            };
+
+            FieldRef                                           m_Field;
+            glm::vec3                                          m_BoxMin;
+            glm::vec3                                          m_CellSize;
+            glm::ivec3                                         m_ChunkCounts;
+            unsigned int                                       m_ChunkResolution;
+            vantor::Graphics::RenderDevice::OpenGL::SDF_MESHER m_Mesher;
+            std::vector<Chunk>                                 m_Chunks;
+            unsigned int                                       m_JobsInFlight = 0;
+
+            void startJob(unsigned int chunk);
+            void applyJob(Chunk &chunk);
+    };
+} // namespace vantor::Graphics::Geometry::SDF
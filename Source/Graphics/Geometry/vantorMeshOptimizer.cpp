@@ -0,0 +1,373 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMeshOptimizer.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorMeshOptimizer.hpp"
+#include "../RenderDevice/DeviceOpenGL/vantorOpenGLMesh.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace vantor::Graphics::Geometry
+{
+    namespace
+    {
+        // FIFO post-transform cache over vertex timestamps: a vertex is cached
+        // if it was inserted less than Size insertions ago. Reset() is O(1).
+        struct CacheSimulation
+        {
+                std::vector<unsigned int> Time;
+                unsigned int              Size;
+                unsigned int              Clock;
+
+                CacheSimulation(unsigned int vertexCount, unsigned int size) : Time(vertexCount, 0), Size(size), Clock(size + 1) {}
+
+                // returns 1 on a miss
+                unsigned int Access(unsigned int vertex)
+                {
+                    if (Clock - Time[vertex] <= Size) return 0;
+                    Time[vertex] = Clock++;
+                    return 1;
+                }
+                unsigned int Access(const unsigned int *triangle) { return Access(triangle[0]) + Access(triangle[1]) + Access(triangle[2]); }
+
+                void Reset() { Clock += Size + 1; }
+        };
+
+        // FNV-1a over a vertex's bytes in all streams
+        uint32_t hashVertex(const std::vector<VertexStream> &streams, unsigned int vertex)
+        {
+            uint32_t hash = 2166136261u;
+            for (const VertexStream &stream : streams)
+            {
+                const unsigned char *bytes = (const unsigned char *) stream.Data + vertex * stream.Stride;
+                for (size_t b = 0; b < stream.Stride; ++b)
+                    hash = (hash ^ bytes[b]) * 16777619u;
+            }
+            return hash;
+        }
+
+        bool equalVertices(const std::vector<VertexStream> &streams, unsigned int a, unsigned int b)
+        {
+            for (const VertexStream &stream : streams)
+            {
+                const unsigned char *data = (const unsigned char *) stream.Data;
+                if (std::memcmp(data + a * stream.Stride, data + b * stream.Stride, stream.Stride) != 0) return false;
+            }
+            return true;
+        }
+    } // namespace
+
+    // --------------------------------------------------------------------------------------------
+    void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int> &indices, unsigned int vertexCount, unsigned int cacheSize)
+    {
+        const unsigned int triangleCount = indices.size() / 3;
+        if (triangleCount == 0) return;
+
+        // vertex -> triangles adjacency, flattened
+        std::vector<unsigned int> live(vertexCount, 0);
+        for (unsigned int index : indices)
+            live[index]++;
+        std::vector<unsigned int> offsets(vertexCount + 1, 0);
+        for (unsigned int v = 0; v < vertexCount; ++v)
+            offsets[v + 1] = offsets[v] + live[v];
+        std::vector<unsigned int> adjacency(indices.size());
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (unsigned int t = 0; t < triangleCount; ++t)
+            for (unsigned int k = 0; k < 3; ++k)
+                adjacency[fill[indices[t * 3 + k]]++] = t;
+
+        std::vector<unsigned int> cacheTime(vertexCount, 0);
+        std::vector<bool>         emitted(triangleCount, false);
+        std::vector<unsigned int> deadEnds;
+        std::vector<unsigned int> candidates;
+        std::vector<unsigned int> result;
+        result.reserve(indices.size());
+
+        unsigned int clock  = cacheSize + 1;
+        unsigned int cursor = 0;
+        int          fan    = 0;
+        while (fan >= 0)
+        {
+            // emit every remaining triangle around the fanning vertex
+            candidates.clear();
+            for (unsigned int a = offsets[fan]; a < offsets[fan + 1]; ++a)
+            {
+                unsigned int t = adjacency[a];
+                if (emitted[t]) continue;
+                emitted[t] = true;
+
+                for (unsigned int k = 0; k < 3; ++k)
+                {
+                    unsigned int v = indices[t * 3 + k];
+                    result.push_back(v);
+                    deadEnds.push_back(v);
+                    candidates.push_back(v);
+                    live[v]--;
+                    if (clock - cacheTime[v] > cacheSize) cacheTime[v] = clock++;
+                }
+            }
+
+            // next fan: the candidate that stays in the cache the longest
+            // while its remaining triangles are emitted
+            fan          = -1;
+            int priority = -1;
+            for (unsigned int v : candidates)
+            {
+                if (live[v] == 0) continue;
+                int p = 0;
+                if (clock - cacheTime[v] + 2 * live[v] <= cacheSize) p = clock - cacheTime[v];
+                if (p > priority)
+                {
+                    priority = p;
+                    fan      = v;
+                }
+            }
+            if (fan >= 0) continue;
+
+            // dead end: most recently used vertex with triangles left, then
+            // any vertex with triangles left in input order
+            while (!deadEnds.empty() && fan < 0)
+            {
+                unsigned int v = deadEnds.back();
+                deadEnds.pop_back();
+                if (live[v] > 0) fan = v;
+            }
+            while (fan < 0 && cursor < vertexCount)
+            {
+                if (live[cursor] > 0) fan = cursor;
+                ++cursor;
+            }
+        }
+        indices.swap(result);
+    }
+    // --------------------------------------------------------------------------------------------
+    void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int> &indices, const std::vector<glm::vec3> &positions, float threshold, unsigned int cacheSize)
+    {
+        const unsigned int triangleCount = indices.size() / 3;
+        if (triangleCount == 0) return;
+
+        CacheSimulation cache(positions.size(), cacheSize);
+
+        // hard boundaries: triangles missing with all three vertices, i.e.
+        // where the cache optimized order starts over anyway
+        std::vector<unsigned int> hard;
+        for (unsigned int t = 0; t < triangleCount; ++t)
+        {
+            if (cache.Access(&indices[t * 3]) == 3 || t == 0) hard.push_back(t);
+        }
+        hard.push_back(triangleCount);
+
+        // soft boundaries: split hard clusters further, wherever the part so
+        // far (from a cold cache) stays within threshold of the whole
+        // cluster's ACMR; clusters are drawn in any order later.
+        std::vector<unsigned int> clusters;
+        for (unsigned int h = 0; h + 1 < hard.size(); ++h)
+        {
+            const unsigned int begin = hard[h], end = hard[h + 1];
+
+            cache.Reset();
+            unsigned int misses = 0;
+            for (unsigned int t = begin; t < end; ++t)
+                misses += cache.Access(&indices[t * 3]);
+            const float limit = threshold * misses / (end - begin);
+
+            cache.Reset();
+            unsigned int start = begin;
+            misses             = 0;
+            clusters.push_back(begin);
+            for (unsigned int t = begin; t + 1 < end; ++t)
+            {
+                misses += cache.Access(&indices[t * 3]);
+                if ((float) misses / (t - start + 1) <= limit)
+                {
+                    clusters.push_back(t + 1);
+                    cache.Reset();
+                    start  = t + 1;
+                    misses = 0;
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+
+        // sort key: how far a cluster faces away from the mesh's center
+        glm::vec3              meshCenter(0.0f);
+        float                  meshArea = 0.0f;
+        std::vector<float>     keys(clusters.size() - 1);
+        std::vector<glm::vec3> centers(keys.size()), normals(keys.size());
+        for (unsigned int c = 0; c + 1 < clusters.size(); ++c)
+        {
+            glm::vec3 center(0.0f), normal(0.0f);
+            float     area = 0.0f;
+            for (unsigned int t = clusters[c]; t < clusters[c + 1]; ++t)
+            {
+                const glm::vec3 &p0 = positions[indices[t * 3 + 0]];
+                const glm::vec3 &p1 = positions[indices[t * 3 + 1]];
+                const glm::vec3 &p2 = positions[indices[t * 3 + 2]];
+                glm::vec3        n  = glm::cross(p1 - p0, p2 - p0);
+                float            a  = glm::length(n);
+                center += (p0 + p1 + p2) * (a / 3.0f);
+                normal += n;
+                area += a;
+            }
+            meshCenter += center;
+            meshArea += area;
+            centers[c] = area > 0.0f ? center / area : positions[indices[clusters[c] * 3]];
+            normals[c] = normal;
+        }
+        if (meshArea > 0.0f) meshCenter /= meshArea;
+        for (unsigned int c = 0; c < keys.size(); ++c)
+        {
+            float length = glm::length(normals[c]);
+            keys[c]      = length > 0.0f ? glm::dot(centers[c] - meshCenter, normals[c] / length) : 0.0f;
+        }
+
+        std::vector<unsigned int> order(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&keys](unsigned int a, unsigned int b) { return keys[a] > keys[b]; });
+
+        std::vector<unsigned int> result;
+        result.reserve(indices.size());
+        for (unsigned int c : order)
+            result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+        indices.swap(result);
+    }
+    // --------------------------------------------------------------------------------------------
+    std::vector<unsigned int> MeshOptimizer::OptimizeVertexFetch(std::vector<unsigned int> &indices, unsigned int &vertexCount)
+    {
+        std::vector<unsigned int> remap(vertexCount, ~0u);
+        unsigned int              next = 0;
+        for (unsigned int &index : indices)
+        {
+            if (remap[index] == ~0u) remap[index] = next++;
+            index = remap[index];
+        }
+        vertexCount = next;
+        return remap;
+    }
+    // --------------------------------------------------------------------------------------------
+    std::vector<unsigned int> MeshOptimizer::GenerateVertexRemap(const std::vector<VertexStream> &streams, unsigned int vertexCount, unsigned int &uniqueCount)
+    {
+        // open addressing with linear probing, at most half full
+        unsigned int tableSize = 1;
+        while (tableSize < vertexCount * 2)
+            tableSize *= 2;
+        std::vector<unsigned int> table(tableSize, ~0u);
+
+        std::vector<unsigned int> remap(vertexCount);
+        uniqueCount = 0;
+        for (unsigned int v = 0; v < vertexCount; ++v)
+        {
+            unsigned int slot = hashVertex(streams, v) & (tableSize - 1);
+            while (table[slot] != ~0u && !equalVertices(streams, table[slot], v))
+                slot = (slot + 1) & (tableSize - 1);
+
+            if (table[slot] == ~0u)
+            {
+                table[slot] = v;
+                remap[v]    = uniqueCount++;
+            }
+            else
+                remap[v] = remap[table[slot]];
+        }
+        return remap;
+    }
+    // --------------------------------------------------------------------------------------------
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<unsigned int> &indices, unsigned int vertexCount, unsigned int cacheSize)
+    {
+        VertexCacheStats stats;
+        stats.Triangles = indices.size() / 3;
+        if (stats.Triangles == 0) return stats;
+
+        CacheSimulation   cache(vertexCount, cacheSize);
+        std::vector<bool> referenced(vertexCount, false);
+        for (unsigned int t = 0; t < stats.Triangles; ++t)
+            stats.VerticesTransformed += cache.Access(&indices[t * 3]);
+        for (unsigned int index : indices)
+        {
+            if (!referenced[index]) stats.Vertices++;
+            referenced[index] = true;
+        }
+
+        stats.ACMR = (float) stats.VerticesTransformed / stats.Triangles;
+        stats.ATVR = (float) stats.VerticesTransformed / stats.Vertices;
+        return stats;
+    }
+    // --------------------------------------------------------------------------------------------
+    VertexCacheStats MeshOptimizer::Optimize(vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh)
+    {
+        unsigned int vertexCount = mesh->Positions.size();
+        if (mesh->Topology != vantor::Graphics::RenderDevice::OpenGL::TRIANGLES || mesh->Indices.empty())
+            return AnalyzeVertexCache(mesh->Indices, vertexCount);
+
+        OptimizeVertexCache(mesh->Indices, vertexCount);
+        OptimizeOverdraw(mesh->Indices, mesh->Positions);
+
+        std::vector<unsigned int> remap = OptimizeVertexFetch(mesh->Indices, vertexCount);
+        remapAttribute(mesh->Positions, remap, vertexCount);
+        remapAttribute(mesh->UV, remap, vertexCount);
+        remapAttribute(mesh->Normals, remap, vertexCount);
+        remapAttribute(mesh->Tangents, remap, vertexCount);
+        remapAttribute(mesh->Bitangents, remap, vertexCount);
+
+        return AnalyzeVertexCache(mesh->Indices, vertexCount);
+    }
+    // --------------------------------------------------------------------------------------------
+    void MeshOptimizer::Weld(vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh)
+    {
+        unsigned int vertexCount = mesh->Positions.size();
+        if (mesh->Topology != vantor::Graphics::RenderDevice::OpenGL::TRIANGLES || vertexCount == 0) return;
+
+        std::vector<VertexStream> streams = {{mesh->Positions.data(), sizeof(glm::vec3)}};
+        if (mesh->UV.size() == vertexCount) streams.push_back({mesh->UV.data(), sizeof(glm::vec2)});
+        if (mesh->Normals.size() == vertexCount) streams.push_back({mesh->Normals.data(), sizeof(glm::vec3)});
+        if (mesh->Tangents.size() == vertexCount) streams.push_back({mesh->Tangents.data(), sizeof(glm::vec3)});
+        if (mesh->Bitangents.size() == vertexCount) streams.push_back({mesh->Bitangents.data(), sizeof(glm::vec3)});
+
+        if (mesh->Indices.empty())
+        {
+            mesh->Indices.resize(vertexCount);
+            std::iota(mesh->Indices.begin(), mesh->Indices.end(), 0u);
+        }
+
+        unsigned int              uniqueCount = 0;
+        std::vector<unsigned int> remap       = GenerateVertexRemap(streams, vertexCount, uniqueCount);
+        for (unsigned int &index : mesh->Indices)
+            index = remap[index];
+
+        remapAttribute(mesh->Positions, remap, uniqueCount);
+        remapAttribute(mesh->UV, remap, uniqueCount);
+        remapAttribute(mesh->Normals, remap, uniqueCount);
+        remapAttribute(mesh->Tangents, remap, uniqueCount);
+        remapAttribute(mesh->Bitangents, remap, uniqueCount);
+    }
+    // --------------------------------------------------------------------------------------------
+    template <typename T> void MeshOptimizer::remapAttribute(std::vector<T> &attribute, const std::vector<unsigned int> &remap, unsigned int vertexCount)
+    {
+        if (attribute.empty()) return;
+
+        std::vector<T> result(vertexCount);
+        for (unsigned int v = 0; v < attribute.size() && v < remap.size(); ++v)
+        {
+            if (remap[v] != ~0u) result[remap[v]] = attribute[v];
+        }
+        attribute.swap(result);
+    }
+} // namespace vantor::Graphics::Geometry
@@ -0,0 +1,93 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMeshOptimizer.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    class Mesh;
+}
+
+namespace vantor::Graphics::Geometry
+{
+    // Post-transform cache efficiency of an index buffer, measured with a
+    // FIFO cache simulation.
+    struct VertexCacheStats
+    {
+            unsigned int Triangles           = 0;
+            unsigned int Vertices            = 0; // referenced vertices
+            unsigned int VerticesTransformed = 0; // cache misses
+            float        ACMR                = 0.0f; // transformed per triangle; 0.5 at best, 3 at worst
+            float        ATVR                = 0.0f; // transformed per vertex; 1 at best
+    };
+
+    // one attribute array as seen by MeshOptimizer::GenerateVertexRemap
+    struct VertexStream
+    {
+            const void *Data;
+            size_t      Stride; // bytes per vertex, compared as a whole
+    };
+
+    // Reorders triangle lists for the GPU, at import or cook time:
+    //  - vertex cache: Tipsify (Sander et al. 2007), linear time
+    //  - overdraw: splits the cache optimized order into clusters and draws
+    //    the outward facing ones first, within a bounded ACMR loss
+    //  - vertex fetch: renumbers vertices in first use order
+    // All functions take triangle lists (3 indices per triangle).
+    class MeshOptimizer
+    {
+        public:
+            // FIFO size the cache is optimized and measured for; small enough
+            // to be a safe bet on any recent GPU.
+            static constexpr unsigned int CACHE_SIZE = 16;
+
+            static void OptimizeVertexCache(std::vector<unsigned int> &indices, unsigned int vertexCount, unsigned int cacheSize = CACHE_SIZE);
+            // run after OptimizeVertexCache; threshold is the ACMR increase
+            // (as a factor) the reordering may cost.
+            static void OptimizeOverdraw(std::vector<unsigned int> &indices, const std::vector<glm::vec3> &positions, float threshold = 1.05f,
+                                         unsigned int cacheSize = CACHE_SIZE);
+            // rewrites indices in first use order; returns the old -> new
+            // index remap (~0u for unreferenced vertices) and the new vertex
+            // count through vertexCount.
+            static std::vector<unsigned int> OptimizeVertexFetch(std::vector<unsigned int> &indices, unsigned int &vertexCount);
+
+            // maps every vertex to the first one with bitwise identical data
+            // in all streams, numbered in first occurrence order; the number
+            // of distinct vertices is returned through uniqueCount.
+            static std::vector<unsigned int> GenerateVertexRemap(const std::vector<VertexStream> &streams, unsigned int vertexCount, unsigned int &uniqueCount);
+
+            static VertexCacheStats AnalyzeVertexCache(const std::vector<unsigned int> &indices, unsigned int vertexCount, unsigned int cacheSize = CACHE_SIZE);
+
+            // all of the above on a mesh's CPU side data, attributes are
+            // remapped (and unreferenced vertices dropped) along the way.
+            // Must run before Finalize(); returns the stats after optimizing.
+            static VertexCacheStats Optimize(vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh);
+            // merges duplicate vertices of a triangle mesh and rewrites its
+            // indices; builds them first if the mesh is unindexed.
+            static void Weld(vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh);
+
+        private:
+            template <typename T> static void remapAttribute(std::vector<T> &attribute, const std::vector<unsigned int> &remap, unsigned int vertexCount);
+    };
+} // namespace vantor::Graphics::Geometry
@@ -0,0 +1,335 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMeshSimplifier.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorMeshSimplifier.hpp"
+#include "vantorMeshOptimizer.hpp"
+#include "../RenderDevice/DeviceOpenGL/vantorOpenGLMesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vantor::Graphics::Geometry
+{
+    namespace
+    {
+        // sum of squared distances to a set of area weighted planes, stored as
+        // the symmetric 4x4 matrix [A b; b c]
+        struct Quadric
+        {
+                double A00 = 0, A01 = 0, A02 = 0, A11 = 0, A12 = 0, A22 = 0;
+                double B0 = 0, B1 = 0, B2 = 0;
+                double C      = 0;
+                double Weight = 0;
+
+                void AddPlane(const glm::dvec3 &n, double d, double weight)
+                {
+                    A00 += weight * n.x * n.x;
+                    A01 += weight * n.x * n.y;
+                    A02 += weight * n.x * n.z;
+                    A11 += weight * n.y * n.y;
+                    A12 += weight * n.y * n.z;
+                    A22 += weight * n.z * n.z;
+                    B0 += weight * n.x * d;
+                    B1 += weight * n.y * d;
+                    B2 += weight * n.z * d;
+                    C += weight * d * d;
+                    Weight += weight;
+                }
+
+                void Add(const Quadric &q)
+                {
+                    A00 += q.A00;
+                    A01 += q.A01;
+                    A02 += q.A02;
+                    A11 += q.A11;
+                    A12 += q.A12;
+                    A22 += q.A22;
+                    B0 += q.B0;
+                    B1 += q.B1;
+                    B2 += q.B2;
+                    C += q.C;
+                    Weight += q.Weight;
+                }
+
+                double Evaluate(const glm::dvec3 &p) const
+                {
+                    double rx = A00 * p.x + A01 * p.y + A02 * p.z;
+                    double ry = A01 * p.x + A11 * p.y + A12 * p.z;
+                    double rz = A02 * p.x + A12 * p.y + A22 * p.z;
+                    return rx * p.x + ry * p.y + rz * p.z + 2.0 * (B0 * p.x + B1 * p.y + B2 * p.z) + C;
+                }
+        };
+
+        struct Collapse
+        {
+                unsigned int From;
+                unsigned int To;
+                float        Cost; // squared, relative to the extent
+        };
+
+        // how much a normal/UV discontinuity weighs against geometric error
+        constexpr float ATTRIBUTE_WEIGHT = 0.25f;
+
+        uint64_t edgeKey(unsigned int a, unsigned int b) { return ((uint64_t) a << 32) | b; }
+    } // namespace
+
+    // --------------------------------------------------------------------------------------------
+    std::vector<unsigned int> MeshSimplifier::Simplify(const std::vector<unsigned int> &indices,
+                                                       const std::vector<glm::vec3>    &positions,
+                                                       const std::vector<glm::vec3>    &normals,
+                                                       const std::vector<glm::vec2>    &uv,
+                                                       unsigned int                     targetIndexCount,
+                                                       float                            targetError,
+                                                       float                           *error)
+    {
+        std::vector<unsigned int> result = indices;
+        if (error) *error = 0.0f;
+
+        const unsigned int vertexCount = positions.size();
+        if (result.size() <= targetIndexCount || vertexCount == 0) return result;
+
+        // errors are measured in a unit cube
+        glm::vec3 boxMin = positions[0], boxMax = positions[0];
+        for (const glm::vec3 &p : positions)
+        {
+            boxMin = glm::min(boxMin, p);
+            boxMax = glm::max(boxMax, p);
+        }
+        const glm::vec3 size   = boxMax - boxMin;
+        const float     extent = std::max(std::max(size.x, size.y), std::max(size.z, 1e-20f));
+        std::vector<glm::dvec3> points(vertexCount);
+        for (unsigned int i = 0; i < vertexCount; ++i)
+            points[i] = glm::dvec3((positions[i] - boxMin) / extent);
+
+        // vertices sharing a position are wedges of one point; topology and
+        // quadrics work on one representative of them
+        std::vector<unsigned int> point(vertexCount);
+        std::vector<unsigned int> wedges(vertexCount, 0);
+        {
+            std::vector<unsigned int> order(vertexCount);
+            for (unsigned int i = 0; i < vertexCount; ++i)
+                order[i] = i;
+            auto less = [&](unsigned int a, unsigned int b)
+            {
+                const glm::vec3 &p = positions[a], &q = positions[b];
+                return p.x != q.x ? p.x < q.x : p.y != q.y ? p.y < q.y : p.z < q.z;
+            };
+            std::sort(order.begin(), order.end(), less);
+            for (unsigned int i = 0; i < vertexCount; ++i)
+            {
+                bool same       = i > 0 && positions[order[i]] == positions[order[i - 1]];
+                point[order[i]] = same ? point[order[i - 1]] : order[i];
+                ++wedges[point[order[i]]];
+            }
+        }
+
+        // locked: seams, so attributes don't bleed across them, and open
+        // borders (edges without a twin), so holes and silhouettes stay put
+        std::vector<bool> locked(vertexCount, false);
+        for (unsigned int i = 0; i < vertexCount; ++i)
+            if (wedges[point[i]] > 1) locked[i] = true;
+        {
+            std::vector<uint64_t> edges;
+            edges.reserve(result.size());
+            for (size_t t = 0; t < result.size(); t += 3)
+                for (unsigned int e = 0; e < 3; ++e)
+                    edges.push_back(edgeKey(point[result[t + e]], point[result[t + (e + 1) % 3]]));
+            std::sort(edges.begin(), edges.end());
+            for (uint64_t edge : edges)
+            {
+                unsigned int a = edge >> 32, b = edge & 0xFFFFFFFF;
+                if (!std::binary_search(edges.begin(), edges.end(), edgeKey(b, a))) locked[a] = locked[b] = true;
+            }
+            for (unsigned int i = 0; i < vertexCount; ++i)
+                if (locked[point[i]]) locked[i] = true;
+        }
+
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t t = 0; t < result.size(); t += 3)
+        {
+            unsigned int a = point[result[t]], b = point[result[t + 1]], c = point[result[t + 2]];
+            glm::dvec3   n    = glm::cross(points[b] - points[a], points[c] - points[a]);
+            double       area = glm::length(n);
+            if (area <= 0.0) continue;
+            n /= area;
+            double d = -glm::dot(n, points[a]);
+            quadrics[a].AddPlane(n, d, area);
+            quadrics[b].AddPlane(n, d, area);
+            quadrics[c].AddPlane(n, d, area);
+        }
+
+        const float               maxCost = targetError * targetError;
+        float                     reached = 0.0f;
+        std::vector<unsigned int> remap(vertexCount);
+        std::vector<bool>         touched(vertexCount);
+        std::vector<unsigned int> offsets(vertexCount + 1);
+        std::vector<unsigned int> adjacency;
+        std::vector<Collapse>     collapses;
+
+        // collapses cost u -> v: the quadric error at v's position plus how
+        // far the attributes jump
+        auto cost = [&](unsigned int u, unsigned int v)
+        {
+            Quadric q = quadrics[point[u]];
+            q.Add(quadrics[point[v]]);
+            double distance = q.Weight > 0.0 ? std::max(q.Evaluate(points[v]), 0.0) / q.Weight : 0.0;
+
+            float attributes = 0.0f;
+            if (!normals.empty()) attributes += glm::dot(normals[u] - normals[v], normals[u] - normals[v]);
+            if (!uv.empty()) attributes += glm::dot(uv[u] - uv[v], uv[u] - uv[v]);
+            glm::dvec3 edge = points[u] - points[v];
+            return (float) distance + ATTRIBUTE_WEIGHT * attributes * (float) glm::dot(edge, edge);
+        };
+
+        // greedy passes: collapse the cheapest independent edges, rebuild, repeat
+        while (result.size() > targetIndexCount)
+        {
+            // vertex -> triangles
+            std::fill(offsets.begin(), offsets.end(), 0);
+            for (unsigned int index : result)
+                ++offsets[index + 1];
+            for (unsigned int i = 0; i < vertexCount; ++i)
+                offsets[i + 1] += offsets[i];
+            adjacency.resize(result.size());
+            {
+                std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < result.size(); ++i)
+                    adjacency[fill[result[i]]++] = i / 3;
+            }
+
+            // every interior edge shows up in both directions, keep one
+            collapses.clear();
+            for (size_t t = 0; t < result.size(); t += 3)
+            {
+                for (unsigned int e = 0; e < 3; ++e)
+                {
+                    unsigned int a = result[t + e], b = result[t + (e + 1) % 3];
+                    if (a > b || (locked[a] && locked[b])) continue;
+
+                    float costAB = locked[a] ? INFINITY : cost(a, b);
+                    float costBA = locked[b] ? INFINITY : cost(b, a);
+                    if (costAB <= costBA)
+                        collapses.push_back({a, b, costAB});
+                    else
+                        collapses.push_back({b, a, costBA});
+                }
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse &x, const Collapse &y) { return x.Cost < y.Cost; });
+
+            for (unsigned int i = 0; i < vertexCount; ++i)
+                remap[i] = i;
+            std::fill(touched.begin(), touched.end(), false);
+
+            // a collapse removes two triangles
+            const size_t budget    = (result.size() - targetIndexCount) / 6 + 1;
+            size_t       collapsed = 0;
+            for (const Collapse &collapse : collapses)
+            {
+                if (collapse.Cost > maxCost || collapsed >= budget) break;
+                const unsigned int u = collapse.From, v = collapse.To;
+                if (touched[u] || touched[v]) continue;
+
+                // moving u onto v must not fold any of u's other triangles over
+                bool flips = false;
+                for (unsigned int i = offsets[u]; i < offsets[u + 1] && !flips; ++i)
+                {
+                    const unsigned int *triangle = &result[adjacency[i] * 3];
+                    if (triangle[0] == v || triangle[1] == v || triangle[2] == v) continue;
+
+                    glm::dvec3 corners[3] = {points[triangle[0]], points[triangle[1]], points[triangle[2]]};
+                    glm::dvec3 before     = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+                    for (unsigned int c = 0; c < 3; ++c)
+                        if (triangle[c] == u) corners[c] = points[v];
+                    glm::dvec3 after = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+                    flips            = glm::dot(before, after) <= 0.0;
+                }
+                if (flips) continue;
+
+                remap[u] = v;
+                quadrics[point[v]].Add(quadrics[point[u]]);
+                reached = std::max(reached, collapse.Cost);
+                ++collapsed;
+
+                // keep the neighbourhood fixed for the rest of the pass, the
+                // flip test above relies on it
+                touched[u] = touched[v] = true;
+                for (unsigned int i = offsets[u]; i < offsets[u + 1]; ++i)
+                    for (unsigned int c = 0; c < 3; ++c)
+                        touched[result[adjacency[i] * 3 + c]] = true;
+            }
+            if (collapsed == 0) break;
+
+            // drop the triangles that became degenerate
+            size_t write = 0;
+            for (size_t t = 0; t < result.size(); t += 3)
+            {
+                unsigned int a = remap[result[t]], b = remap[result[t + 1]], c = remap[result[t + 2]];
+                if (point[a] == point[b] || point[b] == point[c] || point[a] == point[c]) continue;
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+            result.resize(write);
+        }
+
+        if (error) *error = std::sqrt(reached);
+        return result;
+    }
+    // --------------------------------------------------------------------------------------------
+    unsigned int MeshSimplifier::GenerateLODs(vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh, unsigned int maxLODs, float reduction, float maxError)
+    {
+        using namespace vantor::Graphics::RenderDevice::OpenGL;
+
+        mesh->LODs.clear();
+        if (mesh->Topology != TRIANGLES || mesh->Indices.size() < 3 || mesh->Positions.empty()) return 1;
+
+        glm::vec3 boxMin = mesh->Positions[0], boxMax = mesh->Positions[0];
+        for (const glm::vec3 &p : mesh->Positions)
+        {
+            boxMin = glm::min(boxMin, p);
+            boxMax = glm::max(boxMax, p);
+        }
+        const glm::vec3 size   = boxMax - boxMin;
+        const float     extent = std::max(std::max(size.x, size.y), size.z);
+
+        std::vector<MeshLOD> lods = {{0, (unsigned int) mesh->Indices.size(), 0.0f}};
+        std::vector<unsigned int> previous = mesh->Indices;
+        float                     error    = 0.0f;
+        for (unsigned int level = 0; level < maxLODs && error < maxError; ++level)
+        {
+            unsigned int target = (unsigned int) (previous.size() / 3 * reduction) * 3;
+            float        levelError;
+            std::vector<unsigned int> lod = Simplify(previous, mesh->Positions, mesh->Normals, mesh->UV, target, maxError - error, &levelError);
+            // mostly locked meshes stop shrinking; not worth a level
+            if (lod.empty() || lod.size() > previous.size() * 0.9f) break;
+
+            MeshOptimizer::OptimizeVertexCache(lod, mesh->Positions.size());
+
+            // every level is simplified from the last, so errors add up
+            error += levelError;
+            lods.push_back({(unsigned int) mesh->Indices.size(), (unsigned int) lod.size(), error * extent});
+            mesh->Indices.insert(mesh->Indices.end(), lod.begin(), lod.end());
+            previous = std::move(lod);
+        }
+
+        if (lods.size() > 1) mesh->LODs = lods;
+        return lods.size();
+    }
+} // namespace vantor::Graphics::Geometry
@@ -0,0 +1,67 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMeshSimplifier.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    class Mesh;
+}
+
+namespace vantor::Graphics::Geometry
+{
+    // Quadric error metric edge collapse simplification (Garland & Heckbert
+    // 1997) of triangle lists. Vertices are never moved or created, every
+    // collapse merges a vertex into one of its neighbours; so all levels of
+    // detail index into the same vertex buffer. Open borders and attribute
+    // seams (distinct vertices at one position) are locked, and normal and UV
+    // differences add to a collapse's cost to keep the shading intact.
+    class MeshSimplifier
+    {
+        public:
+            static constexpr unsigned int MAX_LODS = 4;
+
+            // simplifies until at most targetIndexCount indices are left or
+            // the next collapse would exceed targetError; returns the new
+            // index list. Errors are relative to the mesh's extent, the one
+            // reached is returned through error.
+            static std::vector<unsigned int> Simplify(const std::vector<unsigned int> &indices,
+                                                      const std::vector<glm::vec3>    &positions,
+                                                      const std::vector<glm::vec3>    &normals,
+                                                      const std::vector<glm::vec2>    &uv,
+                                                      unsigned int                     targetIndexCount,
+                                                      float                            targetError,
+                                                      float                           *error = nullptr);
+
+            // appends up to maxLODs levels to the mesh's indices, each keeping
+            // about reduction of the triangles of the one before, and fills
+            // Mesh::LODs. Stops early once a level hardly gets any simpler.
+            // Must run before Finalize() and after MeshOptimizer::Optimize();
+            // returns the number of levels including the original.
+            static unsigned int GenerateLODs(vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh,
+                                             unsigned int                                  maxLODs   = MAX_LODS,
+                                             float                                         reduction = 0.5f,
+                                             float                                         maxError  = 0.05f);
+    };
+} // namespace vantor::Graphics::Geometry
@@ -0,0 +1,176 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMeshletBuilder.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorMeshletBuilder.hpp"
+#include "../RenderDevice/DeviceOpenGL/vantorOpenGLMesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vantor::Graphics::Geometry
+{
+    using vantor::Graphics::RenderDevice::OpenGL::Meshlet;
+
+    // --------------------------------------------------------------------------------------------
+    std::vector<Meshlet> MeshletBuilder::Build(std::vector<unsigned int> &indices, const std::vector<glm::vec3> &positions, unsigned int maxVertices,
+                                               unsigned int maxTriangles)
+    {
+        std::vector<Meshlet> meshlets;
+        const unsigned int   triangleCount = indices.size() / 3;
+        const unsigned int   vertexCount   = positions.size();
+        if (triangleCount == 0) return meshlets;
+
+        // vertex -> triangles adjacency, flattened
+        std::vector<unsigned int> offsets(vertexCount + 1, 0);
+        for (unsigned int index : indices)
+            ++offsets[index + 1];
+        for (unsigned int i = 0; i < vertexCount; ++i)
+            offsets[i + 1] += offsets[i];
+        std::vector<unsigned int> adjacency(triangleCount * 3);
+        {
+            std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+            for (unsigned int i = 0; i < triangleCount * 3; ++i)
+                adjacency[fill[indices[i]]++] = i / 3;
+        }
+
+        std::vector<bool>         emitted(triangleCount, false);
+        std::vector<unsigned int> inMeshlet(vertexCount, ~0u); // meshlet a vertex was last added to
+        std::vector<unsigned int> candidates;
+        std::vector<unsigned int> reordered;
+        reordered.reserve(indices.size());
+
+        unsigned int seed = 0; // first triangle that might not be emitted yet
+        while (true)
+        {
+            while (seed < triangleCount && emitted[seed])
+                ++seed;
+            if (seed == triangleCount) break;
+
+            Meshlet meshlet;
+            meshlet.IndexOffset = reordered.size();
+            const unsigned int id = meshlets.size();
+
+            unsigned int vertices = 0, triangles = 0;
+            candidates.assign(1, seed);
+            while (triangles < maxTriangles)
+            {
+                // the candidate adding the fewest new vertices; candidates
+                // are the triangles around the meshlet's vertices
+                int best = -1, bestNew = 4;
+                for (unsigned int c = 0; c < candidates.size(); ++c)
+                {
+                    unsigned int triangle = candidates[c];
+                    if (emitted[triangle]) continue;
+                    int added = 0;
+                    for (unsigned int k = 0; k < 3; ++k)
+                        added += inMeshlet[indices[triangle * 3 + k]] != id;
+                    if (added < bestNew)
+                    {
+                        best    = c;
+                        bestNew = added;
+                        if (added == 0) break;
+                    }
+                }
+                if (best < 0 || vertices + bestNew > maxVertices) break;
+
+                unsigned int triangle = candidates[best];
+                emitted[triangle]     = true;
+                ++triangles;
+                for (unsigned int k = 0; k < 3; ++k)
+                {
+                    unsigned int vertex = indices[triangle * 3 + k];
+                    reordered.push_back(vertex);
+                    if (inMeshlet[vertex] == id) continue;
+                    inMeshlet[vertex] = id;
+                    ++vertices;
+                    for (unsigned int i = offsets[vertex]; i < offsets[vertex + 1]; ++i)
+                        if (!emitted[adjacency[i]]) candidates.push_back(adjacency[i]);
+                }
+
+                // keep the scan short by dropping what's been emitted meanwhile
+                if (candidates.size() > 4 * maxTriangles)
+                    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](unsigned int t) { return emitted[t]; }), candidates.end());
+            }
+
+            meshlet.IndexCount = reordered.size() - meshlet.IndexOffset;
+            computeBounds(meshlet, reordered.data() + meshlet.IndexOffset, positions);
+            meshlets.push_back(meshlet);
+        }
+
+        indices = std::move(reordered);
+        return meshlets;
+    }
+    // --------------------------------------------------------------------------------------------
+    void MeshletBuilder::Build(vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh)
+    {
+        using namespace vantor::Graphics::RenderDevice::OpenGL;
+
+        mesh->Meshlets.clear();
+        if (mesh->Topology != TRIANGLES) return;
+
+        // the finest level always starts the index buffer
+        const unsigned int        count = mesh->LODs.empty() ? mesh->Indices.size() : mesh->LODs[0].IndexCount;
+        std::vector<unsigned int> finest(mesh->Indices.begin(), mesh->Indices.begin() + count);
+        mesh->Meshlets = Build(finest, mesh->Positions);
+        std::copy(finest.begin(), finest.end(), mesh->Indices.begin());
+    }
+    // --------------------------------------------------------------------------------------------
+    void MeshletBuilder::computeBounds(Meshlet &meshlet, const unsigned int *indices, const std::vector<glm::vec3> &positions)
+    {
+        glm::vec3 boxMin = positions[indices[0]], boxMax = positions[indices[0]];
+        for (unsigned int i = 1; i < meshlet.IndexCount; ++i)
+        {
+            boxMin = glm::min(boxMin, positions[indices[i]]);
+            boxMax = glm::max(boxMax, positions[indices[i]]);
+        }
+        meshlet.Center = 0.5f * (boxMin + boxMax);
+        meshlet.Radius = 0.0f;
+        for (unsigned int i = 0; i < meshlet.IndexCount; ++i)
+            meshlet.Radius = std::max(meshlet.Radius, glm::length(positions[indices[i]] - meshlet.Center));
+
+        // cone around the average normal, as wide as the normal furthest off
+        std::vector<glm::vec3> normals;
+        normals.reserve(meshlet.IndexCount / 3);
+        glm::vec3 axis(0.0f);
+        for (unsigned int i = 0; i < meshlet.IndexCount; i += 3)
+        {
+            const glm::vec3 &a = positions[indices[i]], &b = positions[indices[i + 1]], &c = positions[indices[i + 2]];
+            glm::vec3        n = glm::cross(b - a, c - a);
+            float            l = glm::length(n);
+            if (l <= 0.0f) continue;
+            normals.push_back(n / l);
+            axis += n / l;
+        }
+
+        meshlet.ConeAxis   = glm::vec3(0.0f, 0.0f, 1.0f);
+        meshlet.ConeCutoff = 1.0f;
+        if (glm::length(axis) <= 0.0f) return;
+        axis = glm::normalize(axis);
+
+        float minDot = 1.0f;
+        for (const glm::vec3 &n : normals)
+            minDot = std::min(minDot, glm::dot(n, axis));
+        // a cone of 90 degrees or more is never entirely back facing
+        if (minDot <= 0.0f) return;
+
+        meshlet.ConeAxis   = axis;
+        meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+} // namespace vantor::Graphics::Geometry
@@ -0,0 +1,62 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorMeshletBuilder.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    class Mesh;
+    struct Meshlet;
+} // namespace vantor::Graphics::RenderDevice::OpenGL
+
+namespace vantor::Graphics::Geometry
+{
+    // Splits triangle lists into meshlets for per cluster culling. Meshlets
+    // grow greedily over shared vertices, so they stay compact; their
+    // triangles are then laid out back to back so every meshlet is a single
+    // index range, drawable with one indirect command.
+    class MeshletBuilder
+    {
+        public:
+            static constexpr unsigned int MAX_VERTICES  = 64;
+            static constexpr unsigned int MAX_TRIANGLES = 124;
+
+            // reorders indices by meshlet and returns the meshlets, with index
+            // ranges relative to the start of indices.
+            static std::vector<vantor::Graphics::RenderDevice::OpenGL::Meshlet> Build(std::vector<unsigned int>    &indices,
+                                                                                     const std::vector<glm::vec3> &positions,
+                                                                                     unsigned int                  maxVertices  = MAX_VERTICES,
+                                                                                     unsigned int                  maxTriangles = MAX_TRIANGLES);
+
+            // builds Mesh::Meshlets over the finest LOD (all of Indices if there
+            // are no LODs); runs after MeshSimplifier::GenerateLODs() and
+            // before Finalize().
+            static void Build(vantor::Graphics::RenderDevice::OpenGL::Mesh *mesh);
+
+        private:
+            static void computeBounds(vantor::Graphics::RenderDevice::OpenGL::Meshlet &meshlet,
+                                      const unsigned int                              *indices,
+                                      const std::vector<glm::vec3>                    &positions);
+    };
+} // namespace vantor::Graphics::Geometry
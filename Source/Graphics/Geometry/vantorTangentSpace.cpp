@@ -0,0 +1,237 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorTangentSpace.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorTangentSpace.hpp"
+#include "vantorMeshOptimizer.hpp"
+#include "../../Core/JobSystem/vantorJobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vantor::Graphics::Geometry
+{
+    namespace
+    {
+        // elements handed to one job
+        constexpr unsigned int JOB_SIZE = 1 << 12;
+
+        // runs job(first, last) over [0, count), split into JOB_SIZE ranges
+        // on the job system if parallel is set
+        template <typename F> void forRanges(unsigned int count, bool parallel, const F &job)
+        {
+            if (!parallel || count <= JOB_SIZE)
+            {
+                job(0u, count);
+                return;
+            }
+            vantor::Core::JobSystem::ParallelFor((count + JOB_SIZE - 1) / JOB_SIZE,
+                                                 [&](uint32_t range) { job(range * JOB_SIZE, std::min(count, (range + 1) * JOB_SIZE)); });
+        }
+
+        // corners referencing each of count keys: those of key k are
+        // corners[first[k]] to corners[first[k + 1] - 1], in ascending order
+        // so sums over them come out the same however the work was split.
+        void buildCorners(const std::vector<unsigned int> &cornerKeys, unsigned int count, std::vector<unsigned int> &first, std::vector<unsigned int> &corners)
+        {
+            first.assign(count + 1, 0);
+            for (unsigned int key : cornerKeys)
+                first[key + 1]++;
+            for (unsigned int k = 0; k < count; ++k)
+                first[k + 1] += first[k];
+
+            std::vector<unsigned int> next(first.begin(), first.end() - 1);
+            corners.resize(cornerKeys.size());
+            for (unsigned int c = 0; c < cornerKeys.size(); ++c)
+                corners[next[cornerKeys[c]]++] = c;
+        }
+
+        // angle between two edges leaving the same corner, 0 if either is degenerate
+        float cornerAngle(glm::vec3 a, glm::vec3 b)
+        {
+            const float lengths = glm::length(a) * glm::length(b);
+            if (lengths <= 0.0f) return 0.0f;
+            return std::acos(glm::clamp(glm::dot(a, b) / lengths, -1.0f, 1.0f));
+        }
+
+        // any unit vector perpendicular to n
+        glm::vec3 perpendicular(glm::vec3 n)
+        {
+            const glm::vec3 axis = std::abs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+            return glm::normalize(glm::cross(axis, n));
+        }
+    } // namespace
+
+    // --------------------------------------------------------------------------------------------
+    void TangentSpace::CalculateNormals(const std::vector<glm::vec3> &positions, const std::vector<unsigned int> &indices, std::vector<glm::vec3> &normals, bool smooth)
+    {
+        const unsigned int triangleCount = indices.size() / 3;
+        normals.assign(positions.size(), glm::vec3(0.0f, 1.0f, 0.0f));
+
+        if (!smooth)
+        {
+            for (unsigned int t = 0; t < triangleCount; ++t)
+            {
+                const unsigned int *tri    = &indices[t * 3];
+                const glm::vec3     normal = glm::cross(positions[tri[1]] - positions[tri[0]], positions[tri[2]] - positions[tri[0]]);
+                if (glm::dot(normal, normal) > 0.0f) normals[tri[0]] = normals[tri[1]] = normals[tri[2]] = glm::normalize(normal);
+            }
+            return;
+        }
+
+        const bool parallel = triangleCount >= PARALLEL_THRESHOLD;
+
+        // angle weighted face normal per corner
+        std::vector<glm::vec3> weighted(triangleCount * 3);
+        forRanges(triangleCount, parallel,
+                  [&](unsigned int first, unsigned int last)
+                  {
+                      for (unsigned int t = first; t < last; ++t)
+                      {
+                          const unsigned int *tri = &indices[t * 3];
+                          const glm::vec3     p0  = positions[tri[0]];
+                          const glm::vec3     p1  = positions[tri[1]];
+                          const glm::vec3     p2  = positions[tri[2]];
+                          const glm::vec3     n   = glm::cross(p1 - p0, p2 - p0);
+                          if (glm::dot(n, n) <= 0.0f)
+                          {
+                              weighted[t * 3] = weighted[t * 3 + 1] = weighted[t * 3 + 2] = glm::vec3(0.0f);
+                              continue;
+                          }
+
+                          const glm::vec3 normal = glm::normalize(n);
+                          const float     a0     = cornerAngle(p1 - p0, p2 - p0);
+                          const float     a1     = cornerAngle(p2 - p1, p0 - p1);
+                          weighted[t * 3]        = normal * a0;
+                          weighted[t * 3 + 1]    = normal * a1;
+                          weighted[t * 3 + 2]    = normal * std::max(3.14159265f - a0 - a1, 0.0f);
+                      }
+                  });
+
+        // vertices at the same position share a normal; adding zero turns
+        // -0 into +0, which the bitwise comparison would tell apart
+        std::vector<glm::vec3> keys(positions.size());
+        for (unsigned int v = 0; v < positions.size(); ++v)
+            keys[v] = positions[v] + glm::vec3(0.0f);
+        unsigned int              groupCount = 0;
+        std::vector<unsigned int> group      = MeshOptimizer::GenerateVertexRemap({{keys.data(), sizeof(glm::vec3)}}, keys.size(), groupCount);
+
+        std::vector<unsigned int> cornerGroups(indices.size());
+        for (unsigned int c = 0; c < indices.size(); ++c)
+            cornerGroups[c] = group[indices[c]];
+        std::vector<unsigned int> first, corners;
+        buildCorners(cornerGroups, groupCount, first, corners);
+
+        std::vector<glm::vec3> groupNormals(groupCount);
+        forRanges(groupCount, parallel,
+                  [&](unsigned int begin, unsigned int end)
+                  {
+                      for (unsigned int g = begin; g < end; ++g)
+                      {
+                          glm::vec3 sum(0.0f);
+                          for (unsigned int c = first[g]; c < first[g + 1]; ++c)
+                              sum += weighted[corners[c]];
+                          groupNormals[g] = glm::dot(sum, sum) > 0.0f ? glm::normalize(sum) : glm::vec3(0.0f, 1.0f, 0.0f);
+                      }
+                  });
+        for (unsigned int v = 0; v < positions.size(); ++v)
+            normals[v] = groupNormals[group[v]];
+    }
+    // --------------------------------------------------------------------------------------------
+    void TangentSpace::CalculateTangents(const std::vector<glm::vec3>    &positions,
+                                         const std::vector<glm::vec3>    &normals,
+                                         const std::vector<glm::vec2>    &uv,
+                                         const std::vector<unsigned int> &indices,
+                                         std::vector<glm::vec3>          &tangents,
+                                         std::vector<glm::vec3>          &bitangents)
+    {
+        const unsigned int vertexCount   = positions.size();
+        const unsigned int triangleCount = indices.size() / 3;
+        const bool         parallel      = triangleCount >= PARALLEL_THRESHOLD;
+        const bool         mapped        = uv.size() >= vertexCount;
+
+        // angle weighted tangent per corner, in the plane of the corner's
+        // vertex normal; the weight's sign is the UV mapping's handedness
+        std::vector<glm::vec3> weighted(triangleCount * 3, glm::vec3(0.0f));
+        std::vector<float>     handedness(triangleCount * 3, 0.0f);
+        if (mapped)
+        {
+            forRanges(triangleCount, parallel,
+                      [&](unsigned int first, unsigned int last)
+                      {
+                          for (unsigned int t = first; t < last; ++t)
+                          {
+                              const unsigned int *tri = &indices[t * 3];
+                              const glm::vec3     d1  = positions[tri[1]] - positions[tri[0]];
+                              const glm::vec3     d2  = positions[tri[2]] - positions[tri[0]];
+                              const glm::vec2     t1  = uv[tri[1]] - uv[tri[0]];
+                              const glm::vec2     t2  = uv[tri[2]] - uv[tri[0]];
+
+                              // dP/du up to the (signed) UV area
+                              const float area    = t1.x * t2.y - t1.y * t2.x;
+                              glm::vec3   tangent = d1 * t2.y - d2 * t1.y;
+                              if (area == 0.0f || glm::dot(tangent, tangent) <= 0.0f) continue;
+                              const float sign = area > 0.0f ? 1.0f : -1.0f;
+                              tangent *= sign;
+
+                              for (unsigned int k = 0; k < 3; ++k)
+                              {
+                                  const glm::vec3 n      = normals[tri[k]];
+                                  const glm::vec3 p      = positions[tri[k]];
+                                  const glm::vec3 next   = positions[tri[(k + 1) % 3]] - p;
+                                  const glm::vec3 prev   = positions[tri[(k + 2) % 3]] - p;
+                                  const glm::vec3 planar = tangent - n * glm::dot(n, tangent);
+                                  const float     angle  = cornerAngle(next - n * glm::dot(n, next), prev - n * glm::dot(n, prev));
+                                  if (glm::dot(planar, planar) <= 0.0f) continue;
+                                  weighted[t * 3 + k]   = glm::normalize(planar) * angle;
+                                  handedness[t * 3 + k] = sign * angle;
+                              }
+                          }
+                      });
+        }
+
+        std::vector<unsigned int> first, corners;
+        buildCorners(indices, vertexCount, first, corners);
+
+        tangents.resize(vertexCount);
+        bitangents.resize(vertexCount);
+        forRanges(vertexCount, parallel,
+                  [&](unsigned int begin, unsigned int end)
+                  {
+                      for (unsigned int v = begin; v < end; ++v)
+                      {
+                          glm::vec3 sum(0.0f);
+                          float     sign = 0.0f;
+                          for (unsigned int c = first[v]; c < first[v + 1]; ++c)
+                          {
+                              sum += weighted[corners[c]];
+                              sign += handedness[corners[c]];
+                          }
+
+                          // MikkTSpace splits vertices whose corners disagree
+                          // on handedness; the vertex count is fixed here, so
+                          // the majority (by angle) wins.
+                          const glm::vec3 n = normals[v];
+                          sum -= n * glm::dot(n, sum);
+                          tangents[v]   = glm::dot(sum, sum) > 1e-12f ? glm::normalize(sum) : perpendicular(n);
+                          bitangents[v] = glm::cross(n, tangents[v]) * (sign < 0.0f ? -1.0f : 1.0f);
+                      }
+                  });
+    }
+} // namespace vantor::Graphics::Geometry
@@ -0,0 +1,61 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorTangentSpace.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace vantor::Graphics::Geometry
+{
+    // Per vertex shading frames of indexed triangle lists:
+    //  - normals: face normals weighted by the corner angle (Thürmer &
+    //    Wüthrich 1998), which unlike area weighting doesn't depend on how a
+    //    surface is triangulated. Vertices sharing a position are smoothed as
+    //    one, so UV and material seams don't show in the shading.
+    //  - tangents: MikkTSpace's construction; per corner tangents projected
+    //    onto the vertex normal and angle weighted, so baked normal maps
+    //    line up with the tools that bake them. Bitangents are rebuilt as
+    //    sign * cross(normal, tangent).
+    // Meshes of PARALLEL_THRESHOLD triangles or more are processed on the job
+    // system; the results are the same either way.
+    class TangentSpace
+    {
+        public:
+            static constexpr unsigned int PARALLEL_THRESHOLD = 1 << 14;
+
+            // smooth = false gives every vertex the normal of the triangle it
+            // belongs to, which is only flat if no vertex is shared.
+            static void CalculateNormals(const std::vector<glm::vec3>    &positions,
+                                         const std::vector<unsigned int> &indices,
+                                         std::vector<glm::vec3>          &normals,
+                                         bool                             smooth = true);
+
+            // normals must be set; vertices without usable UVs get an
+            // arbitrary frame around their normal.
+            static void CalculateTangents(const std::vector<glm::vec3>    &positions,
+                                          const std::vector<glm::vec3>    &normals,
+                                          const std::vector<glm::vec2>    &uv,
+                                          const std::vector<unsigned int> &indices,
+                                          std::vector<glm::vec3>          &tangents,
+                                          std::vector<glm::vec3>          &bitangents);
+    };
+} // namespace vantor::Graphics::Geometry
@@ -26,8 +26,7 @@
 #include "../vantorOpenGLRenderTarget.hpp"
 
 #include "../../../../Core/Resource/vantorResource.hpp"
-#include "../../../Geometry/Primitives/vantorCube.hpp"
-#include "../../../Geometry/Primitives/vantorSphere.hpp"
+#include "../../../Geometry/Primitives/vantorPrimitiveCache.hpp"
 #include "../../../../Core/Scene/vantorScene.hpp"
 #include "../vantorOpenGLMaterial.hpp"
 #include "../vantorOpenGLShader.hpp"
@@ -59,7 +58,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         m_PBRIrradianceCapture->Cull         = false;
         m_PBRPrefilterCapture->Cull          = false;
 
-        m_PBRCaptureCube         = new vantor::Graphics::Geometry::Primitives::Cube();
+        m_PBRCaptureCube         = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetCube();
         m_SceneEnvCube           = new vantor::SceneNode(0);
         m_SceneEnvCube->Mesh     = m_PBRCaptureCube;
         m_SceneEnvCube->Material = m_PBRHdrToCubemap;
@@ -70,26 +69,25 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         // capture
         m_ProbeCaptureShader = vantor::Resources::LoadShader("pbr:capture", "res/intern/shaders/capture.vs", "res/intern/shaders/capture.fs");
         m_ProbeCaptureShader->Use();
-        m_ProbeCaptureShader->SetInt("TexAlbedo", 0);
-        m_ProbeCaptureShader->SetInt("TexNormal", 1);
-        m_ProbeCaptureShader->SetInt("TexMetallic", 2);
-        m_ProbeCaptureShader->SetInt("TexRoughness", 3);
+        m_ProbeCaptureShader->SetInt("TexAlbedo"_uid, 0);
+        m_ProbeCaptureShader->SetInt("TexNormal"_uid, 1);
+        m_ProbeCaptureShader->SetInt("TexMetallic"_uid, 2);
+        m_ProbeCaptureShader->SetInt("TexRoughness"_uid, 3);
         m_ProbeCaptureBackgroundShader
             = vantor::Resources::LoadShader("pbr:capture background", "res/intern/vshaders/capture_background.vs", "res/intern/shaders/capture_background.fs");
         m_ProbeCaptureBackgroundShader->Use();
-        m_ProbeCaptureBackgroundShader->SetInt("background", 0);
+        m_ProbeCaptureBackgroundShader->SetInt("background"_uid, 0);
 
         // debug render
-        m_ProbeDebugSphere = new vantor::Graphics::Geometry::Primitives::Sphere(32, 32);
+        m_ProbeDebugSphere = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetSphere(32, 32);
         m_ProbeDebugShader
             = vantor::Resources::LoadShader("pbr:probe_render", "res/intern/shaders/pbr/probe_render.vs", "res/intern/shaders/pbr/probe_render.fs");
         m_ProbeDebugShader->Use();
-        m_ProbeDebugShader->SetInt("PrefilterMap", 0);
+        m_ProbeDebugShader->SetInt("PrefilterMap"_uid, 0);
     }
     // --------------------------------------------------------------------------------------------
     PBR::~PBR()
     {
-        delete m_PBRCaptureCube;
         delete m_SceneEnvCube;
         delete m_RenderTargetBRDFLUT;
         delete m_PBRHdrToCubemap;
@@ -103,7 +101,6 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             delete m_CaptureProbes[i]->Prefiltered;
             delete m_CaptureProbes[i];
         }
-        delete m_ProbeDebugSphere;
     }
     // --------------------------------------------------------------------------------------------
     void PBR::SetSkyCapture(PBRCapture *capture) { m_SkyCapture = capture; }
@@ -193,17 +190,17 @@ namespace vantor::Graphics::RenderDevice::OpenGL
     void PBR::RenderProbes()
     {
         m_ProbeDebugShader->Use();
-        m_ProbeDebugShader->SetMatrix("projection", m_Renderer->GetCamera()->Projection);
-        m_ProbeDebugShader->SetMatrix("view", m_Renderer->GetCamera()->View);
-        m_ProbeDebugShader->SetVector("CamPos", m_Renderer->GetCamera()->Position);
+        m_ProbeDebugShader->SetMatrix("projection"_uid, m_Renderer->GetCamera()->Projection);
+        m_ProbeDebugShader->SetMatrix("view"_uid, m_Renderer->GetCamera()->View);
+        m_ProbeDebugShader->SetVector("CamPos"_uid, m_Renderer->GetCamera()->Position);
 
-        m_ProbeDebugShader->SetVector("Position", glm::vec3(0.0f, 2.0, 0.0f));
+        m_ProbeDebugShader->SetVector("Position"_uid, glm::vec3(0.0f, 2.0, 0.0f));
         m_SkyCapture->Prefiltered->Bind(0);
         m_Renderer->renderMesh(m_ProbeDebugSphere, m_ProbeDebugShader);
 
         for (int i = 0; i < m_CaptureProbes.size(); ++i)
         {
-            m_ProbeDebugShader->SetVector("Position", m_CaptureProbes[i]->Position);
+            m_ProbeDebugShader->SetVector("Position"_uid, m_CaptureProbes[i]->Position);
             if (m_CaptureProbes[i]->Prefiltered)
             {
                 m_CaptureProbes[i]->Prefiltered->Bind(0);
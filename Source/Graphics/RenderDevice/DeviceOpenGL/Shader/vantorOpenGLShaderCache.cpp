@@ -0,0 +1,196 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLShaderCache.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorOpenGLShaderCache.hpp"
+#include "../../../../Core/BackLog/vantorBacklog.h"
+#include "../../../../Helpers/vantorFS.hpp"
+
+#include <glad/glad.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    namespace
+    {
+        constexpr uint32_t CACHE_MAGIC   = 0x43505356; // "VSPC"
+        constexpr uint32_t CACHE_VERSION = 1;
+
+        struct CacheHeader
+        {
+                uint32_t Magic;
+                uint32_t Version;
+                uint64_t Key;
+                uint32_t Format;
+                uint32_t Length;
+        };
+
+        // 64 bit FNV-1a, chained so several strings can be folded into one key
+        uint64_t hash64(const char *data, std::size_t length, uint64_t hash = 14695981039346656037ull)
+        {
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                hash ^= static_cast<unsigned char>(data[i]);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        uint64_t hash64(const std::string &str, uint64_t hash)
+        {
+            // hash the terminator as well so ("ab", "c") and ("a", "bc") differ
+            return hash64(str.c_str(), str.size() + 1, hash);
+        }
+    } // namespace
+
+    std::string ShaderCache::m_Directory   = "cache/shaders";
+    bool        ShaderCache::m_Enabled     = true;
+    bool        ShaderCache::m_Initialized = false;
+    uint64_t    ShaderCache::m_DriverHash  = 0;
+    // --------------------------------------------------------------------------------------------
+    void ShaderCache::SetDirectory(const std::string &directory) { m_Directory = directory; }
+    // --------------------------------------------------------------------------------------------
+    void ShaderCache::SetEnabled(bool enabled) { m_Enabled = enabled; }
+    // --------------------------------------------------------------------------------------------
+    bool ShaderCache::IsEnabled()
+    {
+        initialize();
+        return m_Enabled;
+    }
+    // --------------------------------------------------------------------------------------------
+    uint64_t ShaderCache::ComputeKey(const std::string &vsCode, const std::string &fsCode, const std::vector<std::string> &defines)
+    {
+        initialize();
+
+        uint64_t key = hash64(vsCode, m_DriverHash);
+        key          = hash64(fsCode, key);
+        for (unsigned int i = 0; i < defines.size(); ++i)
+            key = hash64(defines[i], key);
+        return key;
+    }
+    // --------------------------------------------------------------------------------------------
+    bool ShaderCache::LoadProgram(uint64_t key, unsigned int program)
+    {
+        if (!IsEnabled()) return false;
+
+        std::string          path = getEntryPath(key);
+        std::vector<uint8_t> data = vantor::Helpers::FileSystem::ReadBinary(path);
+        if (data.size() < sizeof(CacheHeader)) return false;
+
+        CacheHeader header;
+        std::memcpy(&header, data.data(), sizeof(CacheHeader));
+        if (header.Magic != CACHE_MAGIC || header.Version != CACHE_VERSION || header.Key != key
+            || data.size() - sizeof(CacheHeader) != header.Length)
+        {
+            std::remove(path.c_str());
+            return false;
+        }
+
+        glProgramBinary(program, header.Format, data.data() + sizeof(CacheHeader), header.Length);
+
+        int status;
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+        if (!status)
+        {
+            // the driver rejected the binary (e.g. after an update that kept the
+            // version string); drop it so it gets rebuilt on this run.
+            vantor::Backlog::Log("ShaderCache", "Discarding stale program binary: " + path, vantor::Backlog::LogLevel::DEBUG);
+            std::remove(path.c_str());
+            return false;
+        }
+        return true;
+    }
+    // --------------------------------------------------------------------------------------------
+    void ShaderCache::StoreProgram(uint64_t key, unsigned int program)
+    {
+        if (!IsEnabled()) return;
+
+        int length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) return;
+
+        std::vector<uint8_t> data(sizeof(CacheHeader) + length);
+        GLenum               format = 0;
+        glGetProgramBinary(program, length, &length, &format, data.data() + sizeof(CacheHeader));
+
+        CacheHeader header = {CACHE_MAGIC, CACHE_VERSION, key, (uint32_t) format, (uint32_t) length};
+        std::memcpy(data.data(), &header, sizeof(CacheHeader));
+
+        // write to a temporary file first so a crash never leaves a truncated
+        // entry under the real name
+        std::string path    = getEntryPath(key);
+        std::string tmpPath = path + ".tmp";
+        FILE       *file    = fopen(tmpPath.c_str(), "wb");
+        if (!file)
+        {
+            vantor::Backlog::Log("ShaderCache", "Failed to write program binary: " + path, vantor::Backlog::LogLevel::WARNING);
+            return;
+        }
+        bool written = fwrite(data.data(), 1, sizeof(CacheHeader) + length, file) == sizeof(CacheHeader) + length;
+        fclose(file);
+
+        std::remove(path.c_str());
+        if (!written || std::rename(tmpPath.c_str(), path.c_str()) != 0) std::remove(tmpPath.c_str());
+    }
+    // --------------------------------------------------------------------------------------------
+    void ShaderCache::initialize()
+    {
+        if (m_Initialized) return;
+        m_Initialized = true;
+
+        int formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        if (formats <= 0)
+        {
+            vantor::Backlog::Log("ShaderCache", "Driver exposes no program binary formats, shader cache disabled.", vantor::Backlog::LogLevel::INFO);
+            m_Enabled = false;
+        }
+
+        // any driver change must invalidate every entry
+        const GLenum driverStrings[] = {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION};
+        uint64_t     hash            = hash64("vantor", 6);
+        for (GLenum name : driverStrings)
+        {
+            const char *str = (const char *) glGetString(name);
+            if (str) hash = hash64(str, std::strlen(str) + 1, hash);
+        }
+        m_DriverHash = hash;
+
+        if (!m_Enabled) return;
+#if !defined(__SWITCH__)
+        std::error_code error;
+        std::filesystem::create_directories(m_Directory, error);
+        if (error)
+        {
+            vantor::Backlog::Log("ShaderCache", "Could not create shader cache directory: " + m_Directory + ", shader cache disabled.",
+                                 vantor::Backlog::LogLevel::WARNING);
+            m_Enabled = false;
+        }
+#endif
+    }
+    // --------------------------------------------------------------------------------------------
+    std::string ShaderCache::getEntryPath(uint64_t key)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long) key);
+        return m_Directory + "/" + name;
+    }
+} // namespace vantor::Graphics::RenderDevice::OpenGL
@@ -0,0 +1,63 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLShaderCache.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    // On-disk cache of linked program binaries (glGetProgramBinary).
+    //
+    // Entries are keyed by a 64 bit hash of the fully preprocessed shader
+    // sources, the define list and the driver identification strings, so any
+    // change to a shader, one of its includes or the driver produces a new key
+    // and stale binaries are simply never looked up again. Binaries the driver
+    // refuses to load are deleted and recompiled.
+    class ShaderCache
+    {
+        private:
+            static std::string m_Directory;
+            static bool        m_Enabled;
+            static bool        m_Initialized;
+            static uint64_t    m_DriverHash;
+
+        public:
+            static void SetDirectory(const std::string &directory);
+            static void SetEnabled(bool enabled);
+            static bool IsEnabled();
+
+            static uint64_t ComputeKey(const std::string &vsCode, const std::string &fsCode, const std::vector<std::string> &defines);
+
+            // try to fill an (unlinked) program object from the cache; returns
+            // true if the program is linked and ready for use.
+            static bool LoadProgram(uint64_t key, unsigned int program);
+            // write the binary of a successfully linked program to the cache;
+            // the program must have been linked with
+            // GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+            static void StoreProgram(uint64_t key, unsigned int program);
+
+        private:
+            static void        initialize();
+            static std::string getEntryPath(uint64_t key);
+    };
+} // namespace vantor::Graphics::RenderDevice::OpenGL
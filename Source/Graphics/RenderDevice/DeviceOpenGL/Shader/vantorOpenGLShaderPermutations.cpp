@@ -0,0 +1,95 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLShaderPermutations.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorOpenGLShaderPermutations.hpp"
+#include "../vantorOpenGLShader.hpp"
+
+#include "../../../../Core/Resource/vantorResource.hpp"
+#include "../../../../Core/BackLog/vantorBacklog.h"
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    // --------------------------------------------------------------------------------------------
+    ShaderPermutations::ShaderPermutations() {}
+    // --------------------------------------------------------------------------------------------
+    ShaderPermutations::ShaderPermutations(std::string name, std::string vsPath, std::string fsPath, std::vector<std::string> keywords)
+        : Name(name), m_VsPath(vsPath), m_FsPath(fsPath), m_Keywords(keywords)
+    {
+        if (m_Keywords.size() > MAX_KEYWORDS)
+        {
+            vantor::Backlog::Log("OpenGLShaderPermutations", "Shader: " + name + " declares more than 32 keywords, the rest is ignored.",
+                                 vantor::Backlog::LogLevel::WARNING);
+            m_Keywords.resize(MAX_KEYWORDS);
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    uint32_t ShaderPermutations::GetKeyword(std::string_view keyword) const
+    {
+        for (unsigned int i = 0; i < m_Keywords.size(); ++i)
+        {
+            if (m_Keywords[i] == keyword) return 1u << i;
+        }
+        vantor::Backlog::Log("OpenGLShaderPermutations", "Shader: " + Name + " has no keyword: " + std::string(keyword) + ".",
+                             vantor::Backlog::LogLevel::WARNING);
+        return 0;
+    }
+    // --------------------------------------------------------------------------------------------
+    uint32_t ShaderPermutations::GetMask(const std::vector<std::string> &keywords) const
+    {
+        uint32_t mask = 0;
+        for (unsigned int i = 0; i < keywords.size(); ++i)
+            mask |= GetKeyword(keywords[i]);
+        return mask;
+    }
+    // --------------------------------------------------------------------------------------------
+    const std::vector<std::string> &ShaderPermutations::GetKeywords() const { return m_Keywords; }
+    // --------------------------------------------------------------------------------------------
+    Shader *ShaderPermutations::GetVariant(uint32_t mask)
+    {
+        auto found = m_Variants.find(mask);
+        if (found != m_Variants.end()) return found->second;
+
+        // variants are registered under "name[KEYWORD|KEYWORD]"
+        std::vector<std::string> defines;
+        std::string              variantName = Name + "[";
+        for (unsigned int i = 0; i < m_Keywords.size(); ++i)
+        {
+            if (!(mask & (1u << i))) continue;
+
+            if (!defines.empty()) variantName += "|";
+            variantName += m_Keywords[i];
+            defines.push_back(m_Keywords[i]);
+        }
+        variantName += "]";
+
+        Shader *shader   = vantor::Resources::LoadShader(variantName, m_VsPath, m_FsPath, defines);
+        m_Variants[mask] = shader;
+        return shader;
+    }
+    // --------------------------------------------------------------------------------------------
+    Shader *ShaderPermutations::GetVariant(const std::vector<std::string> &keywords) { return GetVariant(GetMask(keywords)); }
+    // --------------------------------------------------------------------------------------------
+    void ShaderPermutations::Prewarm(const std::vector<uint32_t> &masks)
+    {
+        // loading only submits the compile; nothing here waits on the driver
+        for (unsigned int i = 0; i < masks.size(); ++i)
+            GetVariant(masks[i]);
+    }
+} // namespace vantor::Graphics::RenderDevice::OpenGL
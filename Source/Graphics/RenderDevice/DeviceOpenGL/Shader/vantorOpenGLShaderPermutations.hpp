@@ -0,0 +1,70 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLShaderPermutations.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    class Shader;
+
+    // A shader source pair together with the feature keywords it understands
+    // (e.g. ALPHA_DISCARD, NORMAL_MAP, SKINNING). A variant is identified by a
+    // bitmask over the declared keywords; every set bit becomes a #define.
+    //
+    // Variants are compiled on first request or up front through Prewarm().
+    // They are loaded through vantor::Resources, which shares one program
+    // between all variants (of any permutation set) with identical source.
+    class ShaderPermutations
+    {
+        public:
+            static constexpr unsigned int MAX_KEYWORDS = 32;
+
+            std::string Name;
+
+        private:
+            std::string                            m_VsPath;
+            std::string                            m_FsPath;
+            std::vector<std::string>               m_Keywords;
+            std::unordered_map<uint32_t, Shader *> m_Variants;
+
+        public:
+            ShaderPermutations();
+            ShaderPermutations(std::string name, std::string vsPath, std::string fsPath, std::vector<std::string> keywords);
+
+            // bit of a single keyword; 0 (and a warning) if it was not declared
+            uint32_t GetKeyword(std::string_view keyword) const;
+            uint32_t GetMask(const std::vector<std::string> &keywords) const;
+
+            const std::vector<std::string> &GetKeywords() const;
+
+            Shader *GetVariant(uint32_t mask);
+            Shader *GetVariant(const std::vector<std::string> &keywords);
+
+            // submit the listed variants for compilation right away so they are
+            // (being) compiled before the first material asks for them.
+            void Prewarm(const std::vector<uint32_t> &masks);
+    };
+} // namespace vantor::Graphics::RenderDevice::OpenGL
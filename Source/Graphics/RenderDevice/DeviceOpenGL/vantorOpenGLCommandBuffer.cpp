@@ -0,0 +1,195 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLCommandBuffer.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorOpenGLCommandBuffer.hpp"
+
+#include "vantorOpenGLRenderer.hpp"
+#include "vantorOpenGLMaterial.hpp"
+#include "vantorOpenGLMaterialLibrary.hpp"
+#include "vantorOpenGLShader.hpp"
+#include "vantorOpenGLMesh.hpp"
+
+#include <algorithm>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    namespace
+    {
+        bool renderSortKey(const RenderCommand &a, const RenderCommand &b) { return a.SortKey < b.SortKey; }
+    } // namespace
+
+    // --------------------------------------------------------------------------------------------
+    CommandBuffer::CommandBuffer(Renderer *renderer) { m_Renderer = renderer; }
+    // --------------------------------------------------------------------------------------------
+    CommandBuffer::~CommandBuffer() { Clear(); }
+    // --------------------------------------------------------------------------------------------
+    void CommandBuffer::Push(Mesh *mesh, Material *material, glm::mat4 transform, glm::mat4 prevTransform, glm::vec3 boxMin, glm::vec3 boxMax, RenderTarget *target)
+    {
+        RenderCommand command = {};
+        command.Mesh          = mesh;
+        command.Material      = material;
+        command.Transform     = transform;
+        command.PrevTransform = prevTransform;
+        command.BoxMin        = boxMin;
+        command.BoxMax        = boxMax;
+        command.LOD           = selectLOD(mesh, transform, boxMin, boxMax);
+
+        // if material requires alpha support, add it to alpha render commands
+        // for later rendering.
+        if (material->Blend)
+        {
+            material->Type  = MATERIAL_CUSTOM;
+            command.SortKey = sortKey(mesh, material);
+            m_AlphaRenderCommands.push_back(command);
+        }
+        else
+        {
+            // check the type of the material and process differently where
+            // necessary
+            if (material->Type == MATERIAL_DEFAULT)
+            {
+                command.SortKey = sortKey(mesh, material);
+                m_DeferredRenderCommands.push_back(command);
+            }
+            else if (material->Type == MATERIAL_CUSTOM)
+            {
+                command.SortKey = sortKey(mesh, material);
+                m_CustomRenderCommands[target].push_back(command);
+            }
+            else if (material->Type == MATERIAL_POST_PROCESS)
+            {
+                m_PostProcessingRenderCommands.push_back(command);
+            }
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    void CommandBuffer::Clear()
+    {
+        m_DeferredRenderCommands.clear();
+        m_AlphaRenderCommands.clear();
+        m_PostProcessingRenderCommands.clear();
+        // keep the per-target vectors (and their capacity) around
+        for (auto it = m_CustomRenderCommands.begin(); it != m_CustomRenderCommands.end(); ++it)
+            it->second.clear();
+    }
+    // --------------------------------------------------------------------------------------------
+    void CommandBuffer::Sort()
+    {
+        // opaque commands are ordered by their key so programs switch least
+        // often, followed by materials; commands of identical materials end up
+        // next to each other. Alpha and post-processing commands keep their
+        // submission order.
+        std::sort(m_DeferredRenderCommands.begin(), m_DeferredRenderCommands.end(), renderSortKey);
+        for (auto it = m_CustomRenderCommands.begin(); it != m_CustomRenderCommands.end(); ++it)
+            std::sort(it->second.begin(), it->second.end(), renderSortKey);
+    }
+    // --------------------------------------------------------------------------------------------
+    std::vector<RenderCommand> CommandBuffer::GetDeferredRenderCommands(bool cull)
+    {
+        if (!cull) return m_DeferredRenderCommands;
+
+        std::vector<RenderCommand> commands;
+        for (auto it = m_DeferredRenderCommands.begin(); it != m_DeferredRenderCommands.end(); ++it)
+        {
+            if (m_Renderer->GetCamera()->Frustum.Intersect(it->BoxMin, it->BoxMax)) commands.push_back(*it);
+        }
+        return commands;
+    }
+    // --------------------------------------------------------------------------------------------
+    std::vector<RenderCommand> CommandBuffer::GetAlphaRenderCommands(bool cull)
+    {
+        if (!cull) return m_AlphaRenderCommands;
+
+        std::vector<RenderCommand> commands;
+        for (auto it = m_AlphaRenderCommands.begin(); it != m_AlphaRenderCommands.end(); ++it)
+        {
+            if (m_Renderer->GetCamera()->Frustum.Intersect(it->BoxMin, it->BoxMax)) commands.push_back(*it);
+        }
+        return commands;
+    }
+    // --------------------------------------------------------------------------------------------
+    std::vector<RenderCommand> CommandBuffer::GetCustomRenderCommands(RenderTarget *target, bool cull)
+    {
+        // only cull commands rendered to the main (null) target
+        if (!cull || target) return m_CustomRenderCommands[target];
+
+        std::vector<RenderCommand> commands;
+        for (auto it = m_CustomRenderCommands[target].begin(); it != m_CustomRenderCommands[target].end(); ++it)
+        {
+            if (m_Renderer->GetCamera()->Frustum.Intersect(it->BoxMin, it->BoxMax)) commands.push_back(*it);
+        }
+        return commands;
+    }
+    // --------------------------------------------------------------------------------------------
+    std::vector<RenderCommand> CommandBuffer::GetPostProcessingRenderCommands() { return m_PostProcessingRenderCommands; }
+    // --------------------------------------------------------------------------------------------
+    std::vector<RenderCommand> CommandBuffer::GetShadowCastRenderCommands()
+    {
+        std::vector<RenderCommand> commands;
+        for (auto it = m_DeferredRenderCommands.begin(); it != m_DeferredRenderCommands.end(); ++it)
+        {
+            if (it->Material->ShadowCast) commands.push_back(*it);
+        }
+        for (auto it = m_CustomRenderCommands[nullptr].begin(); it != m_CustomRenderCommands[nullptr].end(); ++it)
+        {
+            if (it->Material->ShadowCast) commands.push_back(*it);
+        }
+        return commands;
+    }
+    // --------------------------------------------------------------------------------------------
+    uint64_t CommandBuffer::sortKey(Mesh *mesh, Material *material)
+    {
+        // 16 bits program | 24 bits material id | 24 bits mesh; materials with
+        // the same content share an id, so their commands sort together even
+        // if they are distinct instances.
+        uint64_t program    = material->GetShader() ? material->GetShader()->ID : 0;
+        uint64_t materialID = m_Renderer->m_MaterialLibrary->GetMaterialID(material);
+        uint64_t meshBits   = ((uintptr_t) mesh >> 4) & 0xFFFFFF;
+        return ((program & 0xFFFF) << 48) | ((materialID & 0xFFFFFF) << 24) | meshBits;
+    }
+    // --------------------------------------------------------------------------------------------
+    unsigned int CommandBuffer::selectLOD(Mesh *mesh, const glm::mat4 &transform, const glm::vec3 &boxMin, const glm::vec3 &boxMax)
+    {
+        vantor::Graphics::Camera *camera = m_Renderer->GetCamera();
+        if (!mesh || mesh->LODs.size() < 2 || !camera || m_Renderer->LODThreshold <= 0.0f) return 0;
+
+        // distance to the bounds if there are any, the origin otherwise
+        glm::vec3 center = glm::vec3(transform[3]);
+        float     radius = 0.0f;
+        if (boxMax.x - boxMin.x < 99999.0f)
+        {
+            center = 0.5f * (boxMin + boxMax);
+            radius = 0.5f * glm::length(boxMax - boxMin);
+        }
+        float distance = std::max(glm::length(center - camera->Position) - radius, camera->Near);
+
+        // world units -> pixels; Projection[1][1] is 1 / tan(fov / 2) in
+        // perspective and 2 / height in orthographic projections
+        float pixels = camera->Projection[1][1] * 0.5f * m_Renderer->GetRenderSize().y;
+        if (camera->Perspective) pixels /= distance;
+        float scale = std::max(std::max(glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1]))), glm::length(glm::vec3(transform[2])));
+
+        // coarsest level whose deviation stays below the threshold
+        unsigned int lod = 0;
+        while (lod + 1 < mesh->LODs.size() && mesh->LODs[lod + 1].Error * scale * pixels <= m_Renderer->LODThreshold)
+            ++lod;
+        return lod;
+    }
+} // namespace vantor::Graphics::RenderDevice::OpenGL
@@ -23,6 +23,7 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <cstdint>
 #include <vector>
 #include <map>
 
@@ -47,6 +48,20 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             Material *Material;
             glm::vec3 BoxMin;
             glm::vec3 BoxMax;
+            // program | material id | mesh, see CommandBuffer::Push
+            uint64_t SortKey = 0;
+            // index into Mesh::LODs, picked from the projected size on push
+            unsigned int LOD = 0;
+    };
+
+    // the layout glMultiDrawElementsIndirect reads its commands in
+    struct IndirectDrawCommand
+    {
+            unsigned int Count;
+            unsigned int InstanceCount;
+            unsigned int FirstIndex;
+            int          BaseVertex;
+            unsigned int BaseInstance;
     };
 
     class CommandBuffer
@@ -80,5 +95,9 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             std::vector<RenderCommand> GetCustomRenderCommands(RenderTarget *target, bool cull = false);
             std::vector<RenderCommand> GetPostProcessingRenderCommands();
             std::vector<RenderCommand> GetShadowCastRenderCommands();
+
+        private:
+            uint64_t     sortKey(Mesh *mesh, Material *material);
+            unsigned int selectLOD(Mesh *mesh, const glm::mat4 &transform, const glm::vec3 &boxMin, const glm::vec3 &boxMax);
     };
 } // namespace vantor::Graphics::RenderDevice::OpenGL
\ No newline at end of file
@@ -0,0 +1,283 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLDynamicMesh.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorOpenGLDynamicMesh.hpp"
+#include "vantorOpenGLExtensions.hpp"
+#include "../../../Core/BackLog/vantorBacklog.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    namespace
+    {
+        // attribute size in bytes by location: position, uv, normal, tangent, bitangent
+        constexpr size_t ATTRIBUTE_SIZE[5] = {12, 8, 12, 12, 12};
+
+        // a region only ever waits for the frame drawn from it FRAMES commits
+        // ago, which is usually long done
+        void waitFence(GLsync &fence)
+        {
+            if (!fence) return;
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+                ;
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    } // namespace
+    // --------------------------------------------------------------------------------------------
+    DynamicMesh::DynamicMesh()
+    {
+        Format      = VERTEX_FLOAT;
+        m_IndexType = GL_UNSIGNED_INT;
+    }
+    // --------------------------------------------------------------------------------------------
+    DynamicMesh::~DynamicMesh() { release(); }
+    // --------------------------------------------------------------------------------------------
+    void DynamicMesh::Invalidate(unsigned int first, unsigned int count)
+    {
+        if (count == 0) return;
+        for (Region &region : m_Regions)
+        {
+            if (region.DirtyFirst == region.DirtyLast)
+            {
+                region.DirtyFirst = first;
+                region.DirtyLast  = first + count;
+            }
+            else
+            {
+                region.DirtyFirst = std::min(region.DirtyFirst, first);
+                region.DirtyLast  = std::max(region.DirtyLast, first + count);
+            }
+        }
+        m_Pending = true;
+    }
+    // --------------------------------------------------------------------------------------------
+    void DynamicMesh::InvalidateIndices()
+    {
+        for (Region &region : m_Regions)
+            region.IndicesDirty = true;
+        m_Pending = true;
+    }
+    // --------------------------------------------------------------------------------------------
+    void DynamicMesh::Invalidate()
+    {
+        Invalidate(0, Positions.size());
+        InvalidateIndices();
+    }
+    // --------------------------------------------------------------------------------------------
+    void DynamicMesh::Commit()
+    {
+        if (!m_Pending) return;
+        m_Pending = false;
+
+        if (Positions.size() > m_VertexCapacity || Indices.size() > m_IndexCapacity || attributeMask() != m_Attributes)
+        {
+            // geometric growth keeps steadily growing meshes from
+            // reallocating every frame
+            unsigned int vertices = Positions.size() > m_VertexCapacity ? std::max<unsigned int>(Positions.size(), m_VertexCapacity * 2) : m_VertexCapacity;
+            unsigned int indices  = Indices.size() > m_IndexCapacity ? std::max<unsigned int>(Indices.size(), m_IndexCapacity * 2) : m_IndexCapacity;
+            allocate(std::max(vertices, 64u), std::max(indices, 64u));
+        }
+
+        // the region drawn until now is done once the GPU gets past here
+        Region &previous = m_Regions[m_Current];
+        if (previous.Fence) glDeleteSync(previous.Fence);
+        previous.Fence = Extensions::BufferStorage ? glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : nullptr;
+
+        m_Current      = (m_Current + 1) % FRAMES;
+        Region &region = m_Regions[m_Current];
+        waitFence(region.Fence);
+
+        writeVertices(region);
+        writeIndices(region);
+
+        m_VAO         = region.VAO;
+        m_VBO         = region.VBO;
+        m_EBO         = region.EBO;
+        m_VertexCount = Positions.size();
+        m_IndexCount  = Indices.size();
+    }
+    // --------------------------------------------------------------------------------------------
+    void DynamicMesh::Finalize(bool /*interleaved*/)
+    {
+        Invalidate();
+        Commit();
+    }
+    // --------------------------------------------------------------------------------------------
+    void DynamicMesh::Upload(const VertexLayout * /*layout*/,
+                             unsigned int /*attributes*/,
+                             const void * /*vertices*/,
+                             size_t /*vertexBytes*/,
+                             unsigned int /*vertexCount*/,
+                             const void * /*indices*/,
+                             GLenum /*indexType*/,
+                             unsigned int /*indexCount*/)
+    {
+        vantor::Backlog::Log("OpenGLDynamicMesh", "Dynamic meshes are uploaded from their attributes through Commit(), ignoring Upload().",
+                             vantor::Backlog::LogLevel::WARNING);
+    }
+    // --------------------------------------------------------------------------------------------
+    void DynamicMesh::allocate(unsigned int vertices, unsigned int indices)
+    {
+        release();
+
+        m_VertexCapacity = vertices;
+        m_IndexCapacity  = indices;
+        m_Attributes     = attributeMask();
+        m_VertexSize     = 0;
+        for (unsigned int location = 0; location < 5; ++location)
+            if (m_Attributes & (1 << location)) m_VertexSize += ATTRIBUTE_SIZE[location];
+
+        const GLsizeiptr vertexBytes = m_VertexSize * vertices;
+        const GLsizeiptr indexBytes  = sizeof(unsigned int) * indices;
+        const GLbitfield access      = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+        // dynamic storage keeps glBufferSubData working should mapping fail
+        const GLbitfield storage = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_DYNAMIC_STORAGE_BIT;
+
+        for (Region &region : m_Regions)
+        {
+            glGenVertexArrays(1, &region.VAO);
+            glGenBuffers(1, &region.VBO);
+            glGenBuffers(1, &region.EBO);
+
+            glBindVertexArray(region.VAO);
+            glBindBuffer(GL_ARRAY_BUFFER, region.VBO);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, region.EBO);
+            if (Extensions::BufferStorage)
+            {
+                glBufferStorage(GL_ARRAY_BUFFER, vertexBytes, nullptr, storage);
+                glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, indexBytes, nullptr, storage);
+                region.Vertices = (uint8_t *) glMapBufferRange(GL_ARRAY_BUFFER, 0, vertexBytes, access);
+                region.Indices  = (unsigned int *) glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, indexBytes, access);
+            }
+            else
+            {
+                glBufferData(GL_ARRAY_BUFFER, vertexBytes, nullptr, GL_DYNAMIC_DRAW);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, nullptr, GL_DYNAMIC_DRAW);
+            }
+
+            size_t offset = 0;
+            for (unsigned int location = 0; location < 5; ++location)
+            {
+                if (!(m_Attributes & (1 << location))) continue;
+                glEnableVertexAttribArray(location);
+                glVertexAttribPointer(location, ATTRIBUTE_SIZE[location] / sizeof(float), GL_FLOAT, GL_FALSE, m_VertexSize, (GLvoid *) offset);
+                offset += ATTRIBUTE_SIZE[location];
+            }
+            glBindVertexArray(0);
+
+            // new buffers hold nothing yet
+            region.DirtyFirst   = 0;
+            region.DirtyLast    = Positions.size();
+            region.IndicesDirty = true;
+        }
+
+        if (Extensions::BufferStorage && (!m_Regions[0].Vertices || !m_Regions[0].Indices))
+            vantor::Backlog::Log("OpenGLDynamicMesh", "Failed to map dynamic mesh buffers persistently.", vantor::Backlog::LogLevel::ERR);
+    }
+    // --------------------------------------------------------------------------------------------
+    void DynamicMesh::release()
+    {
+        for (Region &region : m_Regions)
+        {
+            if (region.Fence) glDeleteSync(region.Fence);
+            if (region.VAO)
+            {
+                // deleting a buffer unmaps it
+                glDeleteVertexArrays(1, &region.VAO);
+                glDeleteBuffers(1, &region.VBO);
+                glDeleteBuffers(1, &region.EBO);
+            }
+            region = Region();
+        }
+        m_VAO            = 0;
+        m_VertexCapacity = 0;
+        m_IndexCapacity  = 0;
+    }
+    // --------------------------------------------------------------------------------------------
+    unsigned int DynamicMesh::attributeMask() const
+    {
+        unsigned int mask = 1;
+        if (UV.size() > 0) mask |= 1 << 1;
+        if (Normals.size() > 0) mask |= 1 << 2;
+        if (Tangents.size() > 0) mask |= 1 << 3;
+        if (Bitangents.size() > 0) mask |= 1 << 4;
+        return mask;
+    }
+    // --------------------------------------------------------------------------------------------
+    void DynamicMesh::writeVertices(Region &region)
+    {
+        const unsigned int first = region.DirtyFirst;
+        const unsigned int last  = std::min<unsigned int>(region.DirtyLast, Positions.size());
+        region.DirtyFirst = region.DirtyLast = 0;
+        if (first >= last) return;
+
+        const size_t bytes = (last - first) * m_VertexSize;
+        uint8_t     *dst   = nullptr;
+        if (region.Vertices)
+            dst = region.Vertices + first * m_VertexSize;
+        else
+        {
+            m_Staging.resize(bytes);
+            dst = m_Staging.data();
+        }
+
+        const void *sources[5] = {Positions.data(), UV.data(), Normals.data(), Tangents.data(), Bitangents.data()};
+        size_t      offset     = 0;
+        for (unsigned int location = 0; location < 5; ++location)
+        {
+            if (!(m_Attributes & (1 << location))) continue;
+            const size_t   size = ATTRIBUTE_SIZE[location];
+            const uint8_t *src  = (const uint8_t *) sources[location] + first * size;
+            uint8_t       *out  = dst + offset;
+            for (unsigned int i = first; i < last; ++i, src += size, out += m_VertexSize)
+                std::memcpy(out, src, size);
+            offset += size;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, region.VBO);
+        if (region.Vertices)
+            glFlushMappedBufferRange(GL_ARRAY_BUFFER, first * m_VertexSize, bytes);
+        else
+            glBufferSubData(GL_ARRAY_BUFFER, first * m_VertexSize, bytes, m_Staging.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    // --------------------------------------------------------------------------------------------
+    void DynamicMesh::writeIndices(Region &region)
+    {
+        if (!region.IndicesDirty) return;
+        region.IndicesDirty = false;
+        if (Indices.empty()) return;
+
+        const size_t bytes = Indices.size() * sizeof(unsigned int);
+        // the element array binding is VAO state
+        glBindVertexArray(region.VAO);
+        if (region.Indices)
+        {
+            std::memcpy(region.Indices, Indices.data(), bytes);
+            glFlushMappedBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, bytes);
+        }
+        else
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, bytes, Indices.data());
+        glBindVertexArray(0);
+    }
+} // namespace vantor::Graphics::RenderDevice::OpenGL
@@ -0,0 +1,112 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLDynamicMesh.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include "vantorOpenGLMesh.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    /*
+
+      =================== Dynamic Mesh ====================
+
+    */
+    // Mesh for geometry the CPU rebuilds often, up to every frame (debug
+    // lines, text, animated geometry). Instead of Finalize() it's uploaded
+    // through Commit(), which writes into the next of FRAMES buffer sets so
+    // the GPU can still read the previous ones. With GL_ARB_buffer_storage the
+    // sets stay mapped persistently and fences guard their reuse; otherwise
+    // they're updated with glBufferSubData. Buffers grow geometrically and are
+    // only recreated when the mesh outgrows them or its attributes change.
+    //
+    // The CPU side arrays stay the source of truth: change them, Invalidate()
+    // what changed and Commit() before drawing. Vertices are always stored
+    // as interleaved floats with 32 bit indices.
+    class DynamicMesh : public Mesh
+    {
+        public:
+            static constexpr unsigned int FRAMES = 3;
+
+        private:
+            struct Region
+            {
+                    unsigned int VAO = 0;
+                    unsigned int VBO = 0;
+                    unsigned int EBO = 0;
+                    // persistent mappings, null without GL_ARB_buffer_storage
+                    uint8_t      *Vertices = nullptr;
+                    unsigned int *Indices  = nullptr;
+                    // signaled once the GPU is done with the last frame drawn from here
+                    GLsync Fence = nullptr;
+                    // vertices [DirtyFirst, DirtyLast) are outdated here
+                    unsigned int DirtyFirst   = 0;
+                    unsigned int DirtyLast    = 0;
+                    bool         IndicesDirty = false;
+            };
+
+            Region       m_Regions[FRAMES];
+            unsigned int m_Current        = 0;
+            unsigned int m_VertexCapacity = 0;
+            unsigned int m_IndexCapacity  = 0;
+            unsigned int m_Attributes     = 0; // bit per attribute location in the buffers
+            size_t       m_VertexSize     = 0;
+            bool         m_Pending        = false;
+
+            std::vector<uint8_t> m_Staging; // without persistent mappings
+
+        public:
+            DynamicMesh();
+            ~DynamicMesh();
+
+            // vertices [first, first + count) changed
+            void Invalidate(unsigned int first, unsigned int count);
+            void InvalidateIndices();
+            // all vertices and indices changed, e.g. after rebuilding the mesh
+            void Invalidate();
+
+            // moves on to the next buffer set and brings it up to date; does
+            // nothing if nothing was invalidated since the last call.
+            void Commit();
+
+            // the base upload paths would replace the buffer sets with a
+            // single static one: Finalize() invalidates everything and
+            // commits (always interleaved), Upload() is refused.
+            void Finalize(bool interleaved = true) override;
+            void Upload(const VertexLayout *layout,
+                        unsigned int        attributes,
+                        const void         *vertices,
+                        size_t              vertexBytes,
+                        unsigned int        vertexCount,
+                        const void         *indices,
+                        GLenum              indexType,
+                        unsigned int        indexCount) override;
+
+        private:
+            void         allocate(unsigned int vertices, unsigned int indices);
+            void         release();
+            unsigned int attributeMask() const;
+            void         writeVertices(Region &region);
+            void         writeIndices(Region &region);
+    };
+} // namespace vantor::Graphics::RenderDevice::OpenGL
@@ -0,0 +1,81 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLExtensions.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorOpenGLExtensions.hpp"
+#include "../../../Core/BackLog/vantorBacklog.h"
+
+#include <cstring>
+
+namespace vantor::Graphics::RenderDevice::OpenGL::Extensions
+{
+    bool ParallelShaderCompile  = false;
+    bool BindlessTexture        = false;
+    bool BufferStorage          = false;
+    bool TextureCompressionS3TC = false;
+
+    PFNMAXSHADERCOMPILERTHREADSPROC     MaxShaderCompilerThreads     = nullptr;
+    PFNGETTEXTUREHANDLEPROC             GetTextureHandle             = nullptr;
+    PFNMAKETEXTUREHANDLERESIDENTPROC    MakeTextureHandleResident    = nullptr;
+    PFNMAKETEXTUREHANDLENONRESIDENTPROC MakeTextureHandleNonResident = nullptr;
+    // --------------------------------------------------------------------------------------------
+    void Load(GLADloadproc load)
+    {
+        // KHR and ARB variants share enums and semantics
+        if (IsSupported("GL_KHR_parallel_shader_compile"))
+            MaxShaderCompilerThreads = (PFNMAXSHADERCOMPILERTHREADSPROC) load("glMaxShaderCompilerThreadsKHR");
+        else if (IsSupported("GL_ARB_parallel_shader_compile"))
+            MaxShaderCompilerThreads = (PFNMAXSHADERCOMPILERTHREADSPROC) load("glMaxShaderCompilerThreadsARB");
+        ParallelShaderCompile = MaxShaderCompilerThreads != nullptr;
+
+        if (ParallelShaderCompile)
+        {
+            // let the driver pick as many compiler threads as it sees fit
+            MaxShaderCompilerThreads(0xFFFFFFFF);
+            vantor::Backlog::Log("OpenGLExtensions", "Parallel shader compilation enabled.", vantor::Backlog::LogLevel::INFO);
+        }
+
+        if (IsSupported("GL_ARB_bindless_texture"))
+        {
+            GetTextureHandle             = (PFNGETTEXTUREHANDLEPROC) load("glGetTextureHandleARB");
+            MakeTextureHandleResident    = (PFNMAKETEXTUREHANDLERESIDENTPROC) load("glMakeTextureHandleResidentARB");
+            MakeTextureHandleNonResident = (PFNMAKETEXTUREHANDLENONRESIDENTPROC) load("glMakeTextureHandleNonResidentARB");
+        }
+        BindlessTexture = GetTextureHandle && MakeTextureHandleResident && MakeTextureHandleNonResident;
+
+        // core since 4.4; glad only loads it on 4.4+ contexts, so on older
+        // ones with the ARB extension the entry point may still be missing
+        BufferStorage = (GLAD_GL_VERSION_4_4 || IsSupported("GL_ARB_buffer_storage")) && glBufferStorage != nullptr;
+
+        // no entry points, only formats; universal on desktop GL but never core
+        TextureCompressionS3TC = IsSupported("GL_EXT_texture_compression_s3tc") && IsSupported("GL_EXT_texture_sRGB");
+    }
+    // --------------------------------------------------------------------------------------------
+    bool IsSupported(const char *name)
+    {
+        int count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (int i = 0; i < count; ++i)
+        {
+            const char *extension = (const char *) glGetStringi(GL_EXTENSIONS, i);
+            if (extension && std::strcmp(extension, name) == 0) return true;
+        }
+        return false;
+    }
+} // namespace vantor::Graphics::RenderDevice::OpenGL::Extensions
@@ -0,0 +1,73 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLExtensions.hpp
+ *  Last Change: Automatically updated
+ */
+
+// The bundled glad is generated for the core profile only, so the optional
+// extensions the renderer makes use of are detected and loaded here.
+
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+// GL_EXT_texture_compression_s3tc / GL_EXT_texture_sRGB
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+namespace vantor::Graphics::RenderDevice::OpenGL::Extensions
+{
+    typedef void (*PFNMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+    typedef uint64_t (*PFNGETTEXTUREHANDLEPROC)(GLuint texture);
+    typedef void (*PFNMAKETEXTUREHANDLERESIDENTPROC)(uint64_t handle);
+    typedef void (*PFNMAKETEXTUREHANDLENONRESIDENTPROC)(uint64_t handle);
+
+    // availability flags; valid after Load()
+    extern bool ParallelShaderCompile;
+    extern bool BindlessTexture;
+    extern bool BufferStorage; // glBufferStorage, through glad
+    extern bool TextureCompressionS3TC; // BC1-3, including the sRGB variants
+
+    // entry points; null if the extension is not available
+    extern PFNMAXSHADERCOMPILERTHREADSPROC     MaxShaderCompilerThreads;
+    extern PFNGETTEXTUREHANDLEPROC             GetTextureHandle;
+    extern PFNMAKETEXTUREHANDLERESIDENTPROC    MakeTextureHandleResident;
+    extern PFNMAKETEXTUREHANDLENONRESIDENTPROC MakeTextureHandleNonResident;
+
+    // must be called once after glad is initialized, with the same loader
+    void Load(GLADloadproc load);
+    bool IsSupported(const char *name);
+} // namespace vantor::Graphics::RenderDevice::OpenGL::Extensions
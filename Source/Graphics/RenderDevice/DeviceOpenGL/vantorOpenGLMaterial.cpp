@@ -24,141 +24,608 @@
 
 #include "vantorOpenGLShader.hpp"
 #include "vantorOpenGLTexture.hpp"
+#include "vantorOpenGLMaterialTextures.hpp"
+#include "../../../Core/BackLog/vantorBacklog.h"
+
+#include <cstring>
 
 namespace vantor::Graphics::RenderDevice::OpenGL
 {
+    namespace
+    {
+        // 64-bit FNV-1a
+        uint64_t hashBytes(uint64_t hash, const void *data, std::size_t size)
+        {
+            const uint8_t *bytes = (const uint8_t *) data;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        template <typename T> uint64_t hashValue(uint64_t hash, const T &value) { return hashBytes(hash, &value, sizeof(T)); }
+
+        // bytes of the union actually in use for type
+        std::size_t valueSize(SHADER_TYPE type)
+        {
+            switch (type)
+            {
+                case SHADER_TYPE_BOOL:
+                    return sizeof(bool);
+                case SHADER_TYPE_INT:
+                    return sizeof(int);
+                case SHADER_TYPE_FLOAT:
+                    return sizeof(float);
+                case SHADER_TYPE_VEC2:
+                    return sizeof(glm::vec2);
+                case SHADER_TYPE_VEC3:
+                    return sizeof(glm::vec3);
+                case SHADER_TYPE_VEC4:
+                    return sizeof(glm::vec4);
+                case SHADER_TYPE_MAT2:
+                    return sizeof(glm::mat2);
+                case SHADER_TYPE_MAT3:
+                    return sizeof(glm::mat3);
+                case SHADER_TYPE_MAT4:
+                    return sizeof(glm::mat4);
+                default:
+                    return 0;
+            }
+        }
+
+        constexpr uint64_t HASH_SEED = 14695981039346656037ull;
+    } // namespace
+
     // --------------------------------------------------------------------------------------------
     Material::Material() {}
     // --------------------------------------------------------------------------------------------
     Material::Material(Shader *shader) { m_Shader = shader; }
     // --------------------------------------------------------------------------------------------
-    Shader *Material::GetShader() { return m_Shader; }
+    Material::Material(Material *base)
+    {
+        m_Base   = base;
+        m_Shader = base->m_Shader;
+
+        Type  = base->Type;
+        Color = base->Color;
+
+        DepthTest    = base->DepthTest;
+        DepthWrite   = base->DepthWrite;
+        DepthCompare = base->DepthCompare;
+
+        Cull             = base->Cull;
+        CullFace         = base->CullFace;
+        CullWindingOrder = base->CullWindingOrder;
+
+        Blend         = base->Blend;
+        BlendSrc      = base->BlendSrc;
+        BlendDst      = base->BlendDst;
+        BlendEquation = base->BlendEquation;
+
+        ShadowCast    = base->ShadowCast;
+        ShadowReceive = base->ShadowReceive;
+    }
     // --------------------------------------------------------------------------------------------
-    void Material::SetShader(Shader *shader) { m_Shader = shader; }
+    Material::Material(const Material &other) { *this = other; }
     // --------------------------------------------------------------------------------------------
-    Material Material::Copy()
+    Material &Material::operator=(const Material &other)
     {
-        Material copy(m_Shader);
+        if (this == &other) return *this;
+
+        m_Shader       = other.m_Shader;
+        m_Base         = other.m_Base;
+        m_Parameters   = other.m_Parameters;
+        m_SamplerCount = other.m_SamplerCount;
+        for (unsigned int i = 0; i < m_SamplerCount; ++i)
+            m_Samplers[i] = other.m_Samplers[i];
+
+        // keep our own buffer (if any), it is re-filled on the next bind
+        m_BlockShader   = nullptr;
+        m_BlockSamplers = 0;
+        touch();
 
-        copy.Type = Type;
+        Type  = other.Type;
+        Color = other.Color;
 
-        copy.Color = Color;
+        DepthTest    = other.DepthTest;
+        DepthWrite   = other.DepthWrite;
+        DepthCompare = other.DepthCompare;
 
-        copy.DepthTest    = DepthTest;
-        copy.DepthWrite   = DepthWrite;
-        copy.DepthCompare = DepthCompare;
+        Cull             = other.Cull;
+        CullFace         = other.CullFace;
+        CullWindingOrder = other.CullWindingOrder;
 
-        copy.Cull             = Cull;
-        copy.CullFace         = CullFace;
-        copy.CullWindingOrder = CullWindingOrder;
+        Blend         = other.Blend;
+        BlendSrc      = other.BlendSrc;
+        BlendDst      = other.BlendDst;
+        BlendEquation = other.BlendEquation;
 
-        copy.Blend         = Blend;
-        copy.BlendSrc      = BlendSrc;
-        copy.BlendDst      = BlendDst;
-        copy.BlendEquation = BlendEquation;
+        ShadowCast    = other.ShadowCast;
+        ShadowReceive = other.ShadowReceive;
+
+        return *this;
+    }
+    // --------------------------------------------------------------------------------------------
+    Material::~Material()
+    {
+        if (m_ParameterUBO) glDeleteBuffers(1, &m_ParameterUBO);
+    }
+    // --------------------------------------------------------------------------------------------
+    Shader *Material::GetShader() { return m_Shader; }
+    // --------------------------------------------------------------------------------------------
+    void Material::SetShader(Shader *shader)
+    {
+        m_Shader = shader;
+        touch();
+    }
+    // --------------------------------------------------------------------------------------------
+    Material Material::Copy()
+    {
+        Material copy(*this);
+        if (!m_Base) return copy;
 
-        copy.m_Uniforms        = m_Uniforms;
-        copy.m_SamplerUniforms = m_SamplerUniforms;
+        // flatten: pull in everything the template provides
+        copy.m_Base = nullptr;
+        copy.m_Parameters.clear();
+        std::vector<const MaterialParameter *> parameters;
+        gatherParameters(parameters);
+        for (unsigned int i = 0; i < parameters.size(); ++i)
+            copy.m_Parameters.push_back(*parameters[i]);
 
+        const MaterialSampler *samplers[MAX_SAMPLERS];
+        copy.m_SamplerCount = gatherSamplers(samplers);
+        for (unsigned int i = 0; i < copy.m_SamplerCount; ++i)
+            copy.m_Samplers[i] = *samplers[i];
         return copy;
     }
     // --------------------------------------------------------------------------------------------
-    void Material::SetBool(std::string name, bool value)
+    void Material::SetBool(std::string_view name, bool value)
     {
-        m_Uniforms[name].Type = SHADER_TYPE_BOOL;
-        m_Uniforms[name].Bool = value;
+        UniformValue uniform;
+        uniform.Type = SHADER_TYPE_BOOL;
+        uniform.Bool = value;
+        setParameter(name, uniform);
     }
     // --------------------------------------------------------------------------------------------
-    void Material::SetInt(std::string name, int value)
+    void Material::SetInt(std::string_view name, int value)
     {
-        m_Uniforms[name].Type = SHADER_TYPE_INT;
-        m_Uniforms[name].Int  = value;
+        UniformValue uniform;
+        uniform.Type = SHADER_TYPE_INT;
+        uniform.Int  = value;
+        setParameter(name, uniform);
     }
     // --------------------------------------------------------------------------------------------
-    void Material::SetFloat(std::string name, float value)
+    void Material::SetFloat(std::string_view name, float value)
     {
-        m_Uniforms[name].Type  = SHADER_TYPE_FLOAT;
-        m_Uniforms[name].Float = value;
+        UniformValue uniform;
+        uniform.Type  = SHADER_TYPE_FLOAT;
+        uniform.Float = value;
+        setParameter(name, uniform);
     }
     // --------------------------------------------------------------------------------------------
-    void Material::SetTexture(std::string name, Texture *value, unsigned int unit)
+    void Material::SetTexture(std::string_view name, Texture *value, unsigned int unit)
     {
-        m_SamplerUniforms[name].Unit    = unit;
-        m_SamplerUniforms[name].Texture = value;
+        MaterialSampler *sampler = addSampler(name, unit);
+        if (!sampler) return;
 
+        sampler->Sampler.Texture = value;
         switch (value->Target)
         {
             case GL_TEXTURE_1D:
-                m_SamplerUniforms[name].Type = SHADER_TYPE_SAMPLER1D;
+                sampler->Sampler.Type = SHADER_TYPE_SAMPLER1D;
                 break;
             case GL_TEXTURE_2D:
-                m_SamplerUniforms[name].Type = SHADER_TYPE_SAMPLER2D;
+                sampler->Sampler.Type = SHADER_TYPE_SAMPLER2D;
                 break;
             case GL_TEXTURE_3D:
-                m_SamplerUniforms[name].Type = SHADER_TYPE_SAMPLER3D;
+                sampler->Sampler.Type = SHADER_TYPE_SAMPLER3D;
                 break;
             case GL_TEXTURE_CUBE_MAP:
-                m_SamplerUniforms[name].Type = SHADER_TYPE_SAMPLERCUBE;
+                sampler->Sampler.Type = SHADER_TYPE_SAMPLERCUBE;
                 break;
         }
+    }
+    // --------------------------------------------------------------------------------------------
+    void Material::SetTextureCube(std::string_view name, TextureCube *value, unsigned int unit)
+    {
+        MaterialSampler *sampler = addSampler(name, unit);
+        if (!sampler) return;
 
-        if (m_Shader)
+        sampler->Sampler.Type        = SHADER_TYPE_SAMPLERCUBE;
+        sampler->Sampler.TextureCube = value;
+    }
+    // ------------------------------------------------------------------------
+    void Material::SetVector(std::string_view name, const glm::vec2 &value)
+    {
+        UniformValue uniform;
+        uniform.Type = SHADER_TYPE_VEC2;
+        uniform.Vec2 = value;
+        setParameter(name, uniform);
+    }
+    // ------------------------------------------------------------------------
+    void Material::SetVector(std::string_view name, const glm::vec3 &value)
+    {
+        UniformValue uniform;
+        uniform.Type = SHADER_TYPE_VEC3;
+        uniform.Vec3 = value;
+        setParameter(name, uniform);
+    }
+    // ------------------------------------------------------------------------
+    void Material::SetVector(std::string_view name, const glm::vec4 &value)
+    {
+        UniformValue uniform;
+        uniform.Type = SHADER_TYPE_VEC4;
+        uniform.Vec4 = value;
+        setParameter(name, uniform);
+    }
+    // ------------------------------------------------------------------------
+    void Material::SetMatrix(std::string_view name, const glm::mat2 &value)
+    {
+        UniformValue uniform;
+        uniform.Type = SHADER_TYPE_MAT2;
+        uniform.Mat2 = value;
+        setParameter(name, uniform);
+    }
+    // ------------------------------------------------------------------------
+    void Material::SetMatrix(std::string_view name, const glm::mat3 &value)
+    {
+        UniformValue uniform;
+        uniform.Type = SHADER_TYPE_MAT3;
+        uniform.Mat3 = value;
+        setParameter(name, uniform);
+    }
+    // ------------------------------------------------------------------------
+    void Material::SetMatrix(std::string_view name, const glm::mat4 &value)
+    {
+        UniformValue uniform;
+        uniform.Type = SHADER_TYPE_MAT4;
+        uniform.Mat4 = value;
+        setParameter(name, uniform);
+    }
+    // ------------------------------------------------------------------------
+    Texture *Material::GetTexture(std::string_view name)
+    {
+        MaterialSampler *sampler = findSampler(vantor::Helpers::hashID(name));
+        if (!sampler) return m_Base ? m_Base->GetTexture(name) : nullptr;
+        if (sampler->Sampler.Type == SHADER_TYPE_SAMPLERCUBE) return nullptr;
+        return sampler->Sampler.Texture;
+    }
+    // ------------------------------------------------------------------------
+    TextureCube *Material::GetTextureCube(std::string_view name)
+    {
+        MaterialSampler *sampler = findSampler(vantor::Helpers::hashID(name));
+        if (!sampler) return m_Base ? m_Base->GetTextureCube(name) : nullptr;
+        if (sampler->Sampler.Type != SHADER_TYPE_SAMPLERCUBE) return nullptr;
+        return sampler->Sampler.TextureCube;
+    }
+    // ------------------------------------------------------------------------
+    uint64_t Material::GetHash()
+    {
+        if (m_HashVersion != m_Version || (m_Base && m_HashBaseVersion != m_Base->m_Version))
         {
-            m_Shader->Use();
-            m_Shader->SetInt(name, unit);
+            // entries are summed so the order they were set in doesn't matter
+            uint64_t                               content = hashValue(HASH_SEED, m_Shader);
+            std::vector<const MaterialParameter *> parameters;
+            gatherParameters(parameters);
+            for (unsigned int i = 0; i < parameters.size(); ++i)
+            {
+                uint64_t entry = hashValue(HASH_SEED, parameters[i]->ID.Hash);
+                entry          = hashValue(entry, parameters[i]->Value.Type);
+                content += hashBytes(entry, &parameters[i]->Value.Bool, valueSize(parameters[i]->Value.Type));
+            }
+
+            const MaterialSampler *samplers[MAX_SAMPLERS];
+            unsigned int           count = gatherSamplers(samplers);
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                uint64_t entry = hashValue(HASH_SEED, samplers[i]->ID.Hash);
+                entry          = hashValue(entry, samplers[i]->Sampler.Unit);
+                entry          = hashValue(entry, samplers[i]->Sampler.Type);
+                content += hashValue(entry, (const void *) samplers[i]->Sampler.Texture);
+            }
+
+            m_ContentHash     = content;
+            m_HashVersion     = m_Version;
+            m_HashBaseVersion = m_Base ? m_Base->m_Version : 0;
         }
+
+        // render state is public and changed directly, so it's never cached
+        uint64_t hash = hashValue(m_ContentHash, Type);
+        hash          = hashValue(hash, Color);
+        hash          = hashValue(hash, DepthTest);
+        hash          = hashValue(hash, DepthWrite);
+        hash          = hashValue(hash, DepthCompare);
+        hash          = hashValue(hash, Cull);
+        hash          = hashValue(hash, CullFace);
+        hash          = hashValue(hash, CullWindingOrder);
+        hash          = hashValue(hash, Blend);
+        hash          = hashValue(hash, BlendSrc);
+        hash          = hashValue(hash, BlendDst);
+        hash          = hashValue(hash, BlendEquation);
+        hash          = hashValue(hash, ShadowCast);
+        hash          = hashValue(hash, ShadowReceive);
+        return hash;
     }
-    // --------------------------------------------------------------------------------------------
-    void Material::SetTextureCube(std::string name, TextureCube *value, unsigned int unit)
+    // ------------------------------------------------------------------------
+    void Material::Bind(Shader *shader)
     {
-        m_SamplerUniforms[name].Unit        = unit;
-        m_SamplerUniforms[name].Type        = SHADER_TYPE_SAMPLERCUBE;
-        m_SamplerUniforms[name].TextureCube = value;
+        // an instance that overrides nothing draws exactly like its template
+        // and shares its parameter block
+        if (m_Base && m_Parameters.empty() && m_SamplerCount == 0 && m_Shader == m_Base->m_Shader)
+        {
+            m_Base->Bind(shader);
+            return;
+        }
+
+        // a fallback program has its own notion of parameters
+        bool own = shader == m_Shader;
+        if (own && needsPacking(shader)) packParameters(shader);
 
-        if (m_Shader)
+        const MaterialSampler *samplers[MAX_SAMPLERS];
+        unsigned int           count = gatherSamplers(samplers);
+        for (unsigned int i = 0; i < count; ++i)
         {
-            m_Shader->Use();
-            m_Shader->SetInt(name, unit);
+            if (own && (m_BlockSamplers & (1u << i))) continue;
+
+            // the unit is program state too, and the program may be shared
+            // with materials using other units for the same sampler
+            const UniformValueSampler &sampler = samplers[i]->Sampler;
+            shader->SetInt(samplers[i]->ID, sampler.Unit);
+            if (sampler.Type == SHADER_TYPE_SAMPLERCUBE)
+                sampler.TextureCube->Bind(sampler.Unit);
+            else
+                sampler.Texture->Bind(sampler.Unit);
+        }
+
+        if (!own) return;
+
+        if (m_UBOSize > 0) glBindBufferRange(GL_UNIFORM_BUFFER, UBO_BINDING_MATERIAL, m_ParameterUBO, 0, m_UBOSize);
+
+        // the program may be shared with other materials, so loose uniforms
+        // have to be set on every bind
+        for (unsigned int i = 0; i < m_LooseParameters.size(); ++i)
+        {
+            const MaterialParameter &parameter = *m_LooseParameters[i];
+            switch (parameter.Value.Type)
+            {
+                case SHADER_TYPE_BOOL:
+                    shader->SetBool(parameter.ID, parameter.Value.Bool);
+                    break;
+                case SHADER_TYPE_INT:
+                    shader->SetInt(parameter.ID, parameter.Value.Int);
+                    break;
+                case SHADER_TYPE_FLOAT:
+                    shader->SetFloat(parameter.ID, parameter.Value.Float);
+                    break;
+                case SHADER_TYPE_VEC2:
+                    shader->SetVector(parameter.ID, parameter.Value.Vec2);
+                    break;
+                case SHADER_TYPE_VEC3:
+                    shader->SetVector(parameter.ID, parameter.Value.Vec3);
+                    break;
+                case SHADER_TYPE_VEC4:
+                    shader->SetVector(parameter.ID, parameter.Value.Vec4);
+                    break;
+                case SHADER_TYPE_MAT2:
+                    shader->SetMatrix(parameter.ID, parameter.Value.Mat2);
+                    break;
+                case SHADER_TYPE_MAT3:
+                    shader->SetMatrix(parameter.ID, parameter.Value.Mat3);
+                    break;
+                case SHADER_TYPE_MAT4:
+                    shader->SetMatrix(parameter.ID, parameter.Value.Mat4);
+                    break;
+                default:
+                    vantor::Backlog::Log("OpenGLMaterial", "Unrecognized Uniform type set.", vantor::Backlog::LogLevel::ERR);
+                    break;
+            }
         }
     }
     // ------------------------------------------------------------------------
-    void Material::SetVector(std::string name, glm::vec2 value)
+    void Material::touch()
     {
-        m_Uniforms[name].Type = SHADER_TYPE_VEC2;
-        m_Uniforms[name].Vec2 = value;
+        m_Dirty = true;
+        ++m_Version;
     }
     // ------------------------------------------------------------------------
-    void Material::SetVector(std::string name, glm::vec3 value)
+    void Material::setParameter(std::string_view name, const UniformValue &value)
     {
-        m_Uniforms[name].Type = SHADER_TYPE_VEC3;
-        m_Uniforms[name].Vec3 = value;
+        touch();
+
+        UniformID id(name);
+        for (unsigned int i = 0; i < m_Parameters.size(); ++i)
+        {
+            if (m_Parameters[i].ID.Hash == id.Hash)
+            {
+                m_Parameters[i].Value = value;
+                return;
+            }
+        }
+        m_Parameters.push_back({id, value});
     }
     // ------------------------------------------------------------------------
-    void Material::SetVector(std::string name, glm::vec4 value)
+    MaterialSampler *Material::findSampler(unsigned int hash)
     {
-        m_Uniforms[name].Type = SHADER_TYPE_VEC4;
-        m_Uniforms[name].Vec4 = value;
+        for (unsigned int i = 0; i < m_SamplerCount; ++i)
+        {
+            if (m_Samplers[i].ID.Hash == hash) return &m_Samplers[i];
+        }
+        return nullptr;
     }
     // ------------------------------------------------------------------------
-    void Material::SetMatrix(std::string name, glm::mat2 value)
+    MaterialSampler *Material::addSampler(std::string_view name, unsigned int unit)
     {
-        m_Uniforms[name].Type = SHADER_TYPE_MAT2;
-        m_Uniforms[name].Mat2 = value;
+        UniformID        id(name);
+        MaterialSampler *sampler = findSampler(id.Hash);
+        if (!sampler)
+        {
+            if (m_SamplerCount == MAX_SAMPLERS)
+            {
+                vantor::Backlog::Log("OpenGLMaterial", "Material exceeds " + std::to_string(MAX_SAMPLERS) + " samplers, ignoring: " + std::string(name),
+                                     vantor::Backlog::LogLevel::WARNING);
+                return nullptr;
+            }
+            sampler     = &m_Samplers[m_SamplerCount++];
+            sampler->ID = id;
+        }
+        sampler->Sampler.Unit = unit;
+        touch();
+        return sampler;
     }
     // ------------------------------------------------------------------------
-    void Material::SetMatrix(std::string name, glm::mat3 value)
+    unsigned int Material::gatherSamplers(const MaterialSampler **samplers)
     {
-        m_Uniforms[name].Type = SHADER_TYPE_MAT3;
-        m_Uniforms[name].Mat3 = value;
+        unsigned int count = 0;
+        if (m_Base)
+        {
+            for (unsigned int i = 0; i < m_Base->m_SamplerCount; ++i)
+            {
+                if (!findSampler(m_Base->m_Samplers[i].ID.Hash)) samplers[count++] = &m_Base->m_Samplers[i];
+            }
+        }
+        for (unsigned int i = 0; i < m_SamplerCount && count < MAX_SAMPLERS; ++i)
+            samplers[count++] = &m_Samplers[i];
+        return count;
     }
     // ------------------------------------------------------------------------
-    void Material::SetMatrix(std::string name, glm::mat4 value)
+    void Material::gatherParameters(std::vector<const MaterialParameter *> &parameters)
     {
-        m_Uniforms[name].Type = SHADER_TYPE_MAT4;
-        m_Uniforms[name].Mat4 = value;
+        parameters.clear();
+        if (m_Base)
+        {
+            for (unsigned int i = 0; i < m_Base->m_Parameters.size(); ++i)
+            {
+                const MaterialParameter &parameter  = m_Base->m_Parameters[i];
+                bool                     overridden = false;
+                for (unsigned int j = 0; j < m_Parameters.size() && !overridden; ++j)
+                    overridden = m_Parameters[j].ID.Hash == parameter.ID.Hash;
+                if (!overridden) parameters.push_back(&parameter);
+            }
+        }
+        for (unsigned int i = 0; i < m_Parameters.size(); ++i)
+            parameters.push_back(&m_Parameters[i]);
     }
     // ------------------------------------------------------------------------
-    std::map<std::string, UniformValue> *Material::GetUniforms() { return &m_Uniforms; }
+    bool Material::needsPacking(Shader *shader) const
+    {
+        // the block also depends on the template's values, and array slots
+        // of textures it references may have been handed to other textures
+        return m_Dirty || m_BlockShader != shader || m_BlockRevision != shader->Revision || (m_Base && m_BaseVersion != m_Base->m_Version) ||
+               (m_BlockSamplers && m_TextureRevision != MaterialTextures::GetRevision());
+    }
     // ------------------------------------------------------------------------
-    std::map<std::string, UniformValueSampler> *Material::GetSamplerUniforms() { return &m_SamplerUniforms; }
-} // namespace vantor::Graphics::RenderDevice::OpenGL
\ No newline at end of file
+    void Material::packParameters(Shader *shader)
+    {
+        const UniformBlockLayout &layout = shader->MaterialBlock;
+
+        m_ParameterBlock.assign(layout.Size, 0);
+
+        // loose parameters point into our (or the template's) parameter list;
+        // either changing bumps a version and causes a re-pack before use.
+        std::vector<const MaterialParameter *> parameters;
+        gatherParameters(parameters);
+        m_LooseParameters.clear();
+
+        for (unsigned int i = 0; i < parameters.size(); ++i)
+        {
+            const UniformBlockMember *member = layout.Find(parameters[i]->ID.Hash);
+            if (!member)
+            {
+                m_LooseParameters.push_back(parameters[i]);
+                continue;
+            }
+
+            const UniformValue &value = parameters[i]->Value;
+            uint8_t            *dst   = m_ParameterBlock.data() + member->Offset;
+            switch (value.Type)
+            {
+                case SHADER_TYPE_BOOL:
+                {
+                    int boolean = value.Bool; // std140 bools are 4 bytes
+                    std::memcpy(dst, &boolean, sizeof(int));
+                    break;
+                }
+                case SHADER_TYPE_INT:
+                    std::memcpy(dst, &value.Int, sizeof(int));
+                    break;
+                case SHADER_TYPE_FLOAT:
+                    std::memcpy(dst, &value.Float, sizeof(float));
+                    break;
+                case SHADER_TYPE_VEC2:
+                    std::memcpy(dst, &value.Vec2, sizeof(glm::vec2));
+                    break;
+                case SHADER_TYPE_VEC3:
+                    std::memcpy(dst, &value.Vec3, sizeof(glm::vec3));
+                    break;
+                case SHADER_TYPE_VEC4:
+                    std::memcpy(dst, &value.Vec4, sizeof(glm::vec4));
+                    break;
+                // matrix columns are padded to the reported stride (vec4 in std140)
+                case SHADER_TYPE_MAT2:
+                    for (int c = 0; c < 2; ++c)
+                        std::memcpy(dst + c * member->MatrixStride, &value.Mat2[c], sizeof(glm::vec2));
+                    break;
+                case SHADER_TYPE_MAT3:
+                    for (int c = 0; c < 3; ++c)
+                        std::memcpy(dst + c * member->MatrixStride, &value.Mat3[c], sizeof(glm::vec3));
+                    break;
+                case SHADER_TYPE_MAT4:
+                    for (int c = 0; c < 4; ++c)
+                        std::memcpy(dst + c * member->MatrixStride, &value.Mat4[c], sizeof(glm::vec4));
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // 2D textures declared inside the block are referenced from there:
+        // a sampler2D member holds a bindless handle, an ivec2 member the
+        // {array, layer} of the texture's copy in the shared texture arrays.
+        const MaterialSampler *samplers[MAX_SAMPLERS];
+        unsigned int           count = gatherSamplers(samplers);
+        m_BlockSamplers              = 0;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            const UniformBlockMember *member = layout.Find(samplers[i]->ID.Hash);
+            if (!member || samplers[i]->Sampler.Type != SHADER_TYPE_SAMPLER2D) continue;
+
+            Texture *texture = samplers[i]->Sampler.Texture;
+            uint8_t *dst     = m_ParameterBlock.data() + member->Offset;
+            if (member->Type == SHADER_TYPE_SAMPLER2D)
+            {
+                uint64_t handle = texture->GetBindlessHandle();
+                if (!handle) continue;
+                std::memcpy(dst, &handle, sizeof(uint64_t));
+            }
+            else if (member->Type == SHADER_TYPE_IVEC2)
+            {
+                TextureArraySlot slot        = MaterialTextures::Acquire(texture);
+                int              location[2] = {slot.Array, slot.Layer};
+                std::memcpy(dst, location, sizeof(location));
+            }
+            else
+                continue;
+
+            m_BlockSamplers |= 1u << i;
+        }
+
+        if (layout.Size > 0)
+        {
+            if (!m_ParameterUBO) glGenBuffers(1, &m_ParameterUBO);
+            glBindBuffer(GL_UNIFORM_BUFFER, m_ParameterUBO);
+            if (m_UBOSize != layout.Size)
+                glBufferData(GL_UNIFORM_BUFFER, layout.Size, m_ParameterBlock.data(), GL_DYNAMIC_DRAW);
+            else
+                glBufferSubData(GL_UNIFORM_BUFFER, 0, layout.Size, m_ParameterBlock.data());
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+        m_UBOSize         = layout.Size;
+        m_BlockShader     = shader;
+        m_BlockRevision   = shader->Revision;
+        m_BaseVersion     = m_Base ? m_Base->m_Version : 0;
+        m_TextureRevision = MaterialTextures::GetRevision();
+        m_Dirty           = false;
+    }
+} // namespace vantor::Graphics::RenderDevice::OpenGL
@@ -27,7 +27,9 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
-#include <map>
+#include <cstdint>
+#include <string_view>
+#include <vector>
 
 namespace vantor::Graphics::RenderDevice::OpenGL
 {
@@ -38,13 +40,60 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         MATERIAL_POST_PROCESS,
     };
 
+    // a material parameter as set by the user, packed into the shader's
+    // "Material" block (or set as loose uniform) when the material is bound.
+    struct MaterialParameter
+    {
+            UniformID    ID;
+            UniformValue Value;
+    };
+
+    struct MaterialSampler
+    {
+            UniformID           ID;
+            UniformValueSampler Sampler;
+    };
+
     class Material
     {
+        public:
+            static constexpr unsigned int MAX_SAMPLERS = 8;
+
         private:
             // shader state
-            Shader                                    *m_Shader;
-            std::map<std::string, UniformValue>        m_Uniforms;
-            std::map<std::string, UniformValueSampler> m_SamplerUniforms; // NOTE(Joey): process samplers differently
+            Shader                        *m_Shader = nullptr;
+            std::vector<MaterialParameter> m_Parameters;
+            MaterialSampler                m_Samplers[MAX_SAMPLERS];
+            unsigned int                   m_SamplerCount = 0;
+
+            // template of an instance; m_Parameters and m_Samplers then only
+            // hold what the instance overrides, everything else is read from
+            // the template (which has to outlive its instances).
+            Material *m_Base = nullptr;
+            // bumped on every change of shader, parameters or textures
+            uint32_t m_Version = 1;
+
+            // std140 image of the effective parameters for m_BlockShader's
+            // Material block; parameters the block doesn't contain are set as
+            // loose uniforms.
+            std::vector<uint8_t>                   m_ParameterBlock;
+            std::vector<const MaterialParameter *> m_LooseParameters;
+            Shader                                *m_BlockShader     = nullptr;
+            uint32_t                               m_BaseVersion     = 0; // m_Base->m_Version the block was packed against
+            uint32_t                               m_BlockRevision   = 0; // m_BlockShader->Revision, its layout changes on reload
+            uint32_t                               m_TextureRevision = 0; // MaterialTextures::GetRevision() the slots were acquired at
+            unsigned int                           m_ParameterUBO    = 0;
+            unsigned int                           m_UBOSize         = 0;
+            bool                                   m_Dirty           = true;
+            // samplers passed through the block (bindless handle or array
+            // slot) instead of a texture unit; one bit per gathered sampler.
+            uint32_t m_BlockSamplers = 0;
+
+            // content hash of shader, parameters and textures (see GetHash)
+            uint64_t m_ContentHash     = 0;
+            uint32_t m_HashVersion     = 0;
+            uint32_t m_HashBaseVersion = 0;
+
         public:
             MaterialType Type  = MATERIAL_CUSTOM;
             glm::vec4    Color = glm::vec4(1.0f);
@@ -69,29 +118,60 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             bool ShadowCast    = true;
             bool ShadowReceive = true;
 
-        private:
         public:
             Material();
             Material(Shader *shader);
+            // copy-on-write instance of base: shares its shader, parameters,
+            // textures and (as long as nothing is overridden) parameter block.
+            explicit Material(Material *base);
+            // copies never share the GPU parameter buffer
+            Material(const Material &other);
+            Material &operator=(const Material &other);
+            ~Material();
 
             Shader *GetShader();
             void    SetShader(Shader *shader);
 
+            // full copy with all of the template's parameters and textures
             Material Copy();
 
-            void SetBool(std::string name, bool value);
-            void SetInt(std::string name, int value);
-            void SetFloat(std::string name, float value);
-            void SetTexture(std::string name, Texture *value, unsigned int unit = 0);
-            void SetTextureCube(std::string name, TextureCube *value, unsigned int unit = 0);
-            void SetVector(std::string name, glm::vec2 value);
-            void SetVector(std::string name, glm::vec3 value);
-            void SetVector(std::string name, glm::vec4 value);
-            void SetMatrix(std::string name, glm::mat2 value);
-            void SetMatrix(std::string name, glm::mat3 value);
-            void SetMatrix(std::string name, glm::mat4 value);
-
-            std::map<std::string, UniformValue>        *GetUniforms();
-            std::map<std::string, UniformValueSampler> *GetSamplerUniforms();
+            void SetBool(std::string_view name, bool value);
+            void SetInt(std::string_view name, int value);
+            void SetFloat(std::string_view name, float value);
+            void SetTexture(std::string_view name, Texture *value, unsigned int unit = 0);
+            void SetTextureCube(std::string_view name, TextureCube *value, unsigned int unit = 0);
+            void SetVector(std::string_view name, const glm::vec2 &value);
+            void SetVector(std::string_view name, const glm::vec3 &value);
+            void SetVector(std::string_view name, const glm::vec4 &value);
+            void SetMatrix(std::string_view name, const glm::mat2 &value);
+            void SetMatrix(std::string_view name, const glm::mat3 &value);
+            void SetMatrix(std::string_view name, const glm::mat4 &value);
+
+            // null if no sampler of that name was set
+            Texture     *GetTexture(std::string_view name);
+            TextureCube *GetTextureCube(std::string_view name);
+
+            // hash over everything that affects drawing (shader, effective
+            // parameters and textures, render state); equal hashes mean the
+            // materials can be drawn interchangeably.
+            uint64_t GetHash();
+
+            // bind textures and parameters for drawing with shader (either the
+            // material's own one or a fallback, which only gets the textures);
+            // the parameter block is re-packed and uploaded only when dirty.
+            // Textures the block references (see MATERIAL_TEXTURE_MODE) are
+            // not bound at all.
+            void Bind(Shader *shader);
+
+        private:
+            void             touch();
+            void             setParameter(std::string_view name, const UniformValue &value);
+            MaterialSampler *findSampler(unsigned int hash);
+            MaterialSampler *addSampler(std::string_view name, unsigned int unit);
+            // template entries not overridden, followed by our own
+            unsigned int gatherSamplers(const MaterialSampler **samplers);
+            void         gatherParameters(std::vector<const MaterialParameter *> &parameters);
+            bool         needsPacking(Shader *shader) const;
+            void         packParameters(Shader *shader);
     };
 } // namespace vantor::Graphics::RenderDevice::OpenGL
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "vantorOpenGLRenderTarget.hpp"
 
 #include "vantorOpenGLMaterial.hpp"
+#include "vantorOpenGLMaterialTextures.hpp"
 #include "../../../Core/Resource/vantorResource.hpp"
 
 #include "../../../Core/BackLog/vantorBacklog.h"
@@ -46,6 +47,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             delete m_Materials[i];
         }
         delete debugLightMaterial;
+        delete fallbackMaterial;
 
         delete defaultBlitMaterial;
     }
@@ -55,8 +57,8 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         auto found = m_DefaultMaterials.find(SID(base));
         if (found != m_DefaultMaterials.end())
         {
-            Material  copy = found->second->Copy();
-            Material *mat  = new Material(copy);
+            // instances only store what they override on top of the template
+            Material *mat = new Material(found->second);
             m_Materials.push_back(mat);
             return mat;
         }
@@ -84,21 +86,66 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         return mat;
     }
     // --------------------------------------------------------------------------------------------
+    uint32_t MaterialLibrary::GetMaterialID(Material *material)
+    {
+        uint64_t hash  = material->GetHash();
+        auto     found = m_MaterialIDs.find(hash);
+        if (found != m_MaterialIDs.end())
+        {
+            found->second.Frame = m_Frame;
+            return found->second.ID;
+        }
+
+        uint32_t id;
+        if (!m_FreeMaterialIDs.empty())
+        {
+            id = m_FreeMaterialIDs.back();
+            m_FreeMaterialIDs.pop_back();
+        }
+        else
+            id = m_NextMaterialID++;
+        m_MaterialIDs[hash] = {id, m_Frame};
+        return id;
+    }
+    // --------------------------------------------------------------------------------------------
+    void MaterialLibrary::recycleMaterialIDs()
+    {
+        // a material whose parameters change every frame gets a new content
+        // hash every frame; without recycling its ids would pile up and
+        // eventually overflow the sort key's 24 bit material field.
+        for (auto it = m_MaterialIDs.begin(); it != m_MaterialIDs.end();)
+        {
+            if (it->second.Frame != m_Frame)
+            {
+                m_FreeMaterialIDs.push_back(it->second.ID);
+                it = m_MaterialIDs.erase(it);
+            }
+            else
+                ++it;
+        }
+        ++m_Frame;
+    }
+    // --------------------------------------------------------------------------------------------
     void MaterialLibrary::generateDefaultMaterials()
     {
         // default render material (deferred path)
-        Shader *defaultShader = vantor::Resources::LoadShader("default", "res/intern/shaders/deferred/g_buffer.vs", "res/intern/shaders/deferred/g_buffer.fs");
-        Material *defaultMat  = new Material(defaultShader);
-        defaultMat->Type      = MATERIAL_DEFAULT;
+        defaultShader        = vantor::Resources::LoadShader("default", "res/intern/shaders/deferred/g_buffer.vs", "res/intern/shaders/deferred/g_buffer.fs");
+        Material *defaultMat = new Material(defaultShader);
+        defaultMat->Type     = MATERIAL_DEFAULT;
         defaultMat->SetTexture("TexAlbedo", vantor::Resources::LoadTexture("default albedo", "res/intern/textures/checkerboard.png", GL_TEXTURE_2D, GL_RGB), 3);
         defaultMat->SetTexture("TexNormal", vantor::Resources::LoadTexture("default normal", "res/intern/textures/norm.png"), 4);
         defaultMat->SetTexture("TexMetallic", vantor::Resources::LoadTexture("default metallic", "res/intern/textures/black.png"), 5);
         defaultMat->SetTexture("TexRoughness", vantor::Resources::LoadTexture("default roughness", "res/intern/textures/checkerboard.png"), 6);
         m_DefaultMaterials[SID("default")] = defaultMat;
+
+        // forward materials are variants of one shader; glass and alpha blend
+        // end up with the very same program.
+        ShaderPermutations *forwardShaders = vantor::Resources::LoadShaderPermutations(
+            "forward", "res/intern/shaders/forward_render.vs", "res/intern/shaders/forward_render.fs", {"ALPHA_BLEND", "ALPHA_DISCARD"});
+        forwardShaders->Prewarm({forwardShaders->GetKeyword("ALPHA_BLEND"), forwardShaders->GetKeyword("ALPHA_DISCARD")});
+
         // glass material
-        Shader *glassShader
-            = vantor::Resources::LoadShader("glass", "res/intern/shaders/forward_render.vs", "res/intern/shaders/forward_render.fs", {"ALPHA_BLEND"});
-        glassShader->Use();
+        Shader *glassShader = forwardShaders->GetVariant({"ALPHA_BLEND"});
         glassShader->SetInt("lightShadowMap1", 10);
         glassShader->SetInt("lightShadowMap2", 10);
         glassShader->SetInt("lightShadowMap3", 10);
@@ -113,9 +160,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         glassMat->Blend                  = true;
         m_DefaultMaterials[SID("glass")] = glassMat;
         // alpha blend material
-        Shader *alphaBlendShader
-            = vantor::Resources::LoadShader("alpha blend", "res/intern/shaders/forward_render.vs", "res/intern/shaders/forward_render.fs", {"ALPHA_BLEND"});
-        alphaBlendShader->Use();
+        Shader *alphaBlendShader = forwardShaders->GetVariant({"ALPHA_BLEND"});
         alphaBlendShader->SetInt("lightShadowMap1", 10);
         alphaBlendShader->SetInt("lightShadowMap2", 10);
         alphaBlendShader->SetInt("lightShadowMap3", 10);
@@ -125,9 +170,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         alphaBlendMaterial->Blend              = true;
         m_DefaultMaterials[SID("alpha blend")] = alphaBlendMaterial;
         // alpha cutout material
-        Shader *alphaDiscardShader
-            = vantor::Resources::LoadShader("alpha discard", "res/intern/shaders/forward_render.vs", "res/intern/shaders/forward_render.fs", {"ALPHA_DISCARD"});
-        alphaDiscardShader->Use();
+        Shader *alphaDiscardShader = forwardShaders->GetVariant({"ALPHA_DISCARD"});
         alphaDiscardShader->SetInt("lightShadowMap1", 10);
         alphaDiscardShader->SetInt("lightShadowMap2", 10);
         alphaDiscardShader->SetInt("lightShadowMap3", 10);
@@ -153,7 +196,6 @@ namespace vantor::Graphics::RenderDevice::OpenGL
                                                                   "res/intern/shaders/deferred/directional.fs");
         deferredPointShader = vantor::Resources::LoadShader("deferred point", "res/intern/shaders/deferred/point.vs", "res/intern/shaders/deferred/point.fs");
 
-        deferredAmbientShader->Use();
         deferredAmbientShader->SetInt("gPositionMetallic", 0);
         deferredAmbientShader->SetInt("gNormalRoughness", 1);
         deferredAmbientShader->SetInt("gAlbedoAO", 2);
@@ -161,7 +203,6 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         deferredAmbientShader->SetInt("envPrefilter", 4);
         deferredAmbientShader->SetInt("BRDFLUT", 5);
         deferredAmbientShader->SetInt("TexSSAO", 6);
-        deferredIrradianceShader->Use();
         deferredIrradianceShader->SetInt("gPositionMetallic", 0);
         deferredIrradianceShader->SetInt("gNormalRoughness", 1);
         deferredIrradianceShader->SetInt("gAlbedoAO", 2);
@@ -169,12 +210,10 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         deferredIrradianceShader->SetInt("envPrefilter", 4);
         deferredIrradianceShader->SetInt("BRDFLUT", 5);
         deferredIrradianceShader->SetInt("TexSSAO", 6);
-        deferredDirectionalShader->Use();
         deferredDirectionalShader->SetInt("gPositionMetallic", 0);
         deferredDirectionalShader->SetInt("gNormalRoughness", 1);
         deferredDirectionalShader->SetInt("gAlbedoAO", 2);
         deferredDirectionalShader->SetInt("lightShadowMap", 3);
-        deferredPointShader->Use();
         deferredPointShader->SetInt("gPositionMetallic", 0);
         deferredPointShader->SetInt("gNormalRoughness", 1);
         deferredPointShader->SetInt("gAlbedoAO", 2);
@@ -185,5 +224,26 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         // debug
         Shader *debugLightShader = vantor::Resources::LoadShader("debug light", "res/intern/shaders/light.vs", "res/intern/shaders/light.fs");
         debugLightMaterial       = new Material(debugLightShader);
+        // its own instance, debugLightMaterial's color changes per light
+        fallbackMaterial = new Material(debugLightShader);
+        fallbackMaterial->SetVector("lightColor", glm::vec3(0.5f));
+    }
+    // --------------------------------------------------------------------------------------------
+    Material *MaterialLibrary::getFallbackMaterial(Material *material)
+    {
+        // deferred materials keep filling the g-buffer with the default
+        // program, forward materials are drawn flat with the debug light one;
+        // post-processing has no sensible substitute and is skipped.
+        switch (material->Type)
+        {
+            case MATERIAL_DEFAULT:
+                // without bound textures the default program would sample
+                // from whatever parameter block is bound
+                return MaterialTextures::GetMode() == MATERIAL_TEXTURE_BOUND ? m_DefaultMaterials[SID("default")] : nullptr;
+            case MATERIAL_CUSTOM:
+                return fallbackMaterial;
+            default:
+                return nullptr;
+        }
     }
 } // namespace vantor::Graphics::RenderDevice::OpenGL
\ No newline at end of file
@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -36,12 +38,24 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             friend Renderer;
 
         private:
-            std::map<unsigned int, Material *> m_DefaultMaterials;
-            std::vector<Material *>            m_Materials;
+            struct MaterialID
+            {
+                    uint32_t ID;
+                    uint32_t Frame; // last frame a command asked for it
+            };
+
+            std::map<unsigned int, Material *>       m_DefaultMaterials;
+            std::vector<Material *>                  m_Materials;
+            std::unordered_map<uint64_t, MaterialID> m_MaterialIDs; // content hash -> id
+            std::vector<uint32_t>                    m_FreeMaterialIDs;
+            uint32_t                                 m_NextMaterialID = 1;
+            uint32_t                                 m_Frame          = 0;
 
             // internal render-specific materials
             Material *defaultBlitMaterial;
 
+            Shader *defaultShader;
+
             Shader *deferredAmbientShader;
             Shader *deferredIrradianceShader;
             Shader *deferredDirectionalShader;
@@ -50,6 +64,8 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             Shader *dirShadowShader;
 
             Material *debugLightMaterial;
+            // drawn flat with while a custom material's program compiles
+            Material *fallbackMaterial;
 
         public:
             MaterialLibrary(RenderTarget *gBuffer);
@@ -66,11 +82,24 @@ namespace vantor::Graphics::RenderDevice::OpenGL
                                                                     // rendered in forward pass)
             Material *CreatePostProcessingMaterial(Shader *shader); // these have the post-processing flag set (will
                                                                     // be rendered after deferred/forward pass)
+
+            // small id shared by all materials with the same content hash
+            // (see Material::GetHash); used in render command sort keys. An id
+            // stays the same while its content is drawn every frame, ids of
+            // content not drawn for a frame are handed out again, so they
+            // stay below the number of distinct materials drawn in two
+            // consecutive frames. 0 is never handed out.
+            uint32_t GetMaterialID(Material *material);
         private:
+            // end of a frame: recycles the ids not asked for during it
+            void recycleMaterialIDs();
             // generate all default template materials
             void generateDefaultMaterials();
             // generate all internal materials used by the renderer; run in
             // MaterialLibrary to improve readability.
             void generateInternalMaterials(RenderTarget *gBuffer);
+            // material whose program (and parameters) to draw with while the
+            // material's own program is still compiling
+            Material *getFallbackMaterial(Material *material);
     };
 } // namespace vantor::Graphics::RenderDevice::OpenGL
\ No newline at end of file
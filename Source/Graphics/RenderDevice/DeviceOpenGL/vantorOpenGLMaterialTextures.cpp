@@ -0,0 +1,272 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLMaterialTextures.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorOpenGLMaterialTextures.hpp"
+
+#include "vantorOpenGLTexture.hpp"
+#include "vantorOpenGLExtensions.hpp"
+#include "../../../Core/BackLog/vantorBacklog.h"
+
+#include <algorithm>
+#include <string>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    MATERIAL_TEXTURE_MODE                                  MaterialTextures::m_Mode = MATERIAL_TEXTURE_BOUND;
+    std::vector<MaterialTextures::TextureArray>            MaterialTextures::m_Arrays;
+    std::unordered_map<Texture *, MaterialTextures::Entry> MaterialTextures::m_Slots;
+    uint32_t                                               MaterialTextures::m_Revision = 0;
+    // --------------------------------------------------------------------------------------------
+    void MaterialTextures::SetMode(MATERIAL_TEXTURE_MODE mode)
+    {
+        if (mode == MATERIAL_TEXTURE_BINDLESS && !Extensions::BindlessTexture)
+        {
+            vantor::Backlog::Log("OpenGLMaterialTextures", "GL_ARB_bindless_texture is not supported, using texture arrays instead.",
+                                 vantor::Backlog::LogLevel::WARNING);
+            mode = MATERIAL_TEXTURE_ARRAYS;
+        }
+        if (mode == MATERIAL_TEXTURE_ARRAYS)
+        {
+            int units = 0;
+            glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &units);
+            if (units < (int) (ARRAY_UNIT_BASE + MAX_ARRAYS))
+            {
+                vantor::Backlog::Log("OpenGLMaterialTextures", "Not enough texture units for texture arrays, binding textures per draw.",
+                                     vantor::Backlog::LogLevel::WARNING);
+                mode = MATERIAL_TEXTURE_BOUND;
+            }
+        }
+        m_Mode = mode;
+    }
+    // --------------------------------------------------------------------------------------------
+    MATERIAL_TEXTURE_MODE MaterialTextures::GetMode() { return m_Mode; }
+    // --------------------------------------------------------------------------------------------
+    const char *MaterialTextures::GetShaderDefine()
+    {
+        switch (m_Mode)
+        {
+            case MATERIAL_TEXTURE_BINDLESS:
+                return "VANTOR_BINDLESS";
+            case MATERIAL_TEXTURE_ARRAYS:
+                return "VANTOR_TEXTURE_ARRAYS";
+            default:
+                return nullptr;
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    TextureArraySlot MaterialTextures::Acquire(Texture *texture)
+    {
+        // every failure below points at the default layer, so the shader never
+        // samples a layer belonging to another material
+        if (m_Arrays.empty()) createDefaultArray();
+
+        auto found = m_Slots.find(texture);
+        if (found != m_Slots.end())
+        {
+            const Entry &entry = found->second;
+            if (entry.TextureID == texture->ID && entry.Width == texture->Width && entry.Height == texture->Height) return entry.Slot;
+            releaseSlot(entry.Slot);
+            m_Slots.erase(found);
+        }
+
+        TextureArraySlot slot;
+        if (texture->Target != GL_TEXTURE_2D || texture->Width == 0 || texture->Height == 0)
+        {
+            vantor::Backlog::Log("OpenGLMaterialTextures", "Only 2D textures can be placed in texture arrays.", vantor::Backlog::LogLevel::WARNING);
+            return slot;
+        }
+
+        // unsized formats (GL_RGBA, ...) are resolved by the driver; ask for
+        // the actual one as copies need matching formats on both sides.
+        int internalFormat = 0;
+        glBindTexture(GL_TEXTURE_2D, texture->ID);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        unsigned int levels = 1;
+        if (texture->Mipmapping)
+        {
+            unsigned int size = std::max(texture->Width, texture->Height);
+            while (size >>= 1)
+                ++levels;
+        }
+
+        // arrays are shared by textures with identical storage and sampler state
+        int index = -1;
+        int freed = -1;
+        for (unsigned int i = 1; i < m_Arrays.size(); ++i)
+        {
+            const TextureArray &array = m_Arrays[i];
+            if (!array.ID)
+            {
+                if (freed < 0) freed = i;
+                continue;
+            }
+            if (array.InternalFormat == (GLenum) internalFormat && array.Width == texture->Width && array.Height == texture->Height &&
+                array.Levels == levels && array.FilterMin == texture->FilterMin && array.FilterMax == texture->FilterMax && array.WrapS == texture->WrapS &&
+                array.WrapT == texture->WrapT && (array.Layers < LAYERS_PER_ARRAY || !array.FreeLayers.empty()))
+            {
+                index = i;
+                break;
+            }
+        }
+        if (index < 0)
+        {
+            if (freed < 0 && m_Arrays.size() == MAX_ARRAYS)
+            {
+                vantor::Backlog::Log("OpenGLMaterialTextures", "All " + std::to_string(MAX_ARRAYS) + " texture arrays are in use, using the default layer.",
+                                     vantor::Backlog::LogLevel::WARNING);
+                return slot;
+            }
+
+            TextureArray array;
+            array.InternalFormat = internalFormat;
+            array.Width          = texture->Width;
+            array.Height         = texture->Height;
+            array.Levels         = levels;
+            array.FilterMin      = texture->FilterMin;
+            array.FilterMax      = texture->FilterMax;
+            array.WrapS          = texture->WrapS;
+            array.WrapT          = texture->WrapT;
+            array.Layers         = 0;
+            array.Used           = 0;
+
+            glGenTextures(1, &array.ID);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, array.ID);
+            glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, internalFormat, array.Width, array.Height, LAYERS_PER_ARRAY);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, array.FilterMin);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, array.FilterMax);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, array.WrapS);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, array.WrapT);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+            if (freed >= 0)
+            {
+                m_Arrays[freed] = array;
+                index           = freed;
+            }
+            else
+            {
+                m_Arrays.push_back(array);
+                index = m_Arrays.size() - 1;
+            }
+        }
+
+        TextureArray &array = m_Arrays[index];
+        slot.Array          = index;
+        if (!array.FreeLayers.empty())
+        {
+            slot.Layer = array.FreeLayers.back();
+            array.FreeLayers.pop_back();
+        }
+        else
+            slot.Layer = array.Layers++;
+        ++array.Used;
+
+        // GPU side copy of every mip level, no readback
+        unsigned int width = array.Width, height = array.Height;
+        for (unsigned int level = 0; level < levels; ++level)
+        {
+            glCopyImageSubData(texture->ID, GL_TEXTURE_2D, level, 0, 0, 0, array.ID, GL_TEXTURE_2D_ARRAY, level, 0, 0, slot.Layer, width, height, 1);
+            width  = std::max(width / 2, 1u);
+            height = std::max(height / 2, 1u);
+        }
+
+        m_Slots[texture] = {texture->ID, texture->Width, texture->Height, slot};
+        return slot;
+    }
+    // --------------------------------------------------------------------------------------------
+    void MaterialTextures::Release(Texture *texture)
+    {
+        auto found = m_Slots.find(texture);
+        if (found == m_Slots.end()) return;
+
+        releaseSlot(found->second.Slot);
+        m_Slots.erase(found);
+    }
+    // --------------------------------------------------------------------------------------------
+    void MaterialTextures::Clean()
+    {
+        for (unsigned int i = 0; i < m_Arrays.size(); ++i)
+        {
+            if (m_Arrays[i].ID) glDeleteTextures(1, &m_Arrays[i].ID);
+        }
+        m_Arrays.clear();
+        m_Slots.clear();
+        ++m_Revision;
+    }
+    // --------------------------------------------------------------------------------------------
+    uint32_t MaterialTextures::GetRevision() { return m_Revision; }
+    // --------------------------------------------------------------------------------------------
+    void MaterialTextures::BindArrays()
+    {
+        if (m_Mode != MATERIAL_TEXTURE_ARRAYS) return;
+
+        for (unsigned int i = 0; i < m_Arrays.size(); ++i)
+        {
+            glActiveTexture(GL_TEXTURE0 + ARRAY_UNIT_BASE + i);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, m_Arrays[i].ID);
+        }
+        glActiveTexture(GL_TEXTURE0);
+    }
+    // --------------------------------------------------------------------------------------------
+    void MaterialTextures::releaseSlot(const TextureArraySlot &slot)
+    {
+        // the default layer is never handed out for good
+        if (slot.Array <= 0 || slot.Array >= (int) m_Arrays.size()) return;
+
+        TextureArray &array = m_Arrays[slot.Array];
+        array.FreeLayers.push_back(slot.Layer);
+        if (--array.Used == 0)
+        {
+            glDeleteTextures(1, &array.ID);
+            array = TextureArray();
+        }
+        ++m_Revision;
+    }
+    // --------------------------------------------------------------------------------------------
+    void MaterialTextures::createDefaultArray()
+    {
+        // a single white texel; full from the start so no texture is ever
+        // placed next to it
+        TextureArray array;
+        array.InternalFormat = GL_RGBA8;
+        array.Width          = 1;
+        array.Height         = 1;
+        array.Levels         = 1;
+        array.FilterMin      = GL_NEAREST;
+        array.FilterMax      = GL_NEAREST;
+        array.WrapS          = GL_REPEAT;
+        array.WrapT          = GL_REPEAT;
+        array.Layers         = LAYERS_PER_ARRAY;
+        array.Used           = 0;
+
+        const unsigned char white[4] = {255, 255, 255, 255};
+        glGenTextures(1, &array.ID);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, array.ID);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, 1, 1, 1);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, 1, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, white);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+        m_Arrays.push_back(array);
+    }
+} // namespace vantor::Graphics::RenderDevice::OpenGL
@@ -0,0 +1,124 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLMaterialTextures.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    class Texture;
+
+    // How materials hand their 2D textures to the shader. Shaders declare
+    // material textures through res/intern/shaders/common/material_textures.glsl
+    // so the same source compiles for every mode.
+    enum MATERIAL_TEXTURE_MODE
+    {
+        // classic: one texture unit per sampler, rebound on every draw
+        MATERIAL_TEXTURE_BOUND,
+        // GL_ARB_bindless_texture: resident handles live in the Material block
+        MATERIAL_TEXTURE_BINDLESS,
+        // textures are copied into shared GL_TEXTURE_2D_ARRAYs which stay bound
+        // for the whole frame; the Material block holds {array, layer}
+        MATERIAL_TEXTURE_ARRAYS,
+    };
+
+    struct TextureArraySlot
+    {
+            int Array = 0; // index into the TextureArrays sampler array
+            int Layer = 0;
+    };
+
+    class MaterialTextures
+    {
+        public:
+            static constexpr unsigned int MAX_ARRAYS       = 8;
+            static constexpr unsigned int LAYERS_PER_ARRAY = 64;
+            // texture units 16..23 are reserved for the arrays
+            static constexpr unsigned int ARRAY_UNIT_BASE = 16;
+
+        private:
+            struct TextureArray
+            {
+                    unsigned int     ID; // 0 once released, the index is then free for a new array
+                    GLenum           InternalFormat;
+                    unsigned int     Width;
+                    unsigned int     Height;
+                    unsigned int     Levels;
+                    GLenum           FilterMin;
+                    GLenum           FilterMax;
+                    GLenum           WrapS;
+                    GLenum           WrapT;
+                    unsigned int     Layers;     // layers handed out so far
+                    unsigned int     Used;       // of those still holding a texture
+                    std::vector<int> FreeLayers; // released below Layers
+            };
+
+            // the GL name and size the copy was made from; a texture that was
+            // regenerated since is copied again
+            struct Entry
+            {
+                    unsigned int     TextureID;
+                    unsigned int     Width;
+                    unsigned int     Height;
+                    TextureArraySlot Slot;
+            };
+
+            static MATERIAL_TEXTURE_MODE                m_Mode;
+            static std::vector<TextureArray>            m_Arrays; // [0] is the white default layer
+            static std::unordered_map<Texture *, Entry> m_Slots;
+            static uint32_t                             m_Revision;
+
+        public:
+            // must be called after the window (and with it the GL context) is
+            // created, but before the renderer is initialized, as the mode is
+            // compiled into every shader. Falls back to a supported mode.
+            static void                  SetMode(MATERIAL_TEXTURE_MODE mode);
+            static MATERIAL_TEXTURE_MODE GetMode();
+
+            // define added to every shader for the active mode; null for MATERIAL_TEXTURE_BOUND
+            static const char *GetShaderDefine();
+
+            // copies the texture into a pooled array on first use; the texture
+            // itself is left untouched so it can still be bound directly.
+            // Textures that can't be pooled (not 2D, or every array in use)
+            // get the white default layer instead.
+            static TextureArraySlot Acquire(Texture *texture);
+            // frees the texture's layer, e.g. before deleting it; arrays are
+            // deleted once their last layer is released.
+            static void Release(Texture *texture);
+            // deletes every array
+            static void Clean();
+            // bumped whenever a layer is released; slots acquired before may
+            // now hold another texture and have to be acquired again.
+            static uint32_t GetRevision();
+
+            // binds the pooled arrays to their reserved units; once per frame.
+            static void BindArrays();
+
+        private:
+            static void releaseSlot(const TextureArraySlot &slot);
+            static void createDefaultArray();
+    };
+} // namespace vantor::Graphics::RenderDevice::OpenGL
@@ -20,9 +20,237 @@
 
 #include "vantorOpenGLMesh.hpp"
 #include "../../../Core/BackLog/vantorBacklog.h"
+#include "../../../Core/JobSystem/vantorJobSystem.h"
+#include "../../Geometry/SDF/vantorDualContouring.hpp"
+#include "../../Geometry/SDF/vantorMarchingCubes.hpp"
+#include "../../Geometry/vantorMeshOptimizer.hpp"
+#include "../../Geometry/vantorTangentSpace.hpp"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <string>
 
 namespace vantor::Graphics::RenderDevice::OpenGL
 {
+    namespace
+    {
+        int16_t toSnorm16(float value) { return (int16_t) std::round(std::clamp(value, -1.0f, 1.0f) * 32767.0f); }
+
+        uint16_t toUnorm16(float value) { return (uint16_t) std::round(std::clamp(value, 0.0f, 1.0f) * 65535.0f); }
+
+        // unit vector -> [-1, 1]^2 by projecting onto the octahedron and
+        // folding the lower half over; decoded in common/vertex_format.glsl
+        glm::vec2 octEncode(glm::vec3 n)
+        {
+            n /= std::max(std::abs(n.x) + std::abs(n.y) + std::abs(n.z), 1e-20f);
+            glm::vec2 oct(n.x, n.y);
+            if (n.z < 0.0f)
+            {
+                oct.x = (1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+                oct.y = (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+            }
+            return oct;
+        }
+
+        // Writes a mesh's attributes in the layout prepareEncoder() picked. Encode()
+        // only reads the mesh, so disjoint vertex ranges can be encoded
+        // concurrently, straight into a mapped buffer.
+        struct VertexEncoder
+        {
+                static constexpr unsigned int MAX_VERTEX_SIZE = 56; // all five attributes as floats
+                static constexpr unsigned int BLOCK_VERTICES  = 256;
+
+                const Mesh  *Source = nullptr;
+                VertexLayout Layout[5];
+                unsigned int Attributes  = 0;
+                size_t       VertexSize  = 0;
+                bool         Interleaved = true;
+                // bitangents are folded into the octahedral tangent's sign
+                bool      PackBitangents = false;
+                glm::vec3 InvScale       = glm::vec3(1.0f); // of quantized positions
+
+                // vertices [first, first + count) into buffer, which holds the
+                // whole vertex buffer
+                void Encode(unsigned int first, unsigned int count, uint8_t *buffer) const
+                {
+                    if (!Interleaved)
+                    {
+                        // every attribute is one contiguous run already
+                        for (unsigned int a = 0; a < Attributes; ++a)
+                            encodeAttribute(Layout[a], first, count, buffer + Layout[a].Offset + first * Layout[a].Size, Layout[a].Size);
+                        return;
+                    }
+
+                    // assemble whole vertices in a cache resident block and
+                    // write them out in one sequential copy; mapped buffers
+                    // are typically write combined and hate strided writes.
+                    alignas(16) uint8_t block[BLOCK_VERTICES * MAX_VERTEX_SIZE];
+                    for (unsigned int start = first; start < first + count; start += BLOCK_VERTICES)
+                    {
+                        unsigned int n = std::min(BLOCK_VERTICES, first + count - start);
+                        for (unsigned int a = 0; a < Attributes; ++a)
+                            encodeAttribute(Layout[a], start, n, block + Layout[a].Offset, VertexSize);
+                        std::memcpy(buffer + start * VertexSize, block, n * VertexSize);
+                    }
+                }
+
+                // plain strided loops without per vertex branching, which
+                // compilers vectorize on their own
+                void encodeAttribute(const VertexLayout &attribute, unsigned int first, unsigned int count, uint8_t *dst, size_t stride) const
+                {
+                    const unsigned int last = first + count;
+                    switch (attribute.Location)
+                    {
+                        case 0:
+                            if (attribute.Type == GL_UNSIGNED_SHORT)
+                            {
+                                for (unsigned int i = first; i < last; ++i, dst += stride)
+                                {
+                                    glm::vec3 unit   = (Source->Positions[i] - Source->m_PositionOffset) * InvScale;
+                                    uint16_t  src[4] = {toUnorm16(unit.x), toUnorm16(unit.y), toUnorm16(unit.z), 0xFFFF};
+                                    std::memcpy(dst, src, sizeof(src));
+                                }
+                            }
+                            else
+                                copyFloats(Source->Positions.data() + first, count, dst, stride);
+                            break;
+                        case 1:
+                            if (attribute.Type == GL_HALF_FLOAT)
+                            {
+                                for (unsigned int i = first; i < last; ++i, dst += stride)
+                                {
+                                    uint32_t src = glm::packHalf2x16(Source->UV[i]);
+                                    std::memcpy(dst, &src, sizeof(src));
+                                }
+                            }
+                            else
+                                copyFloats(Source->UV.data() + first, count, dst, stride);
+                            break;
+                        case 2:
+                            if (attribute.Type == GL_SHORT)
+                            {
+                                for (unsigned int i = first; i < last; ++i, dst += stride)
+                                {
+                                    glm::vec2 oct    = octEncode(Source->Normals[i]);
+                                    int16_t   src[2] = {toSnorm16(oct.x), toSnorm16(oct.y)};
+                                    std::memcpy(dst, src, sizeof(src));
+                                }
+                            }
+                            else
+                                copyFloats(Source->Normals.data() + first, count, dst, stride);
+                            break;
+                        case 3:
+                            if (attribute.Type == GL_SHORT)
+                            {
+                                const bool signs = PackBitangents && !Source->Bitangents.empty();
+                                for (unsigned int i = first; i < last; ++i, dst += stride)
+                                {
+                                    // the shader rebuilds the bitangent as cross(N, T) * sign
+                                    float sign = 1.0f;
+                                    if (signs && glm::dot(glm::cross(Source->Normals[i], Source->Tangents[i]), Source->Bitangents[i]) < 0.0f) sign = -1.0f;
+
+                                    glm::vec2 oct    = octEncode(Source->Tangents[i]);
+                                    int16_t   src[4] = {toSnorm16(oct.x), toSnorm16(oct.y), toSnorm16(sign), 0};
+                                    std::memcpy(dst, src, sizeof(src));
+                                }
+                            }
+                            else
+                                copyFloats(Source->Tangents.data() + first, count, dst, stride);
+                            break;
+                        case 4:
+                            copyFloats(Source->Bitangents.data() + first, count, dst, stride);
+                            break;
+                    }
+                }
+
+                template <typename T> static void copyFloats(const T *src, unsigned int count, uint8_t *dst, size_t stride)
+                {
+                    if (stride == sizeof(T))
+                    {
+                        std::memcpy(dst, src, count * sizeof(T));
+                        return;
+                    }
+                    for (unsigned int i = 0; i < count; ++i, dst += stride)
+                        std::memcpy(dst, &src[i], sizeof(T));
+                }
+        };
+
+        // buffer layout of every present attribute, in location order, and
+        // the position quantization of mesh->Format
+        void prepareEncoder(Mesh *mesh, bool interleaved, VertexEncoder &encoder)
+        {
+            const unsigned int count      = mesh->Positions.size();
+            const bool         quantized  = mesh->Format & VERTEX_QUANTIZED_POSITIONS;
+            const bool         octahedral = mesh->Format & VERTEX_OCTAHEDRAL_TBN;
+
+            encoder.Source         = mesh;
+            encoder.Interleaved    = interleaved;
+            encoder.PackBitangents = octahedral && mesh->Normals.size() > 0 && mesh->Tangents.size() > 0;
+
+            VertexLayout *layout = encoder.Layout;
+            unsigned int &n      = encoder.Attributes;
+            layout[n++]          = quantized ? VertexLayout{0, 4, GL_UNSIGNED_SHORT, GL_TRUE, 8} : VertexLayout{0, 3, GL_FLOAT, GL_FALSE, 12};
+            if (mesh->UV.size() > 0)
+                layout[n++] = mesh->Format & VERTEX_HALF_UVS ? VertexLayout{1, 2, GL_HALF_FLOAT, GL_FALSE, 4} : VertexLayout{1, 2, GL_FLOAT, GL_FALSE, 8};
+            if (mesh->Normals.size() > 0) layout[n++] = octahedral ? VertexLayout{2, 2, GL_SHORT, GL_TRUE, 4} : VertexLayout{2, 3, GL_FLOAT, GL_FALSE, 12};
+            if (mesh->Tangents.size() > 0) layout[n++] = octahedral ? VertexLayout{3, 4, GL_SHORT, GL_TRUE, 8} : VertexLayout{3, 3, GL_FLOAT, GL_FALSE, 12};
+            if (mesh->Bitangents.size() > 0 && !encoder.PackBitangents) layout[n++] = VertexLayout{4, 3, GL_FLOAT, GL_FALSE, 12};
+
+            // interleaved: attributes sit next to each other within a vertex;
+            // otherwise each attribute is one tightly packed block after the other.
+            for (unsigned int i = 0; i < n; ++i)
+                encoder.VertexSize += layout[i].Size;
+            size_t offset = 0;
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                layout[i].Offset = offset;
+                layout[i].Stride = interleaved ? encoder.VertexSize : layout[i].Size;
+                offset += interleaved ? layout[i].Size : layout[i].Size * count;
+            }
+
+            if (quantized)
+            {
+                glm::vec3 boxMin(0.0f), boxMax(0.0f);
+                if (count > 0) boxMin = boxMax = mesh->Positions[0];
+                for (unsigned int i = 1; i < count; ++i)
+                {
+                    boxMin = glm::min(boxMin, mesh->Positions[i]);
+                    boxMax = glm::max(boxMax, mesh->Positions[i]);
+                }
+                mesh->m_PositionOffset = boxMin;
+                mesh->m_PositionScale  = boxMax - boxMin;
+                // flat axes would divide by zero; any value decodes right there
+                encoder.InvScale = glm::vec3(1.0f) / glm::max(mesh->m_PositionScale, glm::vec3(1e-20f));
+            }
+            else
+            {
+                mesh->m_PositionOffset = glm::vec3(0.0f);
+                mesh->m_PositionScale  = glm::vec3(1.0f);
+            }
+        }
+
+        void encodeVertices(const VertexEncoder &encoder, unsigned int count, uint8_t *buffer)
+        {
+            if (count >= Mesh::PARALLEL_THRESHOLD)
+            {
+                const unsigned int jobs = (count + Mesh::JOB_VERTICES - 1) / Mesh::JOB_VERTICES;
+                vantor::Core::JobSystem::ParallelFor(jobs,
+                                                     [&encoder, buffer, count](uint32_t job)
+                                                     {
+                                                         unsigned int first = job * Mesh::JOB_VERTICES;
+                                                         encoder.Encode(first, std::min(Mesh::JOB_VERTICES, count - first), buffer);
+                                                     });
+            }
+            else
+                encoder.Encode(0, count, buffer);
+        }
+    } // namespace
+
     // --------------------------------------------------------------------------------------------
     Mesh::Mesh() {}
     // --------------------------------------------------------------------------------------------
@@ -84,659 +312,232 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             glGenBuffers(1, &m_EBO);
         }
 
-        std::vector<float> data;
-        if (interleaved)
+        const unsigned int count = Positions.size();
+
+        VertexEncoder encoder;
+        prepareEncoder(this, interleaved, encoder);
+
+        glBindVertexArray(m_VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+
+        // large meshes are encoded straight into the mapped buffer instead of
+        // being staged in a copy of the same size first
+        const size_t         size   = encoder.VertexSize * count;
+        uint8_t             *buffer = nullptr;
+        std::vector<uint8_t> staging;
+        if (size >= MAP_THRESHOLD)
+        {
+            glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STATIC_DRAW);
+            buffer = (uint8_t *) glMapBufferRange(GL_ARRAY_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        }
+        if (!buffer)
+        {
+            staging.resize(size);
+            buffer = staging.data();
+        }
+
+        encodeVertices(encoder, count, buffer);
+
+        if (staging.empty() && size > 0)
         {
-            for (int i = 0; i < Positions.size(); ++i)
+            // the store can be lost (e.g. on a display mode change); rare
+            // enough to just encode again through a staging copy
+            if (!glUnmapBuffer(GL_ARRAY_BUFFER))
             {
-                data.push_back(Positions[i].x);
-                data.push_back(Positions[i].y);
-                data.push_back(Positions[i].z);
-                if (UV.size() > 0)
-                {
-                    data.push_back(UV[i].x);
-                    data.push_back(UV[i].y);
-                }
-                if (Normals.size() > 0)
-                {
-                    data.push_back(Normals[i].x);
-                    data.push_back(Normals[i].y);
-                    data.push_back(Normals[i].z);
-                }
-                if (Tangents.size() > 0)
-                {
-                    data.push_back(Tangents[i].x);
-                    data.push_back(Tangents[i].y);
-                    data.push_back(Tangents[i].z);
-                }
-                if (Bitangents.size() > 0)
-                {
-                    data.push_back(Bitangents[i].x);
-                    data.push_back(Bitangents[i].y);
-                    data.push_back(Bitangents[i].z);
-                }
+                vantor::Backlog::Log("OpenGLMesh", "Vertex buffer was corrupted while mapped, uploading again.", vantor::Backlog::LogLevel::WARNING);
+                staging.resize(size);
+                encoder.Encode(0, count, staging.data());
+                glBufferData(GL_ARRAY_BUFFER, size, staging.data(), GL_STATIC_DRAW);
             }
         }
         else
+            glBufferData(GL_ARRAY_BUFFER, size, staging.data(), GL_STATIC_DRAW);
+
+        uploadIndices();
+        setAttributes(encoder.Layout, encoder.Attributes);
+        glBindVertexArray(0);
+
+        m_VertexCount = count;
+        m_IndexCount  = Indices.size();
+    }
+    // --------------------------------------------------------------------------------------------
+    unsigned int Mesh::Encode(bool interleaved, std::vector<uint8_t> &vertices, VertexLayout layout[5], std::vector<uint8_t> &indices)
+    {
+        const unsigned int count = Positions.size();
+
+        VertexEncoder encoder;
+        prepareEncoder(this, interleaved, encoder);
+        vertices.resize(encoder.VertexSize * count);
+        encodeVertices(encoder, count, vertices.data());
+        std::copy(encoder.Layout, encoder.Layout + encoder.Attributes, layout);
+
+        // same choice as uploadIndices()
+        m_IndexType = !Indices.empty() && count < 65536 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        if (m_IndexType == GL_UNSIGNED_SHORT)
         {
-            for (int i = 0; i < Positions.size(); ++i)
-            {
-                data.push_back(Positions[i].x);
-                data.push_back(Positions[i].y);
-                data.push_back(Positions[i].z);
-            }
-            for (int i = 0; i < UV.size(); ++i)
-            {
-                data.push_back(UV[i].x);
-                data.push_back(UV[i].y);
-            }
-            for (int i = 0; i < Normals.size(); ++i)
-            {
-                data.push_back(Normals[i].x);
-                data.push_back(Normals[i].y);
-                data.push_back(Normals[i].z);
-            }
-            for (int i = 0; i < Tangents.size(); ++i)
-            {
-                data.push_back(Tangents[i].x);
-                data.push_back(Tangents[i].y);
-                data.push_back(Tangents[i].z);
-            }
-            for (int i = 0; i < Bitangents.size(); ++i)
-            {
-                data.push_back(Bitangents[i].x);
-                data.push_back(Bitangents[i].y);
-                data.push_back(Bitangents[i].z);
-            }
+            indices.resize(Indices.size() * sizeof(uint16_t));
+            uint16_t *dst = (uint16_t *) indices.data();
+            for (unsigned int i = 0; i < Indices.size(); ++i)
+                dst[i] = Indices[i];
+        }
+        else
+        {
+            indices.resize(Indices.size() * sizeof(unsigned int));
+            if (!Indices.empty()) std::memcpy(indices.data(), Indices.data(), indices.size());
+        }
+
+        return encoder.Attributes;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Mesh::Upload(const VertexLayout *layout,
+                      unsigned int        attributes,
+                      const void         *vertices,
+                      size_t              vertexBytes,
+                      unsigned int        vertexCount,
+                      const void         *indices,
+                      GLenum              indexType,
+                      unsigned int        indexCount)
+    {
+        if (!m_VAO)
+        {
+            glGenVertexArrays(1, &m_VAO);
+            glGenBuffers(1, &m_VBO);
+            glGenBuffers(1, &m_EBO);
         }
 
         glBindVertexArray(m_VAO);
         glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-        glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), &data[0], GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, vertexBytes, vertices, GL_STATIC_DRAW);
 
-        if (Indices.size() > 0)
+        m_IndexType = indexType;
+        if (indexCount > 0)
         {
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, Indices.size() * sizeof(unsigned int), &Indices[0], GL_STATIC_DRAW);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * (indexType == GL_UNSIGNED_SHORT ? 2 : 4), indices, GL_STATIC_DRAW);
         }
-        if (interleaved)
+
+        setAttributes(layout, attributes);
+        glBindVertexArray(0);
+
+        m_VertexCount = vertexCount;
+        m_IndexCount  = indexCount;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Mesh::uploadIndices()
+    {
+        // expects the VAO to be bound, it keeps the element buffer binding
+        if (Indices.empty())
         {
-            size_t stride = 3 * sizeof(float);
-            if (UV.size() > 0) stride += 2 * sizeof(float);
-            if (Normals.size() > 0) stride += 3 * sizeof(float);
-            if (Tangents.size() > 0) stride += 3 * sizeof(float);
-            if (Bitangents.size() > 0) stride += 3 * sizeof(float);
+            m_IndexType = GL_UNSIGNED_INT;
+            return;
+        }
 
-            size_t offset = 0;
-            glEnableVertexAttribArray(0);
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid *) offset);
-            offset += 3 * sizeof(float);
-            if (UV.size() > 0)
-            {
-                glEnableVertexAttribArray(1);
-                glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid *) offset);
-                offset += 2 * sizeof(float);
-            }
-            if (Normals.size() > 0)
-            {
-                glEnableVertexAttribArray(2);
-                glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid *) offset);
-                offset += 3 * sizeof(float);
-            }
-            if (Tangents.size() > 0)
-            {
-                glEnableVertexAttribArray(3);
-                glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid *) offset);
-                offset += 3 * sizeof(float);
-            }
-            if (Bitangents.size() > 0)
-            {
-                glEnableVertexAttribArray(4);
-                glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid *) offset);
-                offset += 3 * sizeof(float);
-            }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+        if (Positions.size() < 65536)
+        {
+            std::vector<uint16_t> indices(Indices.begin(), Indices.end());
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+            m_IndexType = GL_UNSIGNED_SHORT;
         }
         else
         {
-            size_t offset = 0;
-            glEnableVertexAttribArray(0);
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (GLvoid *) offset);
-            offset += Positions.size() * sizeof(float);
-            if (UV.size() > 0)
-            {
-                glEnableVertexAttribArray(1);
-                glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, (GLvoid *) offset);
-                offset += UV.size() * sizeof(float);
-            }
-            if (Normals.size() > 0)
-            {
-                glEnableVertexAttribArray(2);
-                glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, (GLvoid *) offset);
-                offset += Normals.size() * sizeof(float);
-            }
-            if (Tangents.size() > 0)
-            {
-                glEnableVertexAttribArray(3);
-                glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 0, (GLvoid *) offset);
-                offset += Tangents.size() * sizeof(float);
-            }
-            if (Bitangents.size() > 0)
-            {
-                glEnableVertexAttribArray(4);
-                glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, 0, (GLvoid *) offset);
-                offset += Bitangents.size() * sizeof(float);
-            }
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, Indices.size() * sizeof(unsigned int), Indices.data(), GL_STATIC_DRAW);
+            m_IndexType = GL_UNSIGNED_INT;
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    void Mesh::setAttributes(const VertexLayout *layout, unsigned int attributes)
+    {
+        // expects the VAO and vertex buffer to be bound; a re-finalized mesh
+        // may have lost attributes
+        for (unsigned int location = 0; location < 5; ++location)
+            glDisableVertexAttribArray(location);
+        m_Format = VERTEX_FLOAT;
+        for (unsigned int i = 0; i < attributes; ++i)
+        {
+            const VertexLayout &attribute = layout[i];
+            glEnableVertexAttribArray(attribute.Location);
+            glVertexAttribPointer(attribute.Location, attribute.Components, attribute.Type, attribute.Normalized, attribute.Stride,
+                                  (GLvoid *) (uintptr_t) attribute.Offset);
+
+            // read the encoding back from the layout, Format may have changed
+            // since the buffer was encoded (or it came from the cache)
+            if (attribute.Location == 0 && attribute.Type == GL_UNSIGNED_SHORT) m_Format |= VERTEX_QUANTIZED_POSITIONS;
+            if (attribute.Location == 1 && attribute.Type == GL_HALF_FLOAT) m_Format |= VERTEX_HALF_UVS;
+            if ((attribute.Location == 2 || attribute.Location == 3) && attribute.Type == GL_SHORT) m_Format |= VERTEX_OCTAHEDRAL_TBN;
         }
-        glBindVertexArray(0);
     }
     // --------------------------------------------------------------------------------------------
-    void Mesh::FromSDF(std::function<float(glm::vec3)> &sdf, float maxDistance, uint16_t gridResolution)
+    void Mesh::FromSDF(const Geometry::SDF::Field &field, float maxDistance, uint16_t gridResolution, SDF_MESHER mesher)
     {
         vantor::Backlog::Log("OpenGLMesh", "Generating 3D mesh from SDF", vantor::Backlog::LogLevel::DEBUG);
 
-        // tables from: http://paulbourke.net/geometry/polygonise/
-        static int edgeTable[256]
-            = {0x0,   0x109, 0x203, 0x30a, 0x406, 0x50f, 0x605, 0x70c, 0x80c, 0x905, 0xa0f, 0xb06, 0xc0a, 0xd03, 0xe09, 0xf00, 0x190, 0x99,  0x393, 0x29a,
-               0x596, 0x49f, 0x795, 0x69c, 0x99c, 0x895, 0xb9f, 0xa96, 0xd9a, 0xc93, 0xf99, 0xe90, 0x230, 0x339, 0x33,  0x13a, 0x636, 0x73f, 0x435, 0x53c,
-               0xa3c, 0xb35, 0x83f, 0x936, 0xe3a, 0xf33, 0xc39, 0xd30, 0x3a0, 0x2a9, 0x1a3, 0xaa,  0x7a6, 0x6af, 0x5a5, 0x4ac, 0xbac, 0xaa5, 0x9af, 0x8a6,
-               0xfaa, 0xea3, 0xda9, 0xca0, 0x460, 0x569, 0x663, 0x76a, 0x66,  0x16f, 0x265, 0x36c, 0xc6c, 0xd65, 0xe6f, 0xf66, 0x86a, 0x963, 0xa69, 0xb60,
-               0x5f0, 0x4f9, 0x7f3, 0x6fa, 0x1f6, 0xff,  0x3f5, 0x2fc, 0xdfc, 0xcf5, 0xfff, 0xef6, 0x9fa, 0x8f3, 0xbf9, 0xaf0, 0x650, 0x759, 0x453, 0x55a,
-               0x256, 0x35f, 0x55,  0x15c, 0xe5c, 0xf55, 0xc5f, 0xd56, 0xa5a, 0xb53, 0x859, 0x950, 0x7c0, 0x6c9, 0x5c3, 0x4ca, 0x3c6, 0x2cf, 0x1c5, 0xcc,
-               0xfcc, 0xec5, 0xdcf, 0xcc6, 0xbca, 0xac3, 0x9c9, 0x8c0, 0x8c0, 0x9c9, 0xac3, 0xbca, 0xcc6, 0xdcf, 0xec5, 0xfcc, 0xcc,  0x1c5, 0x2cf, 0x3c6,
-               0x4ca, 0x5c3, 0x6c9, 0x7c0, 0x950, 0x859, 0xb53, 0xa5a, 0xd56, 0xc5f, 0xf55, 0xe5c, 0x15c, 0x55,  0x35f, 0x256, 0x55a, 0x453, 0x759, 0x650,
-               0xaf0, 0xbf9, 0x8f3, 0x9fa, 0xef6, 0xfff, 0xcf5, 0xdfc, 0x2fc, 0x3f5, 0xff,  0x1f6, 0x6fa, 0x7f3, 0x4f9, 0x5f0, 0xb60, 0xa69, 0x963, 0x86a,
-               0xf66, 0xe6f, 0xd65, 0xc6c, 0x36c, 0x265, 0x16f, 0x66,  0x76a, 0x663, 0x569, 0x460, 0xca0, 0xda9, 0xea3, 0xfaa, 0x8a6, 0x9af, 0xaa5, 0xbac,
-               0x4ac, 0x5a5, 0x6af, 0x7a6, 0xaa,  0x1a3, 0x2a9, 0x3a0, 0xd30, 0xc39, 0xf33, 0xe3a, 0x936, 0x83f, 0xb35, 0xa3c, 0x53c, 0x435, 0x73f, 0x636,
-               0x13a, 0x33,  0x339, 0x230, 0xe90, 0xf99, 0xc93, 0xd9a, 0xa96, 0xb9f, 0x895, 0x99c, 0x69c, 0x795, 0x49f, 0x596, 0x29a, 0x393, 0x99,  0x190,
-               0xf00, 0xe09, 0xd03, 0xc0a, 0xb06, 0xa0f, 0x905, 0x80c, 0x70c, 0x605, 0x50f, 0x406, 0x30a, 0x203, 0x109, 0x0};
-        static int triTable[256][16] = {{-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 8, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 1, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 8, 3, 9, 8, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 2, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 8, 3, 1, 2, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 2, 10, 0, 2, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {2, 8, 3, 2, 10, 8, 10, 9, 8, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 11, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 11, 2, 8, 11, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 9, 0, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 11, 2, 1, 9, 11, 9, 8, 11, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 10, 1, 11, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 10, 1, 0, 8, 10, 8, 11, 10, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 9, 0, 3, 11, 9, 11, 10, 9, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 8, 10, 10, 8, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 7, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 3, 0, 7, 3, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 1, 9, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 1, 9, 4, 7, 1, 7, 3, 1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 2, 10, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 4, 7, 3, 0, 4, 1, 2, 10, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 2, 10, 9, 0, 2, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1},
-                                        {2, 10, 9, 2, 9, 7, 2, 7, 3, 7, 9, 4, -1, -1, -1, -1},
-                                        {8, 4, 7, 3, 11, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {11, 4, 7, 11, 2, 4, 2, 0, 4, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 0, 1, 8, 4, 7, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 7, 11, 9, 4, 11, 9, 11, 2, 9, 2, 1, -1, -1, -1, -1},
-                                        {3, 10, 1, 3, 11, 10, 7, 8, 4, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 11, 10, 1, 4, 11, 1, 0, 4, 7, 11, 4, -1, -1, -1, -1},
-                                        {4, 7, 8, 9, 0, 11, 9, 11, 10, 11, 0, 3, -1, -1, -1, -1},
-                                        {4, 7, 11, 4, 11, 9, 9, 11, 10, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 5, 4, 0, 8, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 5, 4, 1, 5, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {8, 5, 4, 8, 3, 5, 3, 1, 5, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 2, 10, 9, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 0, 8, 1, 2, 10, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1},
-                                        {5, 2, 10, 5, 4, 2, 4, 0, 2, -1, -1, -1, -1, -1, -1, -1},
-                                        {2, 10, 5, 3, 2, 5, 3, 5, 4, 3, 4, 8, -1, -1, -1, -1},
-                                        {9, 5, 4, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 11, 2, 0, 8, 11, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 5, 4, 0, 1, 5, 2, 3, 11, -1, -1, -1, -1, -1, -1, -1},
-                                        {2, 1, 5, 2, 5, 8, 2, 8, 11, 4, 8, 5, -1, -1, -1, -1},
-                                        {10, 3, 11, 10, 1, 3, 9, 5, 4, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 9, 5, 0, 8, 1, 8, 10, 1, 8, 11, 10, -1, -1, -1, -1},
-                                        {5, 4, 0, 5, 0, 11, 5, 11, 10, 11, 0, 3, -1, -1, -1, -1},
-                                        {5, 4, 8, 5, 8, 10, 10, 8, 11, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 7, 8, 5, 7, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 3, 0, 9, 5, 3, 5, 7, 3, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 7, 8, 0, 1, 7, 1, 5, 7, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 5, 3, 3, 5, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 7, 8, 9, 5, 7, 10, 1, 2, -1, -1, -1, -1, -1, -1, -1},
-                                        {10, 1, 2, 9, 5, 0, 5, 3, 0, 5, 7, 3, -1, -1, -1, -1},
-                                        {8, 0, 2, 8, 2, 5, 8, 5, 7, 10, 5, 2, -1, -1, -1, -1},
-                                        {2, 10, 5, 2, 5, 3, 3, 5, 7, -1, -1, -1, -1, -1, -1, -1},
-                                        {7, 9, 5, 7, 8, 9, 3, 11, 2, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 5, 7, 9, 7, 2, 9, 2, 0, 2, 7, 11, -1, -1, -1, -1},
-                                        {2, 3, 11, 0, 1, 8, 1, 7, 8, 1, 5, 7, -1, -1, -1, -1},
-                                        {11, 2, 1, 11, 1, 7, 7, 1, 5, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 5, 8, 8, 5, 7, 10, 1, 3, 10, 3, 11, -1, -1, -1, -1},
-                                        {5, 7, 0, 5, 0, 9, 7, 11, 0, 1, 0, 10, 11, 10, 0, -1},
-                                        {11, 10, 0, 11, 0, 3, 10, 5, 0, 8, 0, 7, 5, 7, 0, -1},
-                                        {11, 10, 5, 7, 11, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {10, 6, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 8, 3, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 0, 1, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 8, 3, 1, 9, 8, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 6, 5, 2, 6, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 6, 5, 1, 2, 6, 3, 0, 8, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 6, 5, 9, 0, 6, 0, 2, 6, -1, -1, -1, -1, -1, -1, -1},
-                                        {5, 9, 8, 5, 8, 2, 5, 2, 6, 3, 2, 8, -1, -1, -1, -1},
-                                        {2, 3, 11, 10, 6, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {11, 0, 8, 11, 2, 0, 10, 6, 5, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 1, 9, 2, 3, 11, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1},
-                                        {5, 10, 6, 1, 9, 2, 9, 11, 2, 9, 8, 11, -1, -1, -1, -1},
-                                        {6, 3, 11, 6, 5, 3, 5, 1, 3, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 8, 11, 0, 11, 5, 0, 5, 1, 5, 11, 6, -1, -1, -1, -1},
-                                        {3, 11, 6, 0, 3, 6, 0, 6, 5, 0, 5, 9, -1, -1, -1, -1},
-                                        {6, 5, 9, 6, 9, 11, 11, 9, 8, -1, -1, -1, -1, -1, -1, -1},
-                                        {5, 10, 6, 4, 7, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 3, 0, 4, 7, 3, 6, 5, 10, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 9, 0, 5, 10, 6, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1},
-                                        {10, 6, 5, 1, 9, 7, 1, 7, 3, 7, 9, 4, -1, -1, -1, -1},
-                                        {6, 1, 2, 6, 5, 1, 4, 7, 8, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 2, 5, 5, 2, 6, 3, 0, 4, 3, 4, 7, -1, -1, -1, -1},
-                                        {8, 4, 7, 9, 0, 5, 0, 6, 5, 0, 2, 6, -1, -1, -1, -1},
-                                        {7, 3, 9, 7, 9, 4, 3, 2, 9, 5, 9, 6, 2, 6, 9, -1},
-                                        {3, 11, 2, 7, 8, 4, 10, 6, 5, -1, -1, -1, -1, -1, -1, -1},
-                                        {5, 10, 6, 4, 7, 2, 4, 2, 0, 2, 7, 11, -1, -1, -1, -1},
-                                        {0, 1, 9, 4, 7, 8, 2, 3, 11, 5, 10, 6, -1, -1, -1, -1},
-                                        {9, 2, 1, 9, 11, 2, 9, 4, 11, 7, 11, 4, 5, 10, 6, -1},
-                                        {8, 4, 7, 3, 11, 5, 3, 5, 1, 5, 11, 6, -1, -1, -1, -1},
-                                        {5, 1, 11, 5, 11, 6, 1, 0, 11, 7, 11, 4, 0, 4, 11, -1},
-                                        {0, 5, 9, 0, 6, 5, 0, 3, 6, 11, 6, 3, 8, 4, 7, -1},
-                                        {6, 5, 9, 6, 9, 11, 4, 7, 9, 7, 11, 9, -1, -1, -1, -1},
-                                        {10, 4, 9, 6, 4, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 10, 6, 4, 9, 10, 0, 8, 3, -1, -1, -1, -1, -1, -1, -1},
-                                        {10, 0, 1, 10, 6, 0, 6, 4, 0, -1, -1, -1, -1, -1, -1, -1},
-                                        {8, 3, 1, 8, 1, 6, 8, 6, 4, 6, 1, 10, -1, -1, -1, -1},
-                                        {1, 4, 9, 1, 2, 4, 2, 6, 4, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 0, 8, 1, 2, 9, 2, 4, 9, 2, 6, 4, -1, -1, -1, -1},
-                                        {0, 2, 4, 4, 2, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {8, 3, 2, 8, 2, 4, 4, 2, 6, -1, -1, -1, -1, -1, -1, -1},
-                                        {10, 4, 9, 10, 6, 4, 11, 2, 3, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 8, 2, 2, 8, 11, 4, 9, 10, 4, 10, 6, -1, -1, -1, -1},
-                                        {3, 11, 2, 0, 1, 6, 0, 6, 4, 6, 1, 10, -1, -1, -1, -1},
-                                        {6, 4, 1, 6, 1, 10, 4, 8, 1, 2, 1, 11, 8, 11, 1, -1},
-                                        {9, 6, 4, 9, 3, 6, 9, 1, 3, 11, 6, 3, -1, -1, -1, -1},
-                                        {8, 11, 1, 8, 1, 0, 11, 6, 1, 9, 1, 4, 6, 4, 1, -1},
-                                        {3, 11, 6, 3, 6, 0, 0, 6, 4, -1, -1, -1, -1, -1, -1, -1},
-                                        {6, 4, 8, 11, 6, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {7, 10, 6, 7, 8, 10, 8, 9, 10, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 7, 3, 0, 10, 7, 0, 9, 10, 6, 7, 10, -1, -1, -1, -1},
-                                        {10, 6, 7, 1, 10, 7, 1, 7, 8, 1, 8, 0, -1, -1, -1, -1},
-                                        {10, 6, 7, 10, 7, 1, 1, 7, 3, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 2, 6, 1, 6, 8, 1, 8, 9, 8, 6, 7, -1, -1, -1, -1},
-                                        {2, 6, 9, 2, 9, 1, 6, 7, 9, 0, 9, 3, 7, 3, 9, -1},
-                                        {7, 8, 0, 7, 0, 6, 6, 0, 2, -1, -1, -1, -1, -1, -1, -1},
-                                        {7, 3, 2, 6, 7, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {2, 3, 11, 10, 6, 8, 10, 8, 9, 8, 6, 7, -1, -1, -1, -1},
-                                        {2, 0, 7, 2, 7, 11, 0, 9, 7, 6, 7, 10, 9, 10, 7, -1},
-                                        {1, 8, 0, 1, 7, 8, 1, 10, 7, 6, 7, 10, 2, 3, 11, -1},
-                                        {11, 2, 1, 11, 1, 7, 10, 6, 1, 6, 7, 1, -1, -1, -1, -1},
-                                        {8, 9, 6, 8, 6, 7, 9, 1, 6, 11, 6, 3, 1, 3, 6, -1},
-                                        {0, 9, 1, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {7, 8, 0, 7, 0, 6, 3, 11, 0, 11, 6, 0, -1, -1, -1, -1},
-                                        {7, 11, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {7, 6, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 0, 8, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 1, 9, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {8, 1, 9, 8, 3, 1, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1},
-                                        {10, 1, 2, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 2, 10, 3, 0, 8, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1},
-                                        {2, 9, 0, 2, 10, 9, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1},
-                                        {6, 11, 7, 2, 10, 3, 10, 8, 3, 10, 9, 8, -1, -1, -1, -1},
-                                        {7, 2, 3, 6, 2, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {7, 0, 8, 7, 6, 0, 6, 2, 0, -1, -1, -1, -1, -1, -1, -1},
-                                        {2, 7, 6, 2, 3, 7, 0, 1, 9, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 6, 2, 1, 8, 6, 1, 9, 8, 8, 7, 6, -1, -1, -1, -1},
-                                        {10, 7, 6, 10, 1, 7, 1, 3, 7, -1, -1, -1, -1, -1, -1, -1},
-                                        {10, 7, 6, 1, 7, 10, 1, 8, 7, 1, 0, 8, -1, -1, -1, -1},
-                                        {0, 3, 7, 0, 7, 10, 0, 10, 9, 6, 10, 7, -1, -1, -1, -1},
-                                        {7, 6, 10, 7, 10, 8, 8, 10, 9, -1, -1, -1, -1, -1, -1, -1},
-                                        {6, 8, 4, 11, 8, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 6, 11, 3, 0, 6, 0, 4, 6, -1, -1, -1, -1, -1, -1, -1},
-                                        {8, 6, 11, 8, 4, 6, 9, 0, 1, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 4, 6, 9, 6, 3, 9, 3, 1, 11, 3, 6, -1, -1, -1, -1},
-                                        {6, 8, 4, 6, 11, 8, 2, 10, 1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 2, 10, 3, 0, 11, 0, 6, 11, 0, 4, 6, -1, -1, -1, -1},
-                                        {4, 11, 8, 4, 6, 11, 0, 2, 9, 2, 10, 9, -1, -1, -1, -1},
-                                        {10, 9, 3, 10, 3, 2, 9, 4, 3, 11, 3, 6, 4, 6, 3, -1},
-                                        {8, 2, 3, 8, 4, 2, 4, 6, 2, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 4, 2, 4, 6, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 9, 0, 2, 3, 4, 2, 4, 6, 4, 3, 8, -1, -1, -1, -1},
-                                        {1, 9, 4, 1, 4, 2, 2, 4, 6, -1, -1, -1, -1, -1, -1, -1},
-                                        {8, 1, 3, 8, 6, 1, 8, 4, 6, 6, 10, 1, -1, -1, -1, -1},
-                                        {10, 1, 0, 10, 0, 6, 6, 0, 4, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 6, 3, 4, 3, 8, 6, 10, 3, 0, 3, 9, 10, 9, 3, -1},
-                                        {10, 9, 4, 6, 10, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 9, 5, 7, 6, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 8, 3, 4, 9, 5, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1},
-                                        {5, 0, 1, 5, 4, 0, 7, 6, 11, -1, -1, -1, -1, -1, -1, -1},
-                                        {11, 7, 6, 8, 3, 4, 3, 5, 4, 3, 1, 5, -1, -1, -1, -1},
-                                        {9, 5, 4, 10, 1, 2, 7, 6, 11, -1, -1, -1, -1, -1, -1, -1},
-                                        {6, 11, 7, 1, 2, 10, 0, 8, 3, 4, 9, 5, -1, -1, -1, -1},
-                                        {7, 6, 11, 5, 4, 10, 4, 2, 10, 4, 0, 2, -1, -1, -1, -1},
-                                        {3, 4, 8, 3, 5, 4, 3, 2, 5, 10, 5, 2, 11, 7, 6, -1},
-                                        {7, 2, 3, 7, 6, 2, 5, 4, 9, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 5, 4, 0, 8, 6, 0, 6, 2, 6, 8, 7, -1, -1, -1, -1},
-                                        {3, 6, 2, 3, 7, 6, 1, 5, 0, 5, 4, 0, -1, -1, -1, -1},
-                                        {6, 2, 8, 6, 8, 7, 2, 1, 8, 4, 8, 5, 1, 5, 8, -1},
-                                        {9, 5, 4, 10, 1, 6, 1, 7, 6, 1, 3, 7, -1, -1, -1, -1},
-                                        {1, 6, 10, 1, 7, 6, 1, 0, 7, 8, 7, 0, 9, 5, 4, -1},
-                                        {4, 0, 10, 4, 10, 5, 0, 3, 10, 6, 10, 7, 3, 7, 10, -1},
-                                        {7, 6, 10, 7, 10, 8, 5, 4, 10, 4, 8, 10, -1, -1, -1, -1},
-                                        {6, 9, 5, 6, 11, 9, 11, 8, 9, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 6, 11, 0, 6, 3, 0, 5, 6, 0, 9, 5, -1, -1, -1, -1},
-                                        {0, 11, 8, 0, 5, 11, 0, 1, 5, 5, 6, 11, -1, -1, -1, -1},
-                                        {6, 11, 3, 6, 3, 5, 5, 3, 1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 2, 10, 9, 5, 11, 9, 11, 8, 11, 5, 6, -1, -1, -1, -1},
-                                        {0, 11, 3, 0, 6, 11, 0, 9, 6, 5, 6, 9, 1, 2, 10, -1},
-                                        {11, 8, 5, 11, 5, 6, 8, 0, 5, 10, 5, 2, 0, 2, 5, -1},
-                                        {6, 11, 3, 6, 3, 5, 2, 10, 3, 10, 5, 3, -1, -1, -1, -1},
-                                        {5, 8, 9, 5, 2, 8, 5, 6, 2, 3, 8, 2, -1, -1, -1, -1},
-                                        {9, 5, 6, 9, 6, 0, 0, 6, 2, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 5, 8, 1, 8, 0, 5, 6, 8, 3, 8, 2, 6, 2, 8, -1},
-                                        {1, 5, 6, 2, 1, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 3, 6, 1, 6, 10, 3, 8, 6, 5, 6, 9, 8, 9, 6, -1},
-                                        {10, 1, 0, 10, 0, 6, 9, 5, 0, 5, 6, 0, -1, -1, -1, -1},
-                                        {0, 3, 8, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {10, 5, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {11, 5, 10, 7, 5, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {11, 5, 10, 11, 7, 5, 8, 3, 0, -1, -1, -1, -1, -1, -1, -1},
-                                        {5, 11, 7, 5, 10, 11, 1, 9, 0, -1, -1, -1, -1, -1, -1, -1},
-                                        {10, 7, 5, 10, 11, 7, 9, 8, 1, 8, 3, 1, -1, -1, -1, -1},
-                                        {11, 1, 2, 11, 7, 1, 7, 5, 1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 8, 3, 1, 2, 7, 1, 7, 5, 7, 2, 11, -1, -1, -1, -1},
-                                        {9, 7, 5, 9, 2, 7, 9, 0, 2, 2, 11, 7, -1, -1, -1, -1},
-                                        {7, 5, 2, 7, 2, 11, 5, 9, 2, 3, 2, 8, 9, 8, 2, -1},
-                                        {2, 5, 10, 2, 3, 5, 3, 7, 5, -1, -1, -1, -1, -1, -1, -1},
-                                        {8, 2, 0, 8, 5, 2, 8, 7, 5, 10, 2, 5, -1, -1, -1, -1},
-                                        {9, 0, 1, 5, 10, 3, 5, 3, 7, 3, 10, 2, -1, -1, -1, -1},
-                                        {9, 8, 2, 9, 2, 1, 8, 7, 2, 10, 2, 5, 7, 5, 2, -1},
-                                        {1, 3, 5, 3, 7, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 8, 7, 0, 7, 1, 1, 7, 5, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 0, 3, 9, 3, 5, 5, 3, 7, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 8, 7, 5, 9, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {5, 8, 4, 5, 10, 8, 10, 11, 8, -1, -1, -1, -1, -1, -1, -1},
-                                        {5, 0, 4, 5, 11, 0, 5, 10, 11, 11, 3, 0, -1, -1, -1, -1},
-                                        {0, 1, 9, 8, 4, 10, 8, 10, 11, 10, 4, 5, -1, -1, -1, -1},
-                                        {10, 11, 4, 10, 4, 5, 11, 3, 4, 9, 4, 1, 3, 1, 4, -1},
-                                        {2, 5, 1, 2, 8, 5, 2, 11, 8, 4, 5, 8, -1, -1, -1, -1},
-                                        {0, 4, 11, 0, 11, 3, 4, 5, 11, 2, 11, 1, 5, 1, 11, -1},
-                                        {0, 2, 5, 0, 5, 9, 2, 11, 5, 4, 5, 8, 11, 8, 5, -1},
-                                        {9, 4, 5, 2, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {2, 5, 10, 3, 5, 2, 3, 4, 5, 3, 8, 4, -1, -1, -1, -1},
-                                        {5, 10, 2, 5, 2, 4, 4, 2, 0, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 10, 2, 3, 5, 10, 3, 8, 5, 4, 5, 8, 0, 1, 9, -1},
-                                        {5, 10, 2, 5, 2, 4, 1, 9, 2, 9, 4, 2, -1, -1, -1, -1},
-                                        {8, 4, 5, 8, 5, 3, 3, 5, 1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 4, 5, 1, 0, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {8, 4, 5, 8, 5, 3, 9, 0, 5, 0, 3, 5, -1, -1, -1, -1},
-                                        {9, 4, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 11, 7, 4, 9, 11, 9, 10, 11, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 8, 3, 4, 9, 7, 9, 11, 7, 9, 10, 11, -1, -1, -1, -1},
-                                        {1, 10, 11, 1, 11, 4, 1, 4, 0, 7, 4, 11, -1, -1, -1, -1},
-                                        {3, 1, 4, 3, 4, 8, 1, 10, 4, 7, 4, 11, 10, 11, 4, -1},
-                                        {4, 11, 7, 9, 11, 4, 9, 2, 11, 9, 1, 2, -1, -1, -1, -1},
-                                        {9, 7, 4, 9, 11, 7, 9, 1, 11, 2, 11, 1, 0, 8, 3, -1},
-                                        {11, 7, 4, 11, 4, 2, 2, 4, 0, -1, -1, -1, -1, -1, -1, -1},
-                                        {11, 7, 4, 11, 4, 2, 8, 3, 4, 3, 2, 4, -1, -1, -1, -1},
-                                        {2, 9, 10, 2, 7, 9, 2, 3, 7, 7, 4, 9, -1, -1, -1, -1},
-                                        {9, 10, 7, 9, 7, 4, 10, 2, 7, 8, 7, 0, 2, 0, 7, -1},
-                                        {3, 7, 10, 3, 10, 2, 7, 4, 10, 1, 10, 0, 4, 0, 10, -1},
-                                        {1, 10, 2, 8, 7, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 9, 1, 4, 1, 7, 7, 1, 3, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 9, 1, 4, 1, 7, 0, 8, 1, 8, 7, 1, -1, -1, -1, -1},
-                                        {4, 0, 3, 7, 4, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {4, 8, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 10, 8, 10, 11, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 0, 9, 3, 9, 11, 11, 9, 10, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 1, 10, 0, 10, 8, 8, 10, 11, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 1, 10, 11, 3, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 2, 11, 1, 11, 9, 9, 11, 8, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 0, 9, 3, 9, 11, 1, 2, 9, 2, 11, 9, -1, -1, -1, -1},
-                                        {0, 2, 11, 8, 0, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {3, 2, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {2, 3, 8, 2, 8, 10, 10, 8, 9, -1, -1, -1, -1, -1, -1, -1},
-                                        {9, 10, 2, 0, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {2, 3, 8, 2, 8, 10, 0, 1, 8, 1, 10, 8, -1, -1, -1, -1},
-                                        {1, 10, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {1, 3, 8, 9, 1, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 9, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {0, 3, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
-                                        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}};
-
-        struct MCube
-        {
-                glm::vec4 Corners[8];
-
-                glm::vec4 &LBB() { return Corners[0]; }
-                glm::vec4 &RBB() { return Corners[1]; }
-                glm::vec4 &RBF() { return Corners[2]; }
-                glm::vec4 &LBF() { return Corners[3]; }
-                glm::vec4 &LTB() { return Corners[4]; }
-                glm::vec4 &RTB() { return Corners[5]; }
-                glm::vec4 &RTF() { return Corners[6]; }
-                glm::vec4 &LTF() { return Corners[7]; }
-
-                int GetEdgeIndex()
-                {
-                    int index = 0;
-                    if (Corners[0].w < 0.0f) index |= 1;
-                    if (Corners[1].w < 0.0f) index |= 2;
-                    if (Corners[2].w < 0.0f) index |= 4;
-                    if (Corners[3].w < 0.0f) index |= 8;
-                    if (Corners[4].w < 0.0f) index |= 16;
-                    if (Corners[5].w < 0.0f) index |= 32;
-                    if (Corners[6].w < 0.0f) index |= 64;
-                    if (Corners[7].w < 0.0f) index |= 128;
-                    return index;
-                }
-        };
+        if (mesher == SDF_DUAL_CONTOURING)
+            Geometry::SDF::DualContouring::Polygonize(field, glm::vec3(-maxDistance), glm::vec3(maxDistance), gridResolution, Positions, Normals, Indices);
+        else
+            Geometry::SDF::MarchingCubes::Polygonize(field, glm::vec3(-maxDistance), glm::vec3(maxDistance), gridResolution, Positions, Normals, Indices);
 
-        static auto mLerp = [](const glm::vec4 &p1, const glm::vec4 &p2) -> glm::vec3
-        {
-            const float epsilon = 0.0001f;
-            if (std::abs(0.0f - p1.w) < epsilon) return xyz(p1);
-            if (std::abs(0.0f - p2.w) < epsilon) return xyz(p2);
-            if (std::abs(p1.w - p2.w) < epsilon) return xyz(p1);
-            float     t = (0.0f - p1.w) / (p2.w - p1.w);
-            glm::vec3 result({p1.x + t * (p2.x - p1.x), p1.y + t * (p2.y - p1.y), p1.z + t * (p2.z - p1.z)});
-            return result;
-        };
+        UV.resize(Positions.size());
+        for (unsigned int i = 0; i < Positions.size(); ++i)
+            UV[i] = xy(Positions[i]);
+        Geometry::TangentSpace::CalculateTangents(Positions, Normals, UV, Indices, Tangents, Bitangents);
+
+        Topology = TRIANGLES;
+        Finalize();
 
-        const uint16_t gridSize  = gridResolution;
-        const float    scale     = maxDistance;
-        const float    cubeScale = (1.0f / static_cast<float>(gridSize)) * 2.0f * scale; // range => [-scale, scale] => 2*scale
+        vantor::Backlog::Log("OpenGLMesh", "SDF mesh generation complete! (" + std::to_string(Indices.size() / 3) + " triangles)",
+                             vantor::Backlog::LogLevel::DEBUG);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Mesh::FromSDF(std::function<float(glm::vec3)> &sdf, float maxDistance, uint16_t gridResolution, SDF_MESHER mesher)
+    {
+        FromSDF(Geometry::SDF::Function(sdf), maxDistance, gridResolution, mesher);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Mesh::CalculateNormals(bool smooth)
+    {
+        if (Topology != TRIANGLES)
+        {
+            vantor::Backlog::Log("OpenGLMesh", "Normals can only be calculated for triangle lists.", vantor::Backlog::LogLevel::WARNING);
+            return;
+        }
 
-        for (uint16_t z = 0; z < gridSize; ++z)
+        if (!smooth)
         {
-            for (uint16_t y = 0; y < gridSize; ++y)
+            // one vertex per corner
+            auto unshare = [this](auto &attribute)
             {
-                for (uint16_t x = 0; x < gridSize; ++x)
-                {
-                    float     halfCube = cubeScale * 0.5f;
-                    glm::vec3 center({-scale + x * cubeScale + halfCube, -scale + y * cubeScale + halfCube, -scale + z * cubeScale + halfCube});
-
-                    MCube     voxel;
-                    glm::vec3 offset;
-                    // left-bottom-back
-                    offset        = glm::vec3(-halfCube, -halfCube, -halfCube);
-                    voxel.LBB()   = glm::vec4(center + offset, 0.0f);
-                    voxel.LBB().w = sdf(xyz(voxel.LBB()));
-                    // right-bottom-back
-                    offset        = glm::vec3(halfCube, -halfCube, -halfCube);
-                    voxel.RBB()   = glm::vec4(center + offset, 0.0f);
-                    voxel.RBB().w = sdf(xyz(voxel.RBB()));
-                    // right-bottom-front
-                    offset        = glm::vec3(halfCube, -halfCube, halfCube);
-                    voxel.RBF()   = glm::vec4(center + offset, 0.0f);
-                    voxel.RBF().w = sdf(xyz(voxel.RBF()));
-                    // left-bottom-front
-                    offset        = glm::vec3(-halfCube, -halfCube, halfCube);
-                    voxel.LBF()   = glm::vec4(center + offset, 0.0f);
-                    voxel.LBF().w = sdf(xyz(voxel.LBF()));
-                    // left-top-back
-                    offset        = glm::vec3(-halfCube, halfCube, -halfCube);
-                    voxel.LTB()   = glm::vec4(center + offset, 0.0f);
-                    voxel.LTB().w = sdf(xyz(voxel.LTB()));
-                    // right-top-back
-                    offset        = glm::vec3(halfCube, halfCube, -halfCube);
-                    voxel.RTB()   = glm::vec4(center + offset, 0.0f);
-                    voxel.RTB().w = sdf(xyz(voxel.RTB()));
-                    // right-top-front
-                    offset        = glm::vec3(halfCube, halfCube, halfCube);
-                    voxel.RTF()   = glm::vec4(center + offset, 0.0f);
-                    voxel.RTF().w = sdf(xyz(voxel.RTF()));
-                    // left-top-front
-                    offset        = glm::vec3(-halfCube, halfCube, halfCube);
-                    voxel.LTF()   = glm::vec4(center + offset, 0.0f);
-                    voxel.LTF().w = sdf(xyz(voxel.LTF()));
-
-                    // given all calculated data, generate this voxel's vertices
-                    std::vector<glm::vec3> vertList(12);
-
-                    int index = voxel.GetEdgeIndex();
-                    // edge table indexing from:
-                    // http://paulbourke.net/geometry/polygonise/
-                    if (edgeTable[index] == 0)
-                    {
-                    } // cube is in/out of surface, do nothing
-                    if (edgeTable[index] & 1)
-                    {
-                        vertList[0] = mLerp(voxel.Corners[0], voxel.Corners[1]);
-                    }
-                    if (edgeTable[index] & 2)
-                    {
-                        vertList[1] = mLerp(voxel.Corners[1], voxel.Corners[2]);
-                    }
-                    if (edgeTable[index] & 4)
-                    {
-                        vertList[2] = mLerp(voxel.Corners[2], voxel.Corners[3]);
-                    }
-                    if (edgeTable[index] & 8)
-                    {
-                        vertList[3] = mLerp(voxel.Corners[3], voxel.Corners[0]);
-                    }
-                    if (edgeTable[index] & 16)
-                    {
-                        vertList[4] = mLerp(voxel.Corners[4], voxel.Corners[5]);
-                    }
-                    if (edgeTable[index] & 32)
-                    {
-                        vertList[5] = mLerp(voxel.Corners[5], voxel.Corners[6]);
-                    }
-                    if (edgeTable[index] & 64)
-                    {
-                        vertList[6] = mLerp(voxel.Corners[6], voxel.Corners[7]);
-                    }
-                    if (edgeTable[index] & 128)
-                    {
-                        vertList[7] = mLerp(voxel.Corners[7], voxel.Corners[4]);
-                    }
-                    if (edgeTable[index] & 256)
-                    {
-                        vertList[8] = mLerp(voxel.Corners[0], voxel.Corners[4]);
-                    }
-                    if (edgeTable[index] & 512)
-                    {
-                        vertList[9] = mLerp(voxel.Corners[1], voxel.Corners[5]);
-                    }
-                    if (edgeTable[index] & 1024)
-                    {
-                        vertList[10] = mLerp(voxel.Corners[2], voxel.Corners[6]);
-                    }
-                    if (edgeTable[index] & 2048)
-                    {
-                        vertList[11] = mLerp(voxel.Corners[3], voxel.Corners[7]);
-                    }
-
-                    // generate triangle vertices
-                    for (uint16_t i = 0; triTable[index][i] != -1; i += 3)
-                    {
-                        glm::vec3 pos1 = vertList[triTable[index][i + 0]];
-                        glm::vec3 pos2 = vertList[triTable[index][i + 1]];
-                        glm::vec3 pos3 = vertList[triTable[index][i + 2]];
-                        Positions.push_back(pos1);
-                        Positions.push_back(pos2);
-                        Positions.push_back(pos3);
-
-                        glm::vec3 normal = glm::cross(glm::normalize(pos2 - pos1), glm::normalize(pos3 - pos1));
-                        Normals.push_back(normal);
-                        Normals.push_back(normal);
-                        Normals.push_back(normal);
-
-                        UV.push_back(xy(vertList[triTable[index][i + 0]]));
-                        UV.push_back(yz(vertList[triTable[index][i + 1]]));
-                        UV.push_back(xy(vertList[triTable[index][i + 2]]) * 0.5f + yz(vertList[triTable[index][i + 2]]) * 0.5f);
-                    }
-                }
+                if (attribute.size() != Positions.size()) return;
+                std::remove_reference_t<decltype(attribute)> result(Indices.size());
+                for (unsigned int c = 0; c < Indices.size(); ++c)
+                    result[c] = attribute[Indices[c]];
+                attribute.swap(result);
+            };
+            if (!Indices.empty())
+            {
+                unshare(UV);
+                unshare(Tangents);
+                unshare(Bitangents);
+                unshare(Positions);
             }
+            Indices.resize(Positions.size());
+            std::iota(Indices.begin(), Indices.end(), 0u);
         }
+        else if (Indices.empty())
+            Geometry::MeshOptimizer::Weld(this);
 
-        Topology = TRIANGLES;
-        Finalize();
-
-        vantor::Backlog::Log("OpenGLMesh", "SDF mesh generation complete!", vantor::Backlog::LogLevel::DEBUG);
+        Geometry::TangentSpace::CalculateNormals(Positions, Indices, Normals, smooth);
     }
     // --------------------------------------------------------------------------------------------
-    void Mesh::calculateNormals(bool smooth) {}
-    // --------------------------------------------------------------------------------------------
-    void Mesh::calculateTangents()
+    void Mesh::CalculateTangents()
     {
-        // tangents.resize(positions.size());
-        // bitangents.resize(positions.size());
-        // for (unsigned int i = 0; i < indices.size() - 2; ++i)
-        //{
-        //     unsigned int index1 = indices[i + 0];
-        //     unsigned int index2 = indices[i + 1];
-        //     unsigned int index3 = indices[i + 2];
-        //     // TODO: do we take different winding order into account for
-        //     triangle strip? glm::vec3 pos1 = positions[index1]; glm::vec3
-        //     pos2 = positions[index2]; glm::vec3 pos3 = positions[index3];
-
-        //    glm::vec2 uv1 = uv[index1];
-        //    glm::vec2 uv2 = uv[index2];
-        //    glm::vec2 uv3 = uv[index3];
-
-        //    // due to winding order getting changed each next triangle (as we
-        //    render as triangle strip) we
-        //    // change the order of the cross product to account for winding
-        //    order switch glm::vec3 edge1 = pos2 - pos1; glm::vec3 edge2 = pos3
-        //    - pos1; glm::vec2 deltaUV1 = uv2 - uv1; glm::vec2 deltaUV2 = uv3 -
-        //    uv1;
-
-        //    GLfloat f = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV2.x *
-        //    deltaUV1.y);
-
-        //    glm::vec3 tangent, bitangent;
-        //    tangent.x = f * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
-        //    tangent.y = f * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y);
-        //    tangent.z = f * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z);
-        //    /*    if (i % 2 == 0)
-        //    {*/
-        //    bitangent.x = f * (-deltaUV2.x * edge1.x + deltaUV1.x * edge2.x);
-        //    bitangent.y = f * (-deltaUV2.x * edge1.y + deltaUV1.x * edge2.y);
-        //    bitangent.z = f * (-deltaUV2.x * edge1.z + deltaUV1.x * edge2.z);
-        //    //}
-        //    /*    else
-        //    {
-        //    bitangent.x = f * (-deltaUV2.x * edge2.x + deltaUV1.x * edge1.x);
-        //    bitangent.y = f * (-deltaUV2.x * edge2.y + deltaUV1.x * edge1.y);
-        //    bitangent.z = f * (-deltaUV2.x * edge2.z + deltaUV1.x * edge1.z);
-        //    }*/
-        //    tangents[index1] += tangent;
-        //    tangents[index2] += tangent;
-        //    tangents[index3] += tangent;
-        //    bitangents[index1] += bitangent;
-        //    bitangents[index2] += bitangent;
-        //    bitangents[index3] += bitangent;
-        //}
-        //// normalize all tangents/bi-tangents
-        // for (int i = 0; i < tangents.size(); ++i)
-        //{
-        //     tangents[i] = glm::normalize(tangents[i]);
-        //     bitangents[i] = glm::normalize(bitangents[i]);
-        // }
+        if (Topology != TRIANGLES || Normals.size() != Positions.size() || UV.size() != Positions.size())
+        {
+            vantor::Backlog::Log("OpenGLMesh", "Tangents need a triangle list with normals and UVs.", vantor::Backlog::LogLevel::WARNING);
+            return;
+        }
+        if (Indices.empty()) Geometry::MeshOptimizer::Weld(this);
+
+        Geometry::TangentSpace::CalculateTangents(Positions, Normals, UV, Indices, Tangents, Bitangents);
     }
-} // namespace vantor::Graphics::RenderDevice::OpenGL
\ No newline at end of file
+} // namespace vantor::Graphics::RenderDevice::OpenGL
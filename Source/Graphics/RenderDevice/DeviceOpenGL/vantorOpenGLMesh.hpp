@@ -25,6 +25,7 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <cstdint>
 #include <vector>
 #include <functional>
 
@@ -32,6 +33,11 @@ inline glm::vec3 xyz(const glm::vec4 &v) { return glm::vec3(v.x, v.y, v.z); }
 inline glm::vec2 xy(const glm::vec3 &v) { return glm::vec2(v.x, v.y); }
 inline glm::vec2 yz(const glm::vec3 &v) { return glm::vec2(v.y, v.z); }
 
+namespace vantor::Graphics::Geometry::SDF
+{
+    class Field;
+} // namespace vantor::Graphics::Geometry::SDF
+
 namespace vantor::Graphics::RenderDevice::OpenGL
 {
 
@@ -46,6 +52,67 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         TRIANGLE_FAN,
     };
 
+    // ==== Vertex Formats ====
+    // Bits selecting compact encodings for Mesh::Finalize; they can be
+    // combined freely. Half float UVs need nothing from the shader, the other
+    // two are decoded through res/intern/shaders/common/vertex_format.glsl,
+    // so a mesh using them can only be drawn with shaders that include it.
+    enum VERTEX_FORMAT
+    {
+        VERTEX_FLOAT               = 0,
+        VERTEX_QUANTIZED_POSITIONS = 1 << 0, // 16 bit unorm relative to the mesh's bounding box
+        VERTEX_HALF_UVS            = 1 << 1,
+        VERTEX_OCTAHEDRAL_TBN      = 1 << 2, // 16 bit octahedral normal/tangent, bitangent as a sign
+        VERTEX_COMPACT             = VERTEX_QUANTIZED_POSITIONS | VERTEX_HALF_UVS | VERTEX_OCTAHEDRAL_TBN,
+    };
+
+    // ==== Vertex Layout ====
+    // Where and how a vertex buffer stores one attribute, as laid out by
+    // Mesh::Encode. Fixed size fields so layouts can be stored on disk as is.
+    struct VertexLayout
+    {
+            uint32_t Location;
+            int32_t  Components;
+            uint32_t Type; // GLenum
+            uint32_t Normalized;
+            uint32_t Size; // bytes per vertex
+            uint32_t Stride = 0;
+            uint64_t Offset = 0;
+    };
+
+    // ==== SDF Meshers ====
+    // Surface extraction used by Mesh::FromSDF.
+    enum SDF_MESHER
+    {
+        SDF_MARCHING_CUBES,  // smooth, rounds off edges; any field
+        SDF_DUAL_CONTOURING, // keeps sharp CSG features at far lower resolutions; needs a distance bound
+    };
+
+    // ==== Levels of Detail ====
+    // A range of Mesh::Indices drawing the mesh at reduced detail; all levels
+    // share the vertex buffer.
+    struct MeshLOD
+    {
+            unsigned int IndexOffset = 0;
+            unsigned int IndexCount  = 0;
+            float        Error       = 0.0f; // object space deviation from the full mesh
+    };
+
+    // ==== Meshlets ====
+    // A cluster of a few dozen triangles, contiguous in Mesh::Indices, with
+    // bounds to cull it on its own; see Geometry::MeshletBuilder.
+    struct Meshlet
+    {
+            unsigned int IndexOffset = 0;
+            unsigned int IndexCount  = 0;
+            glm::vec3    Center      = glm::vec3(0.0f);
+            float        Radius      = 0.0f;
+            // normal cone; every triangle faces away from an eye at e if
+            // dot(Center - e, ConeAxis) >= ConeCutoff * |Center - e| + Radius
+            glm::vec3 ConeAxis   = glm::vec3(0.0f, 0.0f, 1.0f);
+            float     ConeCutoff = 1.0f; // sine of the cone's half angle, 1 never culls
+    };
+
     /*
 
       =================== Base Mesh Class ====================
@@ -53,10 +120,28 @@ namespace vantor::Graphics::RenderDevice::OpenGL
     */
     class Mesh
     {
+        public:
+            // Finalize() encodes meshes of at least PARALLEL_THRESHOLD vertices
+            // on the job system, JOB_VERTICES per job, and writes vertex data of
+            // MAP_THRESHOLD bytes or more straight into the mapped buffer.
+            static constexpr unsigned int PARALLEL_THRESHOLD = 1 << 16;
+            static constexpr unsigned int JOB_VERTICES       = 1 << 14;
+            static constexpr size_t       MAP_THRESHOLD      = 1 << 20;
+
         public:
             unsigned int m_VAO = 0;
             unsigned int m_VBO;
             unsigned int m_EBO;
+            // GL_UNSIGNED_SHORT whenever the vertex count allows it
+            GLenum m_IndexType = GL_UNSIGNED_INT;
+            // what the GL buffers hold, which the CPU side attributes need
+            // not match (see Upload)
+            unsigned int m_VertexCount = 0;
+            unsigned int m_IndexCount  = 0;
+            unsigned int m_Format      = VERTEX_FLOAT; // VERTEX_FORMAT bits the vertex buffer is encoded with
+            // dequantization of VERTEX_QUANTIZED_POSITIONS: offset + unorm * scale
+            glm::vec3 m_PositionOffset = glm::vec3(0.0f);
+            glm::vec3 m_PositionScale  = glm::vec3(1.0f);
 
         public:
             std::vector<glm::vec3> Positions;
@@ -67,6 +152,15 @@ namespace vantor::Graphics::RenderDevice::OpenGL
 
             TOPOLOGY                  Topology = TRIANGLES;
             std::vector<unsigned int> Indices;
+            // finest first, see Geometry::MeshSimplifier; empty if Indices
+            // hold a single level
+            std::vector<MeshLOD> LODs;
+            // clusters covering the finest level, empty if not built
+            std::vector<Meshlet> Meshlets;
+
+            // VERTEX_FORMAT bits to encode the vertex buffer with; takes
+            // effect on the next Finalize(), see m_Format for the current one.
+            unsigned int Format = VERTEX_FLOAT;
 
             Mesh();
             Mesh(std::vector<glm::vec3> positions, std::vector<unsigned int> indices);
@@ -78,18 +172,47 @@ namespace vantor::Graphics::RenderDevice::OpenGL
                  std::vector<glm::vec3>    tangents,
                  std::vector<glm::vec3>    bitangents,
                  std::vector<unsigned int> indices);
+            virtual ~Mesh() = default;
 
             void SetPositions(std::vector<glm::vec3> positions);
             void SetUVs(std::vector<glm::vec2> uv);
             void SetNormals(std::vector<glm::vec3> normals);
             void SetTangents(std::vector<glm::vec3> tangents, std::vector<glm::vec3> bitangents);
 
-            void Finalize(bool interleaved = true);
-
-            void FromSDF(std::function<float(glm::vec3)> &sdf, float maxDistance, uint16_t gridResolution);
+            // per vertex shading frames, see Geometry::TangentSpace; both run
+            // before Finalize() and before LODs or meshlets are built. Flat
+            // normals give every triangle its own vertices, unindexed meshes
+            // are welded (Geometry::MeshOptimizer::Weld) before smoothing.
+            void CalculateNormals(bool smooth = true);
+            // needs normals and UVs
+            void CalculateTangents();
+
+            virtual void Finalize(bool interleaved = true);
+            // what Finalize(interleaved) would upload, without touching GL:
+            // the vertex buffer, its layout (returns the attribute count, at
+            // most 5) and the indices as m_IndexType. Sets the position
+            // dequantization; safe to call from worker threads.
+            unsigned int Encode(bool interleaved, std::vector<uint8_t> &vertices, VertexLayout layout[5], std::vector<uint8_t> &indices);
+            // uploads buffers encoded before, e.g. straight out of a memory
+            // mapped file; the CPU side attributes are left as they are and
+            // the position dequantization is expected to be set already.
+            virtual void Upload(const VertexLayout *layout,
+                                unsigned int        attributes,
+                                const void         *vertices,
+                                size_t              vertexBytes,
+                                unsigned int        vertexCount,
+                                const void         *indices,
+                                GLenum              indexType,
+                                unsigned int        indexCount);
+
+            // meshes the field over [-maxDistance, maxDistance]^3; the per point
+            // overload is kept for convenience, Geometry::SDF fields evaluate
+            // in vectorized batches and are much faster on large grids.
+            void FromSDF(const Geometry::SDF::Field &field, float maxDistance, uint16_t gridResolution, SDF_MESHER mesher = SDF_MARCHING_CUBES);
+            void FromSDF(std::function<float(glm::vec3)> &sdf, float maxDistance, uint16_t gridResolution, SDF_MESHER mesher = SDF_MARCHING_CUBES);
 
         private:
-            void calculateNormals(bool smooth = true);
-            void calculateTangents();
+            void uploadIndices();
+            void setAttributes(const VertexLayout *layout, unsigned int attributes);
     };
 } // namespace vantor::Graphics::RenderDevice::OpenGL
@@ -42,13 +42,13 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         {
             m_PostProcessShader = vantor::Resources::LoadShader("post process", "res/intern/shaders/screen_quad.vs", "res/intern/shaders/post_processing.fs");
             m_PostProcessShader->Use();
-            m_PostProcessShader->SetInt("TexSrc", 0);
-            m_PostProcessShader->SetInt("TexBloom1", 1);
-            m_PostProcessShader->SetInt("TexBloom2", 2);
-            m_PostProcessShader->SetInt("TexBloom3", 3);
-            m_PostProcessShader->SetInt("TexBloom4", 4);
-            m_PostProcessShader->SetInt("TexSSR", 5);
-            m_PostProcessShader->SetInt("gMotion", 6);
+            m_PostProcessShader->SetInt("TexSrc"_uid, 0);
+            m_PostProcessShader->SetInt("TexBloom1"_uid, 1);
+            m_PostProcessShader->SetInt("TexBloom2"_uid, 2);
+            m_PostProcessShader->SetInt("TexBloom3"_uid, 3);
+            m_PostProcessShader->SetInt("TexBloom4"_uid, 4);
+            m_PostProcessShader->SetInt("TexSSR"_uid, 5);
+            m_PostProcessShader->SetInt("gMotion"_uid, 6);
         }
         // down sample
         {
@@ -63,7 +63,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
 
             m_DownSampleShader = vantor::Resources::LoadShader("down sample", "res/intern/shaders/screen_quad.vs", "res/intern/shaders/post/down_sample.fs");
             m_DownSampleShader->Use();
-            m_DownSampleShader->SetInt("TexSrc", 0);
+            m_DownSampleShader->SetInt("TexSrc"_uid, 0);
         }
         // lower resolution downsample blurs
         {
@@ -82,7 +82,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             m_OnePassGaussianShader
                 = vantor::Resources::LoadShader("gaussian blur", "res/intern/shaders/screen_quad.vs", "res/intern/shaders/post/blur_guassian.fs");
             m_OnePassGaussianShader->Use();
-            m_OnePassGaussianShader->SetInt("TexSrc", 0);
+            m_OnePassGaussianShader->SetInt("TexSrc"_uid, 0);
         }
         // ssao
         {
@@ -91,9 +91,9 @@ namespace vantor::Graphics::RenderDevice::OpenGL
 
             m_SSAOShader = vantor::Resources::LoadShader("ssao", "res/intern/shaders/screen_quad.vs", "res/intern/shaders/post/ssao.fs");
             m_SSAOShader->Use();
-            m_SSAOShader->SetInt("gPositionMetallic", 0);
-            m_SSAOShader->SetInt("gNormalRoughness", 1);
-            m_SSAOShader->SetInt("texNoise", 2);
+            m_SSAOShader->SetInt("gPositionMetallic"_uid, 0);
+            m_SSAOShader->SetInt("gNormalRoughness"_uid, 1);
+            m_SSAOShader->SetInt("texNoise"_uid, 2);
 
             std::uniform_real_distribution<float> randomFloats(0.0f, 1.0f);
             std::default_random_engine            generator;
@@ -117,8 +117,8 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             m_SSAONoise = new Texture();
             m_SSAONoise->Generate(4, 4, GL_RGBA16F, GL_RGB, GL_HALF_FLOAT, &ssaoNoise[0]);
 
-            m_SSAOShader->SetVectorArray("kernel", ssaoKernel.size(), ssaoKernel);
-            m_SSAOShader->SetInt("sampleCount", SSAOKernelSize);
+            m_SSAOShader->SetVectorArray("kernel"_uid, ssaoKernel.size(), ssaoKernel);
+            m_SSAOShader->SetInt("sampleCount"_uid, SSAOKernelSize);
         }
         // bloom
         {
@@ -134,7 +134,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
 
             m_BloomShader = vantor::Resources::LoadShader("bloom", "res/intern/shaders/screen_quad.vs", "res/intern/shaders/post/bloom.fs");
             m_SSAOShader->Use();
-            m_SSAOShader->SetInt("HDRScene", 0);
+            m_SSAOShader->SetInt("HDRScene"_uid, 0);
         }
         // SSR
         {
@@ -143,14 +143,14 @@ namespace vantor::Graphics::RenderDevice::OpenGL
 
             m_SSRShader = vantor::Resources::LoadShader("ssr", "res/intern/shaders/screen_quad.vs", "res/intern/shaders/post/ssr.fs");
             m_SSRShader->Use();
-            m_SSRShader->SetInt("screenColor", 0);
-            m_SSRShader->SetInt("screenColorBlur", 1);
-            m_SSRShader->SetInt("gPositionMetallic", 2);
-            m_SSRShader->SetInt("gNormalRoughness", 3);
-            m_SSRShader->SetInt("gAlbedoAO", 4);
-            m_SSRShader->SetInt("envPrefilter", 5);
-            m_SSRShader->SetInt("BRDFLUT", 6);
-            m_SSRShader->SetInt("SSAO", 7);
+            m_SSRShader->SetInt("screenColor"_uid, 0);
+            m_SSRShader->SetInt("screenColorBlur"_uid, 1);
+            m_SSRShader->SetInt("gPositionMetallic"_uid, 2);
+            m_SSRShader->SetInt("gNormalRoughness"_uid, 3);
+            m_SSRShader->SetInt("gAlbedoAO"_uid, 4);
+            m_SSRShader->SetInt("envPrefilter"_uid, 5);
+            m_SSRShader->SetInt("BRDFLUT"_uid, 6);
+            m_SSRShader->SetInt("SSAO"_uid, 7);
         }
     }
     // --------------------------------------------------------------------------------------------
@@ -212,9 +212,9 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             m_SSAONoise->Bind(2);
 
             m_SSAOShader->Use();
-            m_SSAOShader->SetVector("renderSize", renderer->GetRenderSize());
-            m_SSAOShader->SetMatrix("projection", camera->Projection);
-            m_SSAOShader->SetMatrix("view", camera->View);
+            m_SSAOShader->SetVector("renderSize"_uid, renderer->GetRenderSize());
+            m_SSAOShader->SetMatrix("projection"_uid, camera->Projection);
+            m_SSAOShader->SetMatrix("view"_uid, camera->View);
 
             glBindFramebuffer(GL_FRAMEBUFFER, m_SSAORenderTarget->ID);
             glViewport(0, 0, m_SSAORenderTarget->Width, m_SSAORenderTarget->Height);
@@ -259,8 +259,8 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         if (SSR)
         {
             m_SSRShader->Use();
-            m_SSRShader->SetMatrix("projection", renderer->m_Camera->Projection);
-            m_SSRShader->SetMatrix("view", renderer->m_Camera->View);
+            m_SSRShader->SetMatrix("projection"_uid, renderer->m_Camera->Projection);
+            m_SSRShader->SetMatrix("view"_uid, renderer->m_Camera->View);
 
             output->GetColorTexture(0)->Bind(0);
             BlurredSixteenthOutput->Bind(1);
@@ -295,15 +295,15 @@ namespace vantor::Graphics::RenderDevice::OpenGL
 
         // set settings
         m_PostProcessShader->Use();
-        m_PostProcessShader->SetBool("SSAO", SSAO);
-        m_PostProcessShader->SetBool("Sepia", Sepia);
-        m_PostProcessShader->SetBool("Vignette", Vignette);
-        m_PostProcessShader->SetBool("Bloom", Bloom);
-        m_PostProcessShader->SetBool("SSR", SSR);
+        m_PostProcessShader->SetBool("SSAO"_uid, SSAO);
+        m_PostProcessShader->SetBool("Sepia"_uid, Sepia);
+        m_PostProcessShader->SetBool("Vignette"_uid, Vignette);
+        m_PostProcessShader->SetBool("Bloom"_uid, Bloom);
+        m_PostProcessShader->SetBool("SSR"_uid, SSR);
         // motion blur
-        m_PostProcessShader->SetBool("MotionBlur", MotionBlur);
-        m_PostProcessShader->SetFloat("MotionScale", ImGui::GetIO().Framerate / FPSTarget * 0.8);
-        m_PostProcessShader->SetInt("MotionSamples", 16);
+        m_PostProcessShader->SetBool("MotionBlur"_uid, MotionBlur);
+        m_PostProcessShader->SetFloat("MotionScale"_uid, ImGui::GetIO().Framerate / FPSTarget * 0.8);
+        m_PostProcessShader->SetInt("MotionSamples"_uid, 16);
 
         renderer->renderMesh(renderer->m_NDCPlane, m_PostProcessShader);
     }
@@ -352,7 +352,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         m_OnePassGaussianShader->Use();
         for (int i = 0; i < count; ++i, horizontal = !horizontal)
         {
-            m_OnePassGaussianShader->SetBool("horizontal", horizontal);
+            m_OnePassGaussianShader->SetBool("horizontal"_uid, horizontal);
             if (i == 0)
             {
                 src->Bind(0);
@@ -26,11 +26,14 @@
 
 #include "vantorOpenGLMesh.hpp"
 #include "../../Geometry/Primitives/vantorCube.hpp"
+#include "../../Geometry/Primitives/vantorPrimitiveCache.hpp"
 #include "../../Geometry/Primitives/vantorSphere.hpp"
 #include "vantorOpenGLMaterial.hpp"
+#include "vantorOpenGLMaterialTextures.hpp"
 #include "../../../Core/Scene/vantorScene.hpp"
 #include "../../../Core/Scene/vantorSceneNode.hpp"
 #include "../../../Core/Resource/vantorResource.hpp"
+#include "../../../Core/JobSystem/vantorJobSystem.h"
 
 #include <imgui/imgui.h>
 
@@ -42,6 +45,7 @@
 
 #include <stack>
 #include <algorithm>
+#include <unordered_map>
 
 namespace vantor::Graphics::RenderDevice::OpenGL
 {
@@ -52,9 +56,8 @@ namespace vantor::Graphics::RenderDevice::OpenGL
     {
         delete m_CommandBuffer;
 
-        delete m_NDCPlane;
-
         delete m_MaterialLibrary;
+        MaterialTextures::Clean();
 
         delete m_GBuffer;
         delete m_CustomTarget;
@@ -65,15 +68,15 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             delete m_ShadowRenderTargets[i];
         }
 
-        // lighting
-        delete m_DebugLightMesh;
-
         // post-processing
         delete m_PostProcessTarget1;
         delete m_PostProcessor;
 
         // pbr
         delete m_PBR;
+
+        // meshlet culling
+        glDeleteBuffers(1, &m_IndirectBuffer);
     }
     // ------------------------------------------------------------------------
     void Renderer::Init()
@@ -90,7 +93,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClearDepth(1.0f);
 
-        m_NDCPlane = new vantor::Graphics::Geometry::Primitives::Quad;
+        m_NDCPlane = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetQuad();
         glGenFramebuffers(1, &m_FramebufferCubemap);
         glGenRenderbuffers(1, &m_CubemapDepthRBO);
 
@@ -99,8 +102,8 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         m_PostProcessor      = new PostProcessor(this);
 
         // lights
-        m_DebugLightMesh    = new vantor::Graphics::Geometry::Primitives::Sphere(16, 16);
-        m_DeferredPointMesh = new vantor::Graphics::Geometry::Primitives::Sphere(16, 16);
+        m_DebugLightMesh    = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetSphere(16, 16);
+        m_DeferredPointMesh = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetSphere(16, 16);
 
         // deferred renderer
         m_GBuffer = new RenderTarget(1, 1, GL_HALF_FLOAT, 4, true);
@@ -128,7 +131,10 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         glGenBuffers(1, &m_GlobalUBO);
         glBindBuffer(GL_UNIFORM_BUFFER, m_GlobalUBO);
         glBufferData(GL_UNIFORM_BUFFER, 720, nullptr, GL_STREAM_DRAW);
-        glBindBufferBase(GL_UNIFORM_BUFFER, 0, m_GlobalUBO);
+        glBindBufferBase(GL_UNIFORM_BUFFER, UBO_BINDING_GLOBAL, m_GlobalUBO);
+
+        // meshlet culling
+        glGenBuffers(1, &m_IndirectBuffer);
 
         // default PBR pre-compute (get a more default oriented HDR map for
         // this)
@@ -216,6 +222,12 @@ namespace vantor::Graphics::RenderDevice::OpenGL
     // ------------------------------------------------------------------------
     void Renderer::RenderPushedCommands()
     {
+        // frame boundary: hot reloaded programs are swapped in here, never
+        // halfway through a frame
+        vantor::Resources::UpdateShaders();
+        // and background loaded models get their GL uploads, time sliced
+        vantor::Resources::UpdateMeshes();
+
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         /*
@@ -239,6 +251,9 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         */
         m_CommandBuffer->Sort();
 
+        // pooled material texture arrays stay bound for the whole frame
+        MaterialTextures::BindArrays();
+
         updateGlobalUBOs();
 
         m_GLCache.SetBlend(false);
@@ -468,6 +483,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         m_PrevViewProjection = m_Camera->Projection * m_Camera->View;
 
         m_CommandBuffer->Clear();
+        m_MaterialLibrary->recycleMaterialIDs();
 
         // clear render state
         m_RenderTargetsCustom.clear();
@@ -531,6 +547,27 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         CommandBuffer           commandBuffer(this);
         std::vector<Material *> materials;
 
+        // capture materials are instances of two templates; scenes reuse the
+        // same few texture sets over many meshes, so identical instances are
+        // collapsed into one.
+        Material                                 captureTemplate(m_PBR->m_ProbeCaptureShader);
+        Material                                 captureBackgroundTemplate(m_PBR->m_ProbeCaptureBackgroundShader);
+        std::unordered_map<uint64_t, Material *> uniqueMaterials;
+
+        auto collapse = [&](Material *material) -> Material *
+        {
+            uint64_t hash  = material->GetHash();
+            auto     found = uniqueMaterials.find(hash);
+            if (found != uniqueMaterials.end())
+            {
+                delete material;
+                return found->second;
+            }
+            uniqueMaterials[hash] = material;
+            materials.push_back(material);
+            return material;
+        };
+
         // originally a recursive function but transformed to iterative version
         std::stack<vantor::SceneNode *> sceneStack;
         sceneStack.push(scene);
@@ -540,31 +577,31 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             sceneStack.pop();
             if (node->Mesh)
             {
-                auto samplerUniforms = *(node->Material->GetSamplerUniforms());
-                if (samplerUniforms.find("TexAlbedo") != samplerUniforms.end())
+                Material *nodeMaterial = node->Material;
+                if (Texture *albedo = nodeMaterial->GetTexture("TexAlbedo"))
                 {
-                    materials.push_back(new Material(m_PBR->m_ProbeCaptureShader));
-                    materials[materials.size() - 1]->SetTexture("TexAlbedo", samplerUniforms["TexAlbedo"].Texture, 0);
-                    if (samplerUniforms.find("TexNormal") != samplerUniforms.end())
+                    Material *material = new Material(&captureTemplate);
+                    material->SetTexture("TexAlbedo", albedo, 0);
+                    if (Texture *normal = nodeMaterial->GetTexture("TexNormal"))
                     {
-                        materials[materials.size() - 1]->SetTexture("TexNormal", samplerUniforms["TexNormal"].Texture, 1);
+                        material->SetTexture("TexNormal", normal, 1);
                     }
-                    if (samplerUniforms.find("TexMetallic") != samplerUniforms.end())
+                    if (Texture *metallic = nodeMaterial->GetTexture("TexMetallic"))
                     {
-                        materials[materials.size() - 1]->SetTexture("TexMetallic", samplerUniforms["TexMetallic"].Texture, 2);
+                        material->SetTexture("TexMetallic", metallic, 2);
                     }
-                    if (samplerUniforms.find("TexRoughness") != samplerUniforms.end())
+                    if (Texture *roughness = nodeMaterial->GetTexture("TexRoughness"))
                     {
-                        materials[materials.size() - 1]->SetTexture("TexRoughness", samplerUniforms["TexRoughness"].Texture, 3);
+                        material->SetTexture("TexRoughness", roughness, 3);
                     }
-                    commandBuffer.Push(node->Mesh, materials[materials.size() - 1], node->GetTransform());
+                    commandBuffer.Push(node->Mesh, collapse(material), node->GetTransform());
                 }
-                else if (samplerUniforms.find("background") != samplerUniforms.end())
+                else if (TextureCube *background = nodeMaterial->GetTextureCube("background"))
                 { // we have a background scene node, add those as well
-                    materials.push_back(new Material(m_PBR->m_ProbeCaptureBackgroundShader));
-                    materials[materials.size() - 1]->SetTextureCube("background", samplerUniforms["background"].TextureCube, 0);
-                    materials[materials.size() - 1]->DepthCompare = node->Material->DepthCompare;
-                    commandBuffer.Push(node->Mesh, materials[materials.size() - 1], node->GetTransform());
+                    Material *material = new Material(&captureBackgroundTemplate);
+                    material->SetTextureCube("background", background, 0);
+                    material->DepthCompare = node->Material->DepthCompare;
+                    commandBuffer.Push(node->Mesh, collapse(material), node->GetTransform());
                 }
             }
             for (unsigned int i = 0; i < node->GetChildCount(); ++i)
@@ -610,79 +647,54 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             m_GLCache.SetCullFace(material->CullFace);
         }
 
-        material->GetShader()->Use();
+        // programs still being compiled in the background are substituted by
+        // a fallback until they are ready; don't stall the frame on them.
+        Shader   *shader   = material->GetShader();
+        Material *fallback = nullptr;
+        if (!shader->IsReady())
+        {
+            fallback = m_MaterialLibrary->getFallbackMaterial(material);
+            if (!fallback || !fallback->GetShader()->IsReady()) return;
+            shader = fallback->GetShader();
+        }
+
+        shader->Use();
         if (customCamera)
         {
-            material->GetShader()->SetMatrix("projection", customCamera->Projection);
-            material->GetShader()->SetMatrix("view", customCamera->View);
-            material->GetShader()->SetVector("CamPos", customCamera->Position);
+            shader->SetMatrix("projection"_uid, customCamera->Projection);
+            shader->SetMatrix("view"_uid, customCamera->View);
+            shader->SetVector("CamPos"_uid, customCamera->Position);
         }
-        material->GetShader()->SetMatrix("model", command->Transform);
-        material->GetShader()->SetMatrix("prevModel", command->PrevTransform);
+        shader->SetMatrix("model"_uid, command->Transform);
+        shader->SetMatrix("prevModel"_uid, command->PrevTransform);
 
-        material->GetShader()->SetBool("ShadowsEnabled", Shadows);
+        shader->SetBool("ShadowsEnabled"_uid, Shadows);
         if (Shadows && material->Type == MATERIAL_CUSTOM && material->ShadowReceive)
         {
-            for (int i = 0; i < m_DirectionalLights.size(); ++i)
+            static constexpr UniformID lightShadowViewProjectionIDs[4]
+                = {"lightShadowViewProjection1"_uid, "lightShadowViewProjection2"_uid, "lightShadowViewProjection3"_uid, "lightShadowViewProjection4"_uid};
+            for (int i = 0; i < m_DirectionalLights.size() && i < 4; ++i)
             {
                 if (m_DirectionalLights[i]->ShadowMapRT)
                 {
-                    material->GetShader()->SetMatrix("lightShadowViewProjection" + std::to_string(i + 1), m_DirectionalLights[i]->LightSpaceViewProjection);
+                    shader->SetMatrix(lightShadowViewProjectionIDs[i], m_DirectionalLights[i]->LightSpaceViewProjection);
                     m_DirectionalLights[i]->ShadowMapRT->GetDepthStencilTexture()->Bind(10 + i);
                 }
             }
         }
 
-        // bind/active uniform sampler/texture objects
-        auto *samplers = material->GetSamplerUniforms();
-        for (auto it = samplers->begin(); it != samplers->end(); ++it)
-        {
-            if (it->second.Type == SHADER_TYPE_SAMPLERCUBE)
-                it->second.TextureCube->Bind(it->second.Unit);
-            else
-                it->second.Texture->Bind(it->second.Unit);
-        }
-
-        // set uniform state of material
-        auto *uniforms = material->GetUniforms();
-        for (auto it = uniforms->begin(); it != uniforms->end(); ++it)
-        {
-            switch (it->second.Type)
-            {
-                case SHADER_TYPE_BOOL:
-                    material->GetShader()->SetBool(it->first, it->second.Bool);
-                    break;
-                case SHADER_TYPE_INT:
-                    material->GetShader()->SetInt(it->first, it->second.Int);
-                    break;
-                case SHADER_TYPE_FLOAT:
-                    material->GetShader()->SetFloat(it->first, it->second.Float);
-                    break;
-                case SHADER_TYPE_VEC2:
-                    material->GetShader()->SetVector(it->first, it->second.Vec2);
-                    break;
-                case SHADER_TYPE_VEC3:
-                    material->GetShader()->SetVector(it->first, it->second.Vec3);
-                    break;
-                case SHADER_TYPE_VEC4:
-                    material->GetShader()->SetVector(it->first, it->second.Vec4);
-                    break;
-                case SHADER_TYPE_MAT2:
-                    material->GetShader()->SetMatrix(it->first, it->second.Mat2);
-                    break;
-                case SHADER_TYPE_MAT3:
-                    material->GetShader()->SetMatrix(it->first, it->second.Mat3);
-                    break;
-                case SHADER_TYPE_MAT4:
-                    material->GetShader()->SetMatrix(it->first, it->second.Mat4);
-                    break;
-                default:
-                    vantor::Backlog::Log("OpenGLRenderer", "Unrecognized Uniform type set.", vantor::Backlog::LogLevel::ERR);
-                    break;
-            }
-        }
+        // textures plus the material's parameter block (or loose uniforms);
+        // a fallback program gets the fallback's block, with the material's
+        // textures bound over the fallback's.
+        if (fallback) fallback->Bind(shader);
+        material->Bind(shader);
 
-        renderMesh(mesh, material->GetShader());
+        // clusters are only culled against the main camera, custom ones
+        // (cubemap faces) don't keep their frustum up to date
+        if (ClusterCulling && !customCamera && command->LOD == 0 && !mesh->Meshlets.empty())
+            renderMeshlets(mesh, shader, command->Transform);
+        else
+            renderMesh(mesh, shader, command->LOD);
     }
     // ------------------------------------------------------------------------
     void Renderer::renderToCubemap(vantor::SceneNode *scene, TextureCube *target, glm::vec3 position, unsigned int mipLevel)
@@ -742,19 +754,105 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         }
     }
     // --------------------------------------------------------------------------------------------
-    void Renderer::renderMesh(Mesh *mesh, Shader *shader)
+    void Renderer::renderMesh(Mesh *mesh, Shader *shader, unsigned int lod)
     {
+        setVertexFormat(mesh, shader);
+
         glBindVertexArray(mesh->m_VAO);
-        if (mesh->Indices.size() > 0)
+        if (mesh->m_IndexCount > 0)
+        {
+            unsigned int offset = 0, count = mesh->m_IndexCount;
+            if (lod < mesh->LODs.size())
+            {
+                offset = mesh->LODs[lod].IndexOffset * (mesh->m_IndexType == GL_UNSIGNED_SHORT ? 2 : 4);
+                count  = mesh->LODs[lod].IndexCount;
+            }
+            glDrawElements(mesh->Topology == TRIANGLE_STRIP ? GL_TRIANGLE_STRIP : GL_TRIANGLES, count, mesh->m_IndexType, (GLvoid *) (uintptr_t) offset);
+        }
+        else
         {
-            glDrawElements(mesh->Topology == TRIANGLE_STRIP ? GL_TRIANGLE_STRIP : GL_TRIANGLES, mesh->Indices.size(), GL_UNSIGNED_INT, 0);
+            glDrawArrays(mesh->Topology == TRIANGLE_STRIP ? GL_TRIANGLE_STRIP : GL_TRIANGLES, 0, mesh->m_VertexCount);
         }
+    }
+    // --------------------------------------------------------------------------------------------
+    void Renderer::renderMeshlets(Mesh *mesh, Shader *shader, const glm::mat4 &transform)
+    {
+        const std::vector<Meshlet> &meshlets = mesh->Meshlets;
+        const unsigned int          count    = meshlets.size();
+
+        // bounds go to world space; the cone test only holds up under
+        // uniform scale
+        const glm::mat3 basis(transform);
+        const glm::vec3 scales(glm::length(basis[0]), glm::length(basis[1]), glm::length(basis[2]));
+        const float     scale   = std::max(std::max(scales.x, scales.y), scales.z);
+        const bool      cones   = scale > 0.0f && std::max(std::abs(scales.x - scales.y), std::abs(scales.y - scales.z)) <= 1e-3f * scale;
+        const glm::vec3 eye     = m_Camera->Position;
+        CameraFrustum  &frustum = m_Camera->Frustum;
+
+        m_MeshletVisible.resize(count);
+        auto cull = [&](unsigned int first, unsigned int last)
+        {
+            for (unsigned int i = first; i < last; ++i)
+            {
+                const Meshlet &meshlet = meshlets[i];
+                glm::vec3      center  = glm::vec3(transform * glm::vec4(meshlet.Center, 1.0f));
+                float          radius  = meshlet.Radius * scale;
+                bool           visible = frustum.Intersect(center, radius);
+                if (visible && cones && meshlet.ConeCutoff < 1.0f)
+                {
+                    glm::vec3 axis = glm::normalize(basis * meshlet.ConeAxis);
+                    glm::vec3 view = center - eye;
+                    visible        = glm::dot(view, axis) < meshlet.ConeCutoff * glm::length(view) + radius;
+                }
+                m_MeshletVisible[i] = visible;
+            }
+        };
+        // only worth spreading for the largest meshes
+        if (count >= MESHLET_JOB_SIZE * 4)
+            vantor::Core::JobSystem::ParallelFor((count + MESHLET_JOB_SIZE - 1) / MESHLET_JOB_SIZE,
+                                                 [&](uint32_t job) { cull(job * MESHLET_JOB_SIZE, std::min(count, (job + 1) * MESHLET_JOB_SIZE)); });
         else
+            cull(0, count);
+
+        // meshlets are back to back in the index buffer, so runs of visible
+        // ones merge into a single command
+        m_IndirectCommands.clear();
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            if (!m_MeshletVisible[i]) continue;
+            const Meshlet &meshlet = meshlets[i];
+            if (!m_IndirectCommands.empty() && m_IndirectCommands.back().FirstIndex + m_IndirectCommands.back().Count == meshlet.IndexOffset)
+                m_IndirectCommands.back().Count += meshlet.IndexCount;
+            else
+                m_IndirectCommands.push_back({meshlet.IndexCount, 1, meshlet.IndexOffset, 0, 0});
+        }
+        if (m_IndirectCommands.empty()) return;
+        if (m_IndirectCommands.size() == 1 && m_IndirectCommands[0].Count == meshlets.back().IndexOffset + meshlets.back().IndexCount)
         {
-            glDrawArrays(mesh->Topology == TRIANGLE_STRIP ? GL_TRIANGLE_STRIP : GL_TRIANGLES, 0, mesh->Positions.size());
+            // nothing culled
+            renderMesh(mesh, shader, 0);
+            return;
         }
+
+        setVertexFormat(mesh, shader);
+        glBindVertexArray(mesh->m_VAO);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, m_IndirectCommands.size() * sizeof(IndirectDrawCommand), m_IndirectCommands.data(), GL_STREAM_DRAW);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, mesh->m_IndexType, nullptr, m_IndirectCommands.size(), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
     }
     // --------------------------------------------------------------------------------------------
+    void Renderer::setVertexFormat(Mesh *mesh, Shader *shader)
+    {
+        // see common/vertex_format.glsl; a no-op for shaders without it
+        shader->SetInt("vertexFormat"_uid, mesh->m_Format);
+        if (mesh->m_Format & VERTEX_QUANTIZED_POSITIONS)
+        {
+            shader->SetVector("positionOffset"_uid, mesh->m_PositionOffset);
+            shader->SetVector("positionScale"_uid, mesh->m_PositionScale);
+        }
+    }
+    // ------------------------------------------------------------------------
     void Renderer::updateGlobalUBOs()
     {
         glBindBuffer(GL_UNIFORM_BUFFER, m_GlobalUBO);
@@ -804,15 +902,15 @@ namespace vantor::Graphics::RenderDevice::OpenGL
 
                     Shader *irradianceShader = m_MaterialLibrary->deferredIrradianceShader;
                     irradianceShader->Use();
-                    irradianceShader->SetVector("camPos", m_Camera->Position);
-                    irradianceShader->SetVector("probePos", probe->Position);
-                    irradianceShader->SetFloat("probeRadius", probe->Radius);
-                    irradianceShader->SetInt("SSAO", m_PostProcessor->SSAO);
+                    irradianceShader->SetVector("camPos"_uid, m_Camera->Position);
+                    irradianceShader->SetVector("probePos"_uid, probe->Position);
+                    irradianceShader->SetFloat("probeRadius"_uid, probe->Radius);
+                    irradianceShader->SetInt("SSAO"_uid, m_PostProcessor->SSAO);
 
                     glm::mat4 model;
                     glm::translate(model, probe->Position);
                     glm::scale(model, glm::vec3(probe->Radius));
-                    irradianceShader->SetMatrix("model", model);
+                    irradianceShader->SetMatrix("model"_uid, model);
 
                     renderMesh(m_DeferredPointMesh, irradianceShader);
                 }
@@ -828,7 +926,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
 
             Shader *ambientShader = m_MaterialLibrary->deferredAmbientShader;
             ambientShader->Use();
-            ambientShader->SetInt("SSAO", m_PostProcessor->SSAO);
+            ambientShader->SetInt("SSAO"_uid, m_PostProcessor->SSAO);
             renderMesh(m_NDCPlane, ambientShader);
         }
     }
@@ -838,14 +936,14 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         Shader *dirShader = m_MaterialLibrary->deferredDirectionalShader;
 
         dirShader->Use();
-        dirShader->SetVector("camPos", m_Camera->Position);
-        dirShader->SetVector("lightDir", light->Direction);
-        dirShader->SetVector("lightColor", glm::normalize(light->Color) * light->Intensity);
-        dirShader->SetBool("ShadowsEnabled", Shadows);
+        dirShader->SetVector("camPos"_uid, m_Camera->Position);
+        dirShader->SetVector("lightDir"_uid, light->Direction);
+        dirShader->SetVector("lightColor"_uid, glm::normalize(light->Color) * light->Intensity);
+        dirShader->SetBool("ShadowsEnabled"_uid, Shadows);
 
         if (light->ShadowMapRT)
         {
-            dirShader->SetMatrix("lightShadowViewProjection", light->LightSpaceViewProjection);
+            dirShader->SetMatrix("lightShadowViewProjection"_uid, light->LightSpaceViewProjection);
             light->ShadowMapRT->GetDepthStencilTexture()->Bind(3);
         }
 
@@ -857,15 +955,15 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         Shader *pointShader = m_MaterialLibrary->deferredPointShader;
 
         pointShader->Use();
-        pointShader->SetVector("camPos", m_Camera->Position);
-        pointShader->SetVector("lightPos", light->Position);
-        pointShader->SetFloat("lightRadius", light->Radius);
-        pointShader->SetVector("lightColor", glm::normalize(light->Color) * light->Intensity);
+        pointShader->SetVector("camPos"_uid, m_Camera->Position);
+        pointShader->SetVector("lightPos"_uid, light->Position);
+        pointShader->SetFloat("lightRadius"_uid, light->Radius);
+        pointShader->SetVector("lightColor"_uid, glm::normalize(light->Color) * light->Intensity);
 
         glm::mat4 model;
         glm::translate(model, light->Position);
         glm::scale(model, glm::vec3(light->Radius));
-        pointShader->SetMatrix("model", model);
+        pointShader->SetMatrix("model"_uid, model);
 
         renderMesh(m_DeferredPointMesh, pointShader);
     }
@@ -874,10 +972,10 @@ namespace vantor::Graphics::RenderDevice::OpenGL
     {
         Shader *shadowShader = m_MaterialLibrary->dirShadowShader;
 
-        shadowShader->SetMatrix("projection", projection);
-        shadowShader->SetMatrix("view", view);
-        shadowShader->SetMatrix("model", command->Transform);
+        shadowShader->SetMatrix("projection"_uid, projection);
+        shadowShader->SetMatrix("view"_uid, view);
+        shadowShader->SetMatrix("model"_uid, command->Transform);
 
-        renderMesh(command->Mesh, shadowShader);
+        renderMesh(command->Mesh, shadowShader, command->LOD);
     }
 } // namespace vantor::Graphics::RenderDevice::OpenGL
\ No newline at end of file
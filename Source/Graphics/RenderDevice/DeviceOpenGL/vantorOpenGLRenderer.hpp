@@ -49,6 +49,7 @@ namespace vantor::Graphics::RenderDevice::OpenGL
     {
             friend PostProcessor;
             friend PBR;
+            friend CommandBuffer;
 
         public:
             bool IrradianceGI = true;
@@ -58,6 +59,11 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             bool LightVolumes = false;
             bool RenderProbes = false;
             bool Wireframe    = false;
+            // screen space error in pixels up to which coarser mesh LODs are
+            // drawn; 0 always draws the full meshes
+            float LODThreshold = 1.0f;
+            // frustum and normal cone culling per meshlet for meshes that have them
+            bool ClusterCulling = true;
 
         private:
             // render state
@@ -100,6 +106,12 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             // ubo
             unsigned int m_GlobalUBO;
 
+            // meshlet culling, spread over jobs of MESHLET_JOB_SIZE meshlets
+            static constexpr unsigned int    MESHLET_JOB_SIZE = 1024;
+            unsigned int                     m_IndirectBuffer = 0;
+            std::vector<IndirectDrawCommand> m_IndirectCommands;
+            std::vector<uint8_t>             m_MeshletVisible;
+
             // debug
             Mesh *m_DebugLightMesh;
 
@@ -144,7 +156,9 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             void renderToCubemap(vantor::SceneNode *scene, TextureCube *target, glm::vec3 position = glm::vec3(0.0f), unsigned int mipLevel = 0);
             void
             renderToCubemap(std::vector<RenderCommand> &renderCommands, TextureCube *target, glm::vec3 position = glm::vec3(0.0f), unsigned int mipLevel = 0);
-            void          renderMesh(Mesh *mesh, Shader *shader);
+            void          renderMesh(Mesh *mesh, Shader *shader, unsigned int lod = 0);
+            void          renderMeshlets(Mesh *mesh, Shader *shader, const glm::mat4 &transform);
+            void          setVertexFormat(Mesh *mesh, Shader *shader);
             void          updateGlobalUBOs();
             RenderTarget *getCurrentRenderTarget();
 
@@ -20,14 +20,98 @@
 
 // Must be loaded in ResourceManager!!
 
-#include "vantorOpenGlShader.hpp"
+#include "vantorOpenGLShader.hpp"
+#include "Shader/vantorOpenGLShaderCache.hpp"
+#include "vantorOpenGLExtensions.hpp"
+#include "vantorOpenGLMaterialTextures.hpp"
 #include "../../../Core/BackLog/vantorBacklog.h"
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <algorithm>
+
 namespace vantor::Graphics::RenderDevice::OpenGL
 {
+    namespace
+    {
+        SHADER_TYPE toShaderType(GLenum glType)
+        {
+            switch (glType)
+            {
+                case GL_BOOL:
+                    return SHADER_TYPE_BOOL;
+                case GL_INT:
+                    return SHADER_TYPE_INT;
+                case GL_FLOAT:
+                    return SHADER_TYPE_FLOAT;
+                case GL_SAMPLER_1D:
+                    return SHADER_TYPE_SAMPLER1D;
+                case GL_SAMPLER_2D:
+                    return SHADER_TYPE_SAMPLER2D;
+                case GL_SAMPLER_3D:
+                    return SHADER_TYPE_SAMPLER3D;
+                case GL_SAMPLER_CUBE:
+                    return SHADER_TYPE_SAMPLERCUBE;
+                case GL_SAMPLER_2D_ARRAY:
+                    return SHADER_TYPE_SAMPLER2DARRAY;
+                case GL_FLOAT_VEC2:
+                    return SHADER_TYPE_VEC2;
+                case GL_FLOAT_VEC3:
+                    return SHADER_TYPE_VEC3;
+                case GL_FLOAT_VEC4:
+                    return SHADER_TYPE_VEC4;
+                case GL_INT_VEC2:
+                    return SHADER_TYPE_IVEC2;
+                case GL_FLOAT_MAT2:
+                    return SHADER_TYPE_MAT2;
+                case GL_FLOAT_MAT3:
+                    return SHADER_TYPE_MAT3;
+                case GL_FLOAT_MAT4:
+                    return SHADER_TYPE_MAT4;
+                default:
+                    return SHADER_TYPE_BOOL;
+            }
+        }
+
+        bool isSampler(GLenum glType)
+        {
+            switch (glType)
+            {
+                case GL_SAMPLER_1D:
+                case GL_SAMPLER_2D:
+                case GL_SAMPLER_3D:
+                case GL_SAMPLER_CUBE:
+                case GL_SAMPLER_1D_SHADOW:
+                case GL_SAMPLER_2D_SHADOW:
+                case GL_SAMPLER_1D_ARRAY:
+                case GL_SAMPLER_2D_ARRAY:
+                case GL_SAMPLER_2D_ARRAY_SHADOW:
+                case GL_SAMPLER_2D_MULTISAMPLE:
+                case GL_SAMPLER_CUBE_SHADOW:
+                case GL_SAMPLER_CUBE_MAP_ARRAY:
+                case GL_SAMPLER_BUFFER:
+                case GL_INT_SAMPLER_2D:
+                case GL_UNSIGNED_INT_SAMPLER_2D:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        // "name[0]" -> "name"; struct members ("s[0].x") are left alone
+        std::string_view stripArray(std::string_view name)
+        {
+            if (name.empty() || name.back() != ']') return name;
+            return name.substr(0, name.rfind('['));
+        }
+    } // namespace
+
+    std::vector<Shader::BlockBinding> Shader::m_BlockBindings = {
+        {"Global"_uid.Hash, UBO_BINDING_GLOBAL, false},
+        {"Material"_uid.Hash, UBO_BINDING_MATERIAL, false},
+    };
+
     // --------------------------------------------------------------------------------------------
     Shader::Shader() {}
     // --------------------------------------------------------------------------------------------
@@ -36,12 +120,34 @@ namespace vantor::Graphics::RenderDevice::OpenGL
     void Shader::Load(std::string name, std::string vsCode, std::string fsCode, std::vector<std::string> defines)
     {
         Name = name;
-        // compile both shaders and link them
+        ID   = glCreateProgram();
+
+        // the material texture mode is compiled in; see common/material_textures.glsl
+        if (const char *define = MaterialTextures::GetShaderDefine()) defines.push_back(define);
+
+        // a cache hit skips compilation and linking entirely; the key covers
+        // the preprocessed sources, defines and driver so it never goes stale.
+        m_CacheKey = ShaderCache::ComputeKey(vsCode, fsCode, defines);
+        if (ShaderCache::LoadProgram(m_CacheKey, ID))
+        {
+            m_Linked = true;
+            reflect();
+            buildUniformTable();
+            assignTextureArrayUnits();
+            return;
+        }
+
+        // submit compile and link without querying any status so the driver
+        // is free to work on it in the background; the result is collected
+        // in finalize() once the program is first needed.
+        submit(vsCode, fsCode, defines);
+        m_Pending = true;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::submit(std::string vsCode, std::string fsCode, const std::vector<std::string> &defines)
+    {
         unsigned int vs = glCreateShader(GL_VERTEX_SHADER);
         unsigned int fs = glCreateShader(GL_FRAGMENT_SHADER);
-        ID              = glCreateProgram();
-        int  status;
-        char log[1024];
 
         // if a list of define statements is specified, add these  to the start
         // of the shader source, s.t. we can selectively compile different
@@ -71,6 +177,13 @@ namespace vantor::Graphics::RenderDevice::OpenGL
                 fsCode = fsCode.substr(fsCode.find("\n") + 1, fsCode.length() - 1);
                 fsMergedCode.push_back(firstLine + "\n");
             }
+            // bindless handles in uniform blocks need the extension enabled
+            // before any declaration.
+            if (MaterialTextures::GetMode() == MATERIAL_TEXTURE_BINDLESS)
+            {
+                vsMergedCode.push_back("#extension GL_ARB_bindless_texture : require\n");
+                fsMergedCode.push_back("#extension GL_ARB_bindless_texture : require\n");
+            }
             // then add define statements to the shader string list.
             for (unsigned int i = 0; i < defines.size(); ++i)
             {
@@ -107,23 +220,33 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         glCompileShader(vs);
         glCompileShader(fs);
 
-        glGetShaderiv(vs, GL_COMPILE_STATUS, &status);
+        glAttachShader(ID, vs);
+        glAttachShader(ID, fs);
+        glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(ID);
+
+        m_PendingVS = vs;
+        m_PendingFS = fs;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::finalize()
+    {
+        int  status;
+        char log[1024];
+
+        glGetShaderiv(m_PendingVS, GL_COMPILE_STATUS, &status);
         if (!status)
         {
-            glGetShaderInfoLog(vs, 1024, NULL, log);
-            vantor::Backlog::Log("OpenGLShader", "Vertex shader compilation error at: " + name + "!\n" + std::string(log), vantor::Backlog::LogLevel::ERR);
+            glGetShaderInfoLog(m_PendingVS, 1024, NULL, log);
+            vantor::Backlog::Log("OpenGLShader", "Vertex shader compilation error at: " + Name + "!\n" + std::string(log), vantor::Backlog::LogLevel::ERR);
         }
-        glGetShaderiv(fs, GL_COMPILE_STATUS, &status);
+        glGetShaderiv(m_PendingFS, GL_COMPILE_STATUS, &status);
         if (!status)
         {
-            glGetShaderInfoLog(fs, 1024, NULL, log);
-            vantor::Backlog::Log("OpenGLShader", "Fragment shader compilation error at: " + name + "!\n" + std::string(log), vantor::Backlog::LogLevel::ERR);
+            glGetShaderInfoLog(m_PendingFS, 1024, NULL, log);
+            vantor::Backlog::Log("OpenGLShader", "Fragment shader compilation error at: " + Name + "!\n" + std::string(log), vantor::Backlog::LogLevel::ERR);
         }
 
-        glAttachShader(ID, vs);
-        glAttachShader(ID, fs);
-        glLinkProgram(ID);
-
         glGetProgramiv(ID, GL_LINK_STATUS, &status);
         if (!status)
         {
@@ -131,137 +254,610 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             vantor::Backlog::Log("OpenGLShader", "Shader program linking error: \n" + std::string(log), vantor::Backlog::LogLevel::ERR);
         }
 
-        glDeleteShader(vs);
-        glDeleteShader(fs);
+        glDetachShader(ID, m_PendingVS);
+        glDetachShader(ID, m_PendingFS);
+        glDeleteShader(m_PendingVS);
+        glDeleteShader(m_PendingFS);
+        m_PendingVS = m_PendingFS = 0;
+        m_Pending                 = false;
+        m_Linked                  = status;
 
-        // query the number of active uniforms and attributes
-        int nrAttributes, nrUniforms;
-        glGetProgramiv(ID, GL_ACTIVE_ATTRIBUTES, &nrAttributes);
-        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &nrUniforms);
-        Attributes.resize(nrAttributes);
-        Uniforms.resize(nrUniforms);
+        if (status) ShaderCache::StoreProgram(m_CacheKey, ID);
 
-        // iterate over all active attributes
-        char buffer[128];
-        for (unsigned int i = 0; i < nrAttributes; ++i)
+        reflect();
+        buildUniformTable();
+        assignTextureArrayUnits();
+
+        // replay the uniform writes issued while the program was compiling
+        for (unsigned int i = 0; i < m_PendingUniforms.size(); ++i)
         {
-            GLenum glType;
-            glGetActiveAttrib(ID, i, sizeof(buffer), 0, &Attributes[i].Size, &glType, buffer);
-            Attributes[i].Name = std::string(buffer);
-            Attributes[i].Type = SHADER_TYPE_BOOL;
+            UniformID           id    = m_PendingUniforms[i].first;
+            const UniformValue &value = m_PendingUniforms[i].second;
+            switch (value.Type)
+            {
+                case SHADER_TYPE_BOOL:
+                    SetBool(id, value.Bool);
+                    break;
+                case SHADER_TYPE_INT:
+                    SetInt(id, value.Int);
+                    break;
+                case SHADER_TYPE_FLOAT:
+                    SetFloat(id, value.Float);
+                    break;
+                case SHADER_TYPE_VEC2:
+                    SetVector(id, value.Vec2);
+                    break;
+                case SHADER_TYPE_VEC3:
+                    SetVector(id, value.Vec3);
+                    break;
+                case SHADER_TYPE_VEC4:
+                    SetVector(id, value.Vec4);
+                    break;
+                case SHADER_TYPE_MAT2:
+                    SetMatrix(id, value.Mat2);
+                    break;
+                case SHADER_TYPE_MAT3:
+                    SetMatrix(id, value.Mat3);
+                    break;
+                case SHADER_TYPE_MAT4:
+                    SetMatrix(id, value.Mat4);
+                    break;
+                default:
+                    break;
+            }
+        }
+        m_PendingUniforms.clear();
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::reflect()
+    {
+        // program interface queries (GL 4.3) cover attributes, uniforms,
+        // uniform blocks and shader storage blocks alike.
+        char name[128];
+        int  count = 0;
 
-            Attributes[i].Location = glGetAttribLocation(ID, buffer);
+        glGetProgramInterfaceiv(ID, GL_PROGRAM_INPUT, GL_ACTIVE_RESOURCES, &count);
+        Attributes.resize(count);
+        const GLenum attributeProps[] = {GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION};
+        for (int i = 0; i < count; ++i)
+        {
+            int values[3];
+            glGetProgramResourceiv(ID, GL_PROGRAM_INPUT, i, 3, attributeProps, 3, NULL, values);
+            glGetProgramResourceName(ID, GL_PROGRAM_INPUT, i, sizeof(name), NULL, name);
+            Attributes[i].Name     = std::string(name);
+            Attributes[i].Type     = toShaderType(values[0]);
+            Attributes[i].Size     = values[1];
+            Attributes[i].Location = values[2];
         }
 
-        // iterate over all active uniforms
-        for (unsigned int i = 0; i < nrUniforms; ++i)
+        // uniform blocks come first in Blocks, so a uniform's block index is
+        // its index there; storage blocks follow.
+        Blocks.clear();
+        reflectBlocks(GL_UNIFORM_BLOCK, false);
+        unsigned int firstStorageBlock = Blocks.size();
+        reflectBlocks(GL_SHADER_STORAGE_BLOCK, true);
+
+        Uniforms.clear();
+        Samplers.clear();
+        glGetProgramInterfaceiv(ID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+        const GLenum uniformProps[] = {GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION, GL_BLOCK_INDEX};
+        for (int i = 0; i < count; ++i)
         {
-            GLenum glType;
-            glGetActiveUniform(ID, i, sizeof(buffer), 0, &Uniforms[i].Size, &glType, buffer);
-            Uniforms[i].Name = std::string(buffer);
-            Uniforms[i].Type = SHADER_TYPE_BOOL;
+            int values[4];
+            glGetProgramResourceiv(ID, GL_UNIFORM, i, 4, uniformProps, 4, NULL, values);
+            if (values[3] >= 0) continue; // block member, see reflectMembers
 
-            Uniforms[i].Location = glGetUniformLocation(ID, buffer);
+            glGetProgramResourceName(ID, GL_UNIFORM, i, sizeof(name), NULL, name);
+            Uniform uniform;
+            uniform.Name     = std::string(name);
+            uniform.Type     = toShaderType(values[0]);
+            uniform.Size     = values[1];
+            uniform.Location = values[2];
+            Uniforms.push_back(uniform);
+
+            if (isSampler(values[0]))
+            {
+                // the unit from layout(binding = N), 0 otherwise
+                ShaderSampler sampler;
+                sampler.Hash     = vantor::Helpers::hashID(stripArray(name));
+                sampler.Type     = uniform.Type;
+                sampler.Location = values[2];
+                sampler.Size     = values[1];
+                glGetUniformiv(ID, values[2], &sampler.Unit);
+                Samplers.push_back(sampler);
+            }
         }
+        reflectMembers(GL_UNIFORM, 0);
+        reflectMembers(GL_BUFFER_VARIABLE, firstStorageBlock);
+
+        const ShaderBlock *material = GetBlock("Material"_uid);
+        MaterialBlock               = material && !material->Storage ? material->Layout : UniformBlockLayout();
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::Use() { glUseProgram(ID); }
+    void Shader::reflectBlocks(unsigned int programInterface, bool storage)
+    {
+        int count = 0;
+        glGetProgramInterfaceiv(ID, programInterface, GL_ACTIVE_RESOURCES, &count);
+
+        char         name[128];
+        const GLenum blockProps[] = {GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE};
+        for (int i = 0; i < count; ++i)
+        {
+            int values[2];
+            glGetProgramResourceiv(ID, programInterface, i, 2, blockProps, 2, NULL, values);
+            glGetProgramResourceName(ID, programInterface, i, sizeof(name), NULL, name);
+
+            ShaderBlock block;
+            block.Name        = std::string(name);
+            block.Hash        = vantor::Helpers::hashID(block.Name);
+            block.Binding     = values[0];
+            block.Storage     = storage;
+            block.Layout.Size = values[1];
+
+            // fixed binding points are assigned here, once per program
+            for (unsigned int j = 0; j < m_BlockBindings.size(); ++j)
+            {
+                const BlockBinding &binding = m_BlockBindings[j];
+                if (binding.Hash != block.Hash || binding.Storage != storage) continue;
+
+                if (binding.Binding != block.Binding)
+                {
+                    if (storage)
+                        glShaderStorageBlockBinding(ID, i, binding.Binding);
+                    else
+                        glUniformBlockBinding(ID, i, binding.Binding);
+                    block.Binding = binding.Binding;
+                }
+                break;
+            }
+            Blocks.push_back(block);
+        }
+    }
     // --------------------------------------------------------------------------------------------
-    bool Shader::HasUniform(std::string name)
+    void Shader::reflectMembers(unsigned int programInterface, unsigned int firstBlock)
     {
-        for (unsigned int i = 0; i < Uniforms.size(); ++i)
+        int count = 0;
+        glGetProgramInterfaceiv(ID, programInterface, GL_ACTIVE_RESOURCES, &count);
+
+        char name[128];
+        // buffer variables report the stride of a top level array separately
+        const GLenum strideProp    = programInterface == GL_BUFFER_VARIABLE ? GL_TOP_LEVEL_ARRAY_STRIDE : GL_ARRAY_STRIDE;
+        const GLenum memberProps[] = {GL_TYPE, GL_ARRAY_SIZE, GL_BLOCK_INDEX, GL_OFFSET, GL_MATRIX_STRIDE, strideProp};
+        for (int i = 0; i < count; ++i)
         {
-            if (Uniforms[i].Name == name) return true;
+            int values[6];
+            glGetProgramResourceiv(ID, programInterface, i, 6, memberProps, 6, NULL, values);
+            if (values[2] < 0) continue;
+
+            ShaderBlock &block = Blocks[firstBlock + values[2]];
+            glGetProgramResourceName(ID, programInterface, i, sizeof(name), NULL, name);
+
+            // members of a named block instance are reported as "Block.x"
+            std::string_view memberName(name);
+            if (memberName.size() > block.Name.size() && memberName.substr(0, block.Name.size()) == block.Name && memberName[block.Name.size()] == '.')
+                memberName.remove_prefix(block.Name.size() + 1);
+
+            UniformBlockMember member;
+            member.Hash         = vantor::Helpers::hashID(stripArray(memberName));
+            member.Type         = toShaderType(values[0]);
+            member.ArraySize    = values[1];
+            member.Offset       = values[3];
+            member.MatrixStride = values[4];
+            member.ArrayStride  = values[5];
+            block.Layout.Members.push_back(member);
         }
-        return false;
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetInt(std::string location, int value)
+    const ShaderBlock *Shader::GetBlock(UniformID id) const
     {
-        int loc = getUniformLocation(location);
-        if (loc >= 0) glUniform1i(loc, value);
+        for (unsigned int i = 0; i < Blocks.size(); ++i)
+        {
+            if (Blocks[i].Hash == id.Hash) return &Blocks[i];
+        }
+        return nullptr;
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetBool(std::string location, bool value)
+    void Shader::SetBlockBinding(std::string_view name, unsigned int binding, bool storage)
     {
-        int loc = getUniformLocation(location);
-        if (loc >= 0) glUniform1i(loc, (int) value);
+        unsigned int hash = vantor::Helpers::hashID(name);
+        for (unsigned int i = 0; i < m_BlockBindings.size(); ++i)
+        {
+            if (m_BlockBindings[i].Hash == hash && m_BlockBindings[i].Storage == storage)
+            {
+                m_BlockBindings[i].Binding = binding;
+                return;
+            }
+        }
+        m_BlockBindings.push_back({hash, binding, storage});
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetFloat(std::string location, float value)
+    void Shader::assignTextureArrayUnits()
     {
-        int loc = getUniformLocation(location);
-        if (loc >= 0) glUniform1f(loc, value);
+        // the arrays stay bound to fixed units for the whole frame
+        int loc = getUniformLocation("TextureArrays"_uid);
+        if (loc < 0) return;
+
+        int units[MaterialTextures::MAX_ARRAYS];
+        for (unsigned int i = 0; i < MaterialTextures::MAX_ARRAYS; ++i)
+            units[i] = MaterialTextures::ARRAY_UNIT_BASE + i;
+        glProgramUniform1iv(ID, loc, MaterialTextures::MAX_ARRAYS, units);
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetVector(std::string location, glm::vec2 value)
+    bool Shader::IsReady()
     {
-        int loc = getUniformLocation(location);
-        if (loc >= 0) glUniform2fv(loc, 1, &value[0]);
+        if (!m_Pending) return true;
+
+        // without the extension any status query blocks anyway, so finish
+        // the program right away.
+        if (Extensions::ParallelShaderCompile)
+        {
+            int completed = GL_FALSE;
+            glGetProgramiv(ID, GL_COMPLETION_STATUS_KHR, &completed);
+            if (!completed) return false;
+        }
+        finalize();
+        return true;
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetVector(std::string location, glm::vec3 value)
+    void Shader::Use()
     {
-        int loc = getUniformLocation(location);
-        if (loc >= 0) glUniform3fv(loc, 1, &value[0]);
+        if (m_Pending) finalize();
+        glUseProgram(ID);
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetVector(std::string location, glm::vec4 value)
+    void Shader::Reload(std::string vsCode, std::string fsCode, std::vector<std::string> defines)
     {
-        int loc = getUniformLocation(location);
-        if (loc >= 0) glUniform4fv(loc, 1, &value[0]);
+        if (m_Reload)
+        {
+            // superseded by newer sources before it finished
+            glDeleteProgram(m_Reload->ID);
+            delete m_Reload;
+        }
+        // compiled through the regular path, so a parallel compile capable
+        // driver builds it in the background while this program keeps drawing
+        m_Reload = new Shader(Name, vsCode, fsCode, defines);
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetVectorArray(std::string location, int size, const std::vector<glm::vec2> &values)
+    bool Shader::UpdateReload()
     {
-        unsigned int loc = glGetUniformLocation(ID, location.c_str());
-        if (loc >= 0)
+        if (!m_Reload) return false;
+        if (!m_Reload->IsReady()) return false;
+
+        if (!m_Reload->m_Linked)
         {
-            glUniform2fv(loc, size, (float *) (&values[0].x));
+            vantor::Backlog::Log("OpenGLShader", "Reload of: " + Name + " failed, keeping the previous program.", vantor::Backlog::LogLevel::WARNING);
+            glDeleteProgram(m_Reload->ID);
         }
+        else
+        {
+            // writes made to this program so far (per frame ones included)
+            // carry over, as nothing else would set them again
+            copyUniforms(*m_Reload);
+            for (unsigned int i = 0; i < m_Reload->Samplers.size(); ++i)
+                glGetUniformiv(m_Reload->ID, m_Reload->Samplers[i].Location, &m_Reload->Samplers[i].Unit);
+
+            glDeleteProgram(ID);
+            ID             = m_Reload->ID;
+            Uniforms       = std::move(m_Reload->Uniforms);
+            Attributes     = std::move(m_Reload->Attributes);
+            Blocks         = std::move(m_Reload->Blocks);
+            Samplers       = std::move(m_Reload->Samplers);
+            MaterialBlock  = std::move(m_Reload->MaterialBlock);
+            m_UniformTable = std::move(m_Reload->m_UniformTable);
+            m_CacheKey     = m_Reload->m_CacheKey;
+            ++Revision;
+        }
+        delete m_Reload;
+        m_Reload = nullptr;
+        return true;
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::copyUniforms(Shader &target) const
+    {
+        for (const Uniform &uniform : Uniforms)
+        {
+            const Uniform *match = nullptr;
+            for (const Uniform &candidate : target.Uniforms)
+            {
+                if (candidate.Name == uniform.Name && candidate.Type == uniform.Type)
+                {
+                    match = &candidate;
+                    break;
+                }
+            }
+            if (!match) continue;
+
+            // array elements aren't guaranteed consecutive locations
+            std::string base = std::string(stripArray(uniform.Name));
+            int         size = std::min(uniform.Size, match->Size);
+            for (int i = 0; i < size; ++i)
+            {
+                int src = uniform.Location, dst = match->Location;
+                if (i > 0)
+                {
+                    std::string element = base + "[" + std::to_string(i) + "]";
+                    src                 = glGetUniformLocation(ID, element.c_str());
+                    dst                 = glGetUniformLocation(target.ID, element.c_str());
+                }
+                if (src < 0 || dst < 0) continue;
+
+                float floats[16];
+                int   ints[2];
+                switch (uniform.Type)
+                {
+                    case SHADER_TYPE_FLOAT:
+                        glGetUniformfv(ID, src, floats);
+                        glProgramUniform1fv(target.ID, dst, 1, floats);
+                        break;
+                    case SHADER_TYPE_VEC2:
+                        glGetUniformfv(ID, src, floats);
+                        glProgramUniform2fv(target.ID, dst, 1, floats);
+                        break;
+                    case SHADER_TYPE_VEC3:
+                        glGetUniformfv(ID, src, floats);
+                        glProgramUniform3fv(target.ID, dst, 1, floats);
+                        break;
+                    case SHADER_TYPE_VEC4:
+                        glGetUniformfv(ID, src, floats);
+                        glProgramUniform4fv(target.ID, dst, 1, floats);
+                        break;
+                    case SHADER_TYPE_MAT2:
+                        glGetUniformfv(ID, src, floats);
+                        glProgramUniformMatrix2fv(target.ID, dst, 1, GL_FALSE, floats);
+                        break;
+                    case SHADER_TYPE_MAT3:
+                        glGetUniformfv(ID, src, floats);
+                        glProgramUniformMatrix3fv(target.ID, dst, 1, GL_FALSE, floats);
+                        break;
+                    case SHADER_TYPE_MAT4:
+                        glGetUniformfv(ID, src, floats);
+                        glProgramUniformMatrix4fv(target.ID, dst, 1, GL_FALSE, floats);
+                        break;
+                    case SHADER_TYPE_IVEC2:
+                        glGetUniformiv(ID, src, ints);
+                        glProgramUniform2iv(target.ID, dst, 1, ints);
+                        break;
+                    default: // bool, int and samplers
+                        glGetUniformiv(ID, src, ints);
+                        glProgramUniform1iv(target.ID, dst, 1, ints);
+                        break;
+                }
+            }
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    bool Shader::HasUniform(UniformID id) const { return getUniformLocation(id) >= 0; }
+    // --------------------------------------------------------------------------------------------
+    bool Shader::HasUniform(std::string_view name) const { return HasUniform(UniformID(name)); }
+    // --------------------------------------------------------------------------------------------
+    void Shader::SetInt(UniformID id, int value)
+    {
+        if (m_Pending)
+        {
+            UniformValue deferred;
+            deferred.Type = SHADER_TYPE_INT;
+            deferred.Int  = value;
+            m_PendingUniforms.push_back(std::make_pair(id, deferred));
+            return;
+        }
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniform1i(ID, loc, value);
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetVectorArray(std::string location, int size, const std::vector<glm::vec3> &values)
+    void Shader::SetBool(UniformID id, bool value)
     {
-        unsigned int loc = glGetUniformLocation(ID, location.c_str());
-        if (loc >= 0)
+        if (m_Pending)
         {
-            glUniform3fv(loc, size, (float *) (&values[0].x));
+            UniformValue deferred;
+            deferred.Type = SHADER_TYPE_BOOL;
+            deferred.Bool = value;
+            m_PendingUniforms.push_back(std::make_pair(id, deferred));
+            return;
         }
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniform1i(ID, loc, (int) value);
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetVectorArray(std::string location, int size, const std::vector<glm::vec4> &values)
+    void Shader::SetFloat(UniformID id, float value)
     {
-        unsigned int loc = glGetUniformLocation(ID, location.c_str());
-        if (loc >= 0)
+        if (m_Pending)
         {
-            glUniform4fv(loc, size, (float *) (&values[0].x));
+            UniformValue deferred;
+            deferred.Type  = SHADER_TYPE_FLOAT;
+            deferred.Float = value;
+            m_PendingUniforms.push_back(std::make_pair(id, deferred));
+            return;
         }
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniform1f(ID, loc, value);
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetMatrix(std::string location, glm::mat2 value)
+    void Shader::SetVector(UniformID id, const glm::vec2 &value)
     {
-        int loc = getUniformLocation(location);
-        if (loc >= 0) glUniformMatrix2fv(loc, 1, GL_FALSE, &value[0][0]);
+        if (m_Pending)
+        {
+            UniformValue deferred;
+            deferred.Type = SHADER_TYPE_VEC2;
+            deferred.Vec2 = value;
+            m_PendingUniforms.push_back(std::make_pair(id, deferred));
+            return;
+        }
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniform2fv(ID, loc, 1, &value[0]);
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetMatrix(std::string location, glm::mat3 value)
+    void Shader::SetVector(UniformID id, const glm::vec3 &value)
     {
-        int loc = getUniformLocation(location);
-        if (loc >= 0) glUniformMatrix3fv(loc, 1, GL_FALSE, &value[0][0]);
+        if (m_Pending)
+        {
+            UniformValue deferred;
+            deferred.Type = SHADER_TYPE_VEC3;
+            deferred.Vec3 = value;
+            m_PendingUniforms.push_back(std::make_pair(id, deferred));
+            return;
+        }
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniform3fv(ID, loc, 1, &value[0]);
     }
     // --------------------------------------------------------------------------------------------
-    void Shader::SetMatrix(std::string location, glm::mat4 value)
+    void Shader::SetVector(UniformID id, const glm::vec4 &value)
     {
-        int loc = getUniformLocation(location);
-        if (loc >= 0) glUniformMatrix4fv(loc, 1, GL_FALSE, &value[0][0]);
+        if (m_Pending)
+        {
+            UniformValue deferred;
+            deferred.Type = SHADER_TYPE_VEC4;
+            deferred.Vec4 = value;
+            m_PendingUniforms.push_back(std::make_pair(id, deferred));
+            return;
+        }
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniform4fv(ID, loc, 1, &value[0]);
     }
     // --------------------------------------------------------------------------------------------
-    int Shader::getUniformLocation(std::string name)
+    void Shader::SetVectorArray(UniformID id, int size, const std::vector<glm::vec2> &values)
     {
+        if (m_Pending) finalize();
+
+        int loc = getUniformLocation(id);
+        if (loc >= 0 && !values.empty()) glProgramUniform2fv(ID, loc, size, &values[0].x);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::SetVectorArray(UniformID id, int size, const std::vector<glm::vec3> &values)
+    {
+        if (m_Pending) finalize();
+
+        int loc = getUniformLocation(id);
+        if (loc >= 0 && !values.empty()) glProgramUniform3fv(ID, loc, size, &values[0].x);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::SetVectorArray(UniformID id, int size, const std::vector<glm::vec4> &values)
+    {
+        if (m_Pending) finalize();
+
+        int loc = getUniformLocation(id);
+        if (loc >= 0 && !values.empty()) glProgramUniform4fv(ID, loc, size, &values[0].x);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::SetMatrix(UniformID id, const glm::mat2 &value)
+    {
+        if (m_Pending)
+        {
+            UniformValue deferred;
+            deferred.Type = SHADER_TYPE_MAT2;
+            deferred.Mat2 = value;
+            m_PendingUniforms.push_back(std::make_pair(id, deferred));
+            return;
+        }
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniformMatrix2fv(ID, loc, 1, GL_FALSE, &value[0][0]);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::SetMatrix(UniformID id, const glm::mat3 &value)
+    {
+        if (m_Pending)
+        {
+            UniformValue deferred;
+            deferred.Type = SHADER_TYPE_MAT3;
+            deferred.Mat3 = value;
+            m_PendingUniforms.push_back(std::make_pair(id, deferred));
+            return;
+        }
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniformMatrix3fv(ID, loc, 1, GL_FALSE, &value[0][0]);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::SetMatrix(UniformID id, const glm::mat4 &value)
+    {
+        if (m_Pending)
+        {
+            UniformValue deferred;
+            deferred.Type = SHADER_TYPE_MAT4;
+            deferred.Mat4 = value;
+            m_PendingUniforms.push_back(std::make_pair(id, deferred));
+            return;
+        }
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniformMatrix4fv(ID, loc, 1, GL_FALSE, &value[0][0]);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::SetMatrixArray(UniformID id, int size, const glm::mat2 *values)
+    {
+        if (m_Pending) finalize();
+
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniformMatrix2fv(ID, loc, size, GL_FALSE, &values[0][0][0]);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::SetMatrixArray(UniformID id, int size, const glm::mat3 *values)
+    {
+        if (m_Pending) finalize();
+
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniformMatrix3fv(ID, loc, size, GL_FALSE, &values[0][0][0]);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::SetMatrixArray(UniformID id, int size, const glm::mat4 *values)
+    {
+        if (m_Pending) finalize();
+
+        int loc = getUniformLocation(id);
+        if (loc >= 0) glProgramUniformMatrix4fv(ID, loc, size, GL_FALSE, &values[0][0][0]);
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::buildUniformTable()
+    {
+        // keep the load factor at or below 50% so probe sequences stay short
+        unsigned int capacity = 16;
+        while (capacity < Uniforms.size() * 4)
+            capacity <<= 1;
+        m_UniformTable.assign(capacity, UniformSlot());
+
         for (unsigned int i = 0; i < Uniforms.size(); ++i)
         {
-            if (Uniforms[i].Name == name) return Uniforms[i].Location;
+            const Uniform &uniform = Uniforms[i];
+            if ((int) uniform.Location < 0) continue; // uniform block members have no location
+
+            insertUniform(vantor::Helpers::hashID(uniform.Name), uniform.Location);
+            // arrays are reported as "name[0]"; also make them reachable by
+            // their plain name as glGetUniformLocation would.
+            std::size_t bracket = uniform.Name.find('[');
+            if (bracket != std::string::npos)
+            {
+                insertUniform(vantor::Helpers::hashID(std::string_view(uniform.Name).substr(0, bracket)), uniform.Location);
+            }
+        }
+    }
+    // --------------------------------------------------------------------------------------------
+    void Shader::insertUniform(unsigned int hash, int location)
+    {
+        unsigned int mask = m_UniformTable.size() - 1;
+        unsigned int i    = hash & mask;
+        while (m_UniformTable[i].Location >= 0)
+        {
+            if (m_UniformTable[i].Hash == hash)
+            {
+                if (m_UniformTable[i].Location != location)
+                {
+                    vantor::Backlog::Log("OpenGLShader", "Uniform name hash collision in shader: " + Name + "!", vantor::Backlog::LogLevel::WARNING);
+                }
+                return;
+            }
+            i = (i + 1) & mask;
+        }
+        m_UniformTable[i].Hash     = hash;
+        m_UniformTable[i].Location = location;
+    }
+    // --------------------------------------------------------------------------------------------
+    int Shader::getUniformLocation(UniformID id) const
+    {
+        if (m_UniformTable.empty()) return -1;
+
+        unsigned int mask = m_UniformTable.size() - 1;
+        unsigned int i    = id.Hash & mask;
+        while (m_UniformTable[i].Location >= 0)
+        {
+            if (m_UniformTable[i].Hash == id.Hash) return m_UniformTable[i].Location;
+            i = (i + 1) & mask;
         }
         return -1;
     }
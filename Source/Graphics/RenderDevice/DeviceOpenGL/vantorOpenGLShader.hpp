@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <utility>
 #include <vector>
 #include <string>
 
@@ -33,11 +35,55 @@ namespace vantor::Graphics::RenderDevice::OpenGL
     class Shader
     {
         public:
-            unsigned int ID;
+            unsigned int ID = 0;
             std::string  Name;
 
-            std::vector<Uniform>         Uniforms;
+            // everything below is reflected once per link (or binary load);
+            // nothing is queried from the driver at draw time.
+            std::vector<Uniform>         Uniforms; // default block uniforms only
             std::vector<VertexAttribute> Attributes;
+            std::vector<ShaderBlock>     Blocks;
+            std::vector<ShaderSampler>   Samplers;
+
+            // layout of the optional "Material" uniform block (Size is 0 if the
+            // program doesn't declare one); see Material::Bind.
+            UniformBlockLayout MaterialBlock;
+
+            // bumped every time a hot reload swaps in a new program, so state
+            // derived from the reflection above knows to rebuild.
+            uint32_t Revision = 0;
+
+        private:
+            // open-addressed (linear probing) table from hashed uniform name to
+            // location; rebuilt after every link, size is a power of two.
+            struct UniformSlot
+            {
+                    unsigned int Hash     = 0;
+                    int          Location = -1; // -1 marks an empty slot
+            };
+            std::vector<UniformSlot> m_UniformTable;
+
+            // compile/link state while the driver is still working on the
+            // program; uniform writes issued meanwhile are replayed once done.
+            bool                                            m_Pending   = false;
+            unsigned int                                    m_PendingVS = 0;
+            unsigned int                                    m_PendingFS = 0;
+            uint64_t                                        m_CacheKey  = 0;
+            bool                                            m_Linked    = false;
+            std::vector<std::pair<UniformID, UniformValue>> m_PendingUniforms;
+
+            // replacement program being compiled by Reload(); owned here
+            // until UpdateReload() swaps it in or throws it away.
+            Shader *m_Reload = nullptr;
+
+            // block name hash -> fixed binding point, shared by all programs
+            struct BlockBinding
+            {
+                    unsigned int Hash;
+                    unsigned int Binding;
+                    bool         Storage;
+            };
+            static std::vector<BlockBinding> m_BlockBindings;
 
         public:
             Shader();
@@ -45,28 +91,79 @@ namespace vantor::Graphics::RenderDevice::OpenGL
 
             void Load(std::string name, std::string vsCode, std::string fsCode, std::vector<std::string> defines = std::vector<std::string>());
 
+            // non-blocking check whether the program finished linking (with
+            // KHR_parallel_shader_compile); without the extension this
+            // finishes the program and always returns true.
+            bool IsReady();
+            // finishes the program first if it is still being compiled.
             void Use();
 
-            bool HasUniform(std::string name);
-
-            void SetInt(std::string location, int value);
-            void SetBool(std::string location, bool value);
-            void SetFloat(std::string location, float value);
-            void SetVector(std::string location, glm::vec2 value);
-            void SetVector(std::string location, glm::vec3 value);
-            void SetVector(std::string location, glm::vec4 value);
-            void SetVectorArray(std::string location, int size, const std::vector<glm::vec2> &values);
-            void SetVectorArray(std::string location, int size, const std::vector<glm::vec3> &values);
-            void SetVectorArray(std::string location, int size, const std::vector<glm::vec4> &values);
-            void SetMatrix(std::string location, glm::mat2 value);
-            void SetMatrix(std::string location, glm::mat3 value);
-            void SetMatrix(std::string location, glm::mat4 value);
-            void SetMatrixArray(std::string location, int size, glm::mat2 *values);
-            void SetMatrixArray(std::string location, int size, glm::mat3 *values);
-            void SetMatrixArray(std::string location, int size, glm::mat4 *values);
+            // compiles a replacement program from new sources next to the
+            // current one, which stays in use until UpdateReload() finds the
+            // replacement linked. Restarts if a reload is already underway.
+            void Reload(std::string vsCode, std::string fsCode, std::vector<std::string> defines = std::vector<std::string>());
+            // call between frames; swaps the replacement in once it linked
+            // (keeping the current uniform values), or drops it if it failed.
+            // Returns true once the reload is over, either way.
+            bool UpdateReload();
+            bool IsReloading() const { return m_Reload != nullptr; }
+
+            bool HasUniform(UniformID id) const;
+            bool HasUniform(std::string_view name) const;
+
+            // null if the program has no (uniform or storage) block of that name
+            const ShaderBlock *GetBlock(UniformID id) const;
+
+            // binds every block of that name to binding, in all programs
+            // loaded afterwards, regardless of its layout(binding) in the
+            // source. "Global" and "Material" are registered by default.
+            static void SetBlockBinding(std::string_view name, unsigned int binding, bool storage = false);
+
+            void SetInt(UniformID id, int value);
+            void SetBool(UniformID id, bool value);
+            void SetFloat(UniformID id, float value);
+            void SetVector(UniformID id, const glm::vec2 &value);
+            void SetVector(UniformID id, const glm::vec3 &value);
+            void SetVector(UniformID id, const glm::vec4 &value);
+            void SetVectorArray(UniformID id, int size, const std::vector<glm::vec2> &values);
+            void SetVectorArray(UniformID id, int size, const std::vector<glm::vec3> &values);
+            void SetVectorArray(UniformID id, int size, const std::vector<glm::vec4> &values);
+            void SetMatrix(UniformID id, const glm::mat2 &value);
+            void SetMatrix(UniformID id, const glm::mat3 &value);
+            void SetMatrix(UniformID id, const glm::mat4 &value);
+            void SetMatrixArray(UniformID id, int size, const glm::mat2 *values);
+            void SetMatrixArray(UniformID id, int size, const glm::mat3 *values);
+            void SetMatrixArray(UniformID id, int size, const glm::mat4 *values);
+
+            // name based overloads; hash the name on every call, so prefer the
+            // UniformID versions in per-draw code.
+            void SetInt(std::string_view name, int value) { SetInt(UniformID(name), value); }
+            void SetBool(std::string_view name, bool value) { SetBool(UniformID(name), value); }
+            void SetFloat(std::string_view name, float value) { SetFloat(UniformID(name), value); }
+            void SetVector(std::string_view name, const glm::vec2 &value) { SetVector(UniformID(name), value); }
+            void SetVector(std::string_view name, const glm::vec3 &value) { SetVector(UniformID(name), value); }
+            void SetVector(std::string_view name, const glm::vec4 &value) { SetVector(UniformID(name), value); }
+            void SetVectorArray(std::string_view name, int size, const std::vector<glm::vec2> &values) { SetVectorArray(UniformID(name), size, values); }
+            void SetVectorArray(std::string_view name, int size, const std::vector<glm::vec3> &values) { SetVectorArray(UniformID(name), size, values); }
+            void SetVectorArray(std::string_view name, int size, const std::vector<glm::vec4> &values) { SetVectorArray(UniformID(name), size, values); }
+            void SetMatrix(std::string_view name, const glm::mat2 &value) { SetMatrix(UniformID(name), value); }
+            void SetMatrix(std::string_view name, const glm::mat3 &value) { SetMatrix(UniformID(name), value); }
+            void SetMatrix(std::string_view name, const glm::mat4 &value) { SetMatrix(UniformID(name), value); }
+            void SetMatrixArray(std::string_view name, int size, const glm::mat2 *values) { SetMatrixArray(UniformID(name), size, values); }
+            void SetMatrixArray(std::string_view name, int size, const glm::mat3 *values) { SetMatrixArray(UniformID(name), size, values); }
+            void SetMatrixArray(std::string_view name, int size, const glm::mat4 *values) { SetMatrixArray(UniformID(name), size, values); }
 
         private:
-            int getUniformLocation(std::string name);
+            void submit(std::string vsCode, std::string fsCode, const std::vector<std::string> &defines);
+            void finalize();
+            void reflect();
+            void reflectBlocks(unsigned int programInterface, bool storage);
+            void reflectMembers(unsigned int programInterface, unsigned int firstBlock);
+            void assignTextureArrayUnits();
+            void copyUniforms(Shader &target) const;
+            void buildUniformTable();
+            void insertUniform(unsigned int hash, int location);
+            int  getUniformLocation(UniformID id) const;
     };
 
 } // namespace vantor::Graphics::RenderDevice::OpenGL
\ No newline at end of file
@@ -21,14 +21,23 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
 #include <glm/glm.hpp>
 
+#include "../../../Helpers/vantorString.hpp"
+
 namespace vantor::Graphics::RenderDevice::OpenGL
 {
 
     class Texture;
     class TextureCube;
 
+    // fixed uniform buffer binding points shared by all programs
+    constexpr unsigned int UBO_BINDING_GLOBAL   = 0; // common/uniforms.glsl
+    constexpr unsigned int UBO_BINDING_MATERIAL = 1; // per-material "Material" block
+
     enum SHADER_TYPE
     {
         SHADER_TYPE_BOOL,
@@ -38,14 +47,74 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         SHADER_TYPE_SAMPLER2D,
         SHADER_TYPE_SAMPLER3D,
         SHADER_TYPE_SAMPLERCUBE,
+        SHADER_TYPE_SAMPLER2DARRAY,
         SHADER_TYPE_VEC2,
         SHADER_TYPE_VEC3,
         SHADER_TYPE_VEC4,
+        SHADER_TYPE_IVEC2,
         SHADER_TYPE_MAT2,
         SHADER_TYPE_MAT3,
         SHADER_TYPE_MAT4,
     };
 
+    // Hashed uniform name; build it from a string literal (e.g. "model"_uid)
+    // to have the hash resolved at compile time instead of per call.
+    struct UniformID
+    {
+            unsigned int Hash;
+
+            constexpr UniformID() : Hash(0) {}
+            constexpr explicit UniformID(std::string_view name) : Hash(vantor::Helpers::hashID(name)) {}
+    };
+
+    constexpr UniformID operator""_uid(const char *name, std::size_t length) { return UniformID(std::string_view(name, length)); }
+
+    // placement of a single member inside a uniform or shader storage block
+    struct UniformBlockMember
+    {
+            unsigned int Hash;
+            SHADER_TYPE  Type;
+            unsigned int Offset;
+            unsigned int MatrixStride;
+            unsigned int ArrayStride; // 0 if not an array
+            int          ArraySize;   // 0 for a runtime-sized (SSBO) array
+    };
+
+    struct UniformBlockLayout
+    {
+            unsigned int                    Size = 0;
+            std::vector<UniformBlockMember> Members;
+
+            const UniformBlockMember *Find(unsigned int hash) const
+            {
+                for (unsigned int i = 0; i < Members.size(); ++i)
+                {
+                    if (Members[i].Hash == hash) return &Members[i];
+                }
+                return nullptr;
+            }
+    };
+
+    // uniform or shader storage block as reflected from a linked program
+    struct ShaderBlock
+    {
+            std::string        Name;
+            unsigned int       Hash;
+            unsigned int       Binding;
+            bool               Storage; // shader storage block instead of uniform block
+            UniformBlockLayout Layout;  // for storage blocks Size excludes a runtime-sized array
+    };
+
+    // sampler uniform and the texture unit it reads from
+    struct ShaderSampler
+    {
+            unsigned int Hash;
+            SHADER_TYPE  Type;
+            int          Location;
+            int          Size;
+            int          Unit;
+    };
+
     struct Uniform
     {
             SHADER_TYPE  Type;
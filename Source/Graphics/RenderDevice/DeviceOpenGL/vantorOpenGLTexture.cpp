@@ -22,10 +22,12 @@
 // #include <stb_image.h>
 
 #include "vantorOpenGLTexture.hpp"
+#include "vantorOpenGLExtensions.hpp"
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <algorithm>
 #include <assert.h>
 
 namespace vantor::Graphics::RenderDevice::OpenGL
@@ -78,6 +80,70 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         Unbind();
     }
     // --------------------------------------------------------------------------------------------
+    void Texture::GenerateImmutable(unsigned int width, unsigned int height, GLenum internalFormat, GLenum format, GLenum type, const void *data)
+    {
+        glGenTextures(1, &ID);
+
+        Width          = width;
+        Height         = height;
+        Depth          = 0;
+        InternalFormat = internalFormat;
+        Format         = format;
+        Type           = type;
+
+        unsigned int levels = 1;
+        if (Mipmapping)
+        {
+            unsigned int size = std::max(width, height);
+            while (size >>= 1)
+                ++levels;
+        }
+
+        assert(Target == GL_TEXTURE_2D);
+        Bind();
+        glTexStorage2D(Target, levels, internalFormat, width, height);
+        // data may be an offset into a bound pixel unpack buffer
+        glTexSubImage2D(Target, 0, 0, 0, width, height, format, type, data);
+        glTexParameteri(Target, GL_TEXTURE_MIN_FILTER, FilterMin);
+        glTexParameteri(Target, GL_TEXTURE_MAG_FILTER, FilterMax);
+        glTexParameteri(Target, GL_TEXTURE_WRAP_S, WrapS);
+        glTexParameteri(Target, GL_TEXTURE_WRAP_T, WrapT);
+        if (Mipmapping) glGenerateMipmap(Target);
+        Unbind();
+    }
+    // --------------------------------------------------------------------------------------------
+    void Texture::GenerateCompressed(unsigned int width, unsigned int height, GLenum internalFormat, unsigned int levels, unsigned int blockBytes,
+                                     const void *data)
+    {
+        glGenTextures(1, &ID);
+
+        Width          = width;
+        Height         = height;
+        Depth          = 0;
+        InternalFormat = internalFormat;
+        Mipmapping     = levels > 1;
+
+        assert(Target == GL_TEXTURE_2D);
+        Bind();
+        // immutable storage; compressed textures are never resized
+        glTexStorage2D(Target, levels, internalFormat, width, height);
+        // data may be an offset into a bound pixel unpack buffer
+        uintptr_t level = (uintptr_t) data;
+        for (unsigned int i = 0; i < levels; ++i)
+        {
+            unsigned int levelWidth  = std::max(width >> i, 1u);
+            unsigned int levelHeight = std::max(height >> i, 1u);
+            GLsizei      bytes       = ((levelWidth + 3) / 4) * ((levelHeight + 3) / 4) * blockBytes;
+            glCompressedTexSubImage2D(Target, i, 0, 0, levelWidth, levelHeight, internalFormat, bytes, (const void *) level);
+            level += bytes;
+        }
+        glTexParameteri(Target, GL_TEXTURE_MIN_FILTER, FilterMin);
+        glTexParameteri(Target, GL_TEXTURE_MAG_FILTER, FilterMax);
+        glTexParameteri(Target, GL_TEXTURE_WRAP_S, WrapS);
+        glTexParameteri(Target, GL_TEXTURE_WRAP_T, WrapT);
+        Unbind();
+    }
+    // --------------------------------------------------------------------------------------------
     void Texture::Generate(unsigned int width, unsigned int height, unsigned int depth, GLenum internalFormat, GLenum format, GLenum type, void *data)
     {
         glGenTextures(1, &ID);
@@ -165,6 +231,16 @@ namespace vantor::Graphics::RenderDevice::OpenGL
         if (bind) Bind();
         glTexParameteri(Target, GL_TEXTURE_MAG_FILTER, filter);
     }
+    // --------------------------------------------------------------------------------------------
+    uint64_t Texture::GetBindlessHandle()
+    {
+        if (!m_BindlessHandle && Extensions::BindlessTexture)
+        {
+            m_BindlessHandle = Extensions::GetTextureHandle(ID);
+            Extensions::MakeTextureHandleResident(m_BindlessHandle);
+        }
+        return m_BindlessHandle;
+    }
 
     // ======== Texture Cube (originally vantorTextureCube.cpp) ========
     TextureCube::TextureCube() {}
@@ -23,6 +23,7 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <cstdint>
 #include <vector>
 
 namespace vantor::Graphics::RenderDevice::OpenGL
@@ -50,6 +51,8 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             unsigned int Depth  = 0;
 
         private:
+            uint64_t m_BindlessHandle = 0;
+
         public:
             Texture();
             ~Texture();
@@ -58,6 +61,14 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             void Generate(unsigned int width, GLenum internalFormat, GLenum format, GLenum type, void *data);
             // 2D texture generation
             void Generate(unsigned int width, unsigned int height, GLenum internalFormat, GLenum format, GLenum type, void *data);
+            // 2D texture in immutable storage, with room for a full mip chain
+            // if Mipmapping; internalFormat has to be sized (GL_RGBA8, ...).
+            // Can't be resized.
+            void GenerateImmutable(unsigned int width, unsigned int height, GLenum internalFormat, GLenum format, GLenum type, const void *data);
+            // 2D texture from a block compressed (4x4 texel blocks) mip chain,
+            // every level largest first and tightly packed in data
+            void GenerateCompressed(unsigned int width, unsigned int height, GLenum internalFormat, unsigned int levels, unsigned int blockBytes,
+                                    const void *data);
             // 3D texture generation
             void Generate(unsigned int width, unsigned int height, unsigned int depth, GLenum internalFormat, GLenum format, GLenum type, void *data);
 
@@ -71,6 +82,11 @@ namespace vantor::Graphics::RenderDevice::OpenGL
             void SetWrapMode(GLenum wrapMode, bool bind = false);
             void SetFilterMin(GLenum filter, bool bind = false);
             void SetFilterMax(GLenum filter, bool bind = false);
+
+            // resident GL_ARB_bindless_texture handle, created on first call.
+            // The sampler state is frozen from then on, so change wrap/filter
+            // modes before the texture is used by a bindless material.
+            uint64_t GetBindlessHandle();
     };
 
     // ======== Texture Cube (originally vantorTextureCube.hpp) ========
@@ -0,0 +1,199 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLTextureUploader.cpp
+ *  Last Change: Automatically updated
+ */
+
+#include "vantorOpenGLTextureUploader.hpp"
+#include "vantorOpenGLExtensions.hpp"
+#include "../../../Core/BackLog/vantorBacklog.h"
+
+#include <cstring>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    namespace
+    {
+        // polls; deletes the fence once it is signaled
+        bool isSignaled(GLsync &fence)
+        {
+            if (!fence) return true;
+            if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) return false;
+            glDeleteSync(fence);
+            fence = nullptr;
+            return true;
+        }
+
+        void waitFence(GLsync &fence)
+        {
+            if (!fence) return;
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+                ;
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    } // namespace
+
+    TextureUploader::Buffer TextureUploader::m_Buffers[RING_SIZE];
+    unsigned int            TextureUploader::m_Current     = 0;
+    int                     TextureUploader::m_Bound       = -1;
+    size_t                  TextureUploader::m_FrameBudget = 16u << 20;
+    size_t                  TextureUploader::m_FrameBytes  = 0;
+    // --------------------------------------------------------------------------------------------
+    void TextureUploader::SetFrameBudget(size_t bytes) { m_FrameBudget = bytes; }
+    // --------------------------------------------------------------------------------------------
+    size_t TextureUploader::GetFrameBudget() { return m_FrameBudget; }
+    // --------------------------------------------------------------------------------------------
+    void TextureUploader::NewFrame() { m_FrameBytes = 0; }
+    // --------------------------------------------------------------------------------------------
+    bool TextureUploader::CanUpload(size_t bytes)
+    {
+        if (m_FrameBytes > 0 && m_FrameBytes + bytes > m_FrameBudget) return false;
+        if (bytes > MAX_BUFFER_BYTES) return true;
+        return !m_Buffers[m_Current].Reserved && isSignaled(m_Buffers[m_Current].Fence);
+    }
+    // --------------------------------------------------------------------------------------------
+    const void *TextureUploader::Begin(const void *data, size_t bytes)
+    {
+        m_FrameBytes += bytes;
+        if (bytes > MAX_BUFFER_BYTES || m_Buffers[m_Current].Reserved) return data;
+
+        Buffer &buffer = m_Buffers[m_Current];
+        waitFence(buffer.Fence);
+        allocate(buffer, bytes);
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.ID);
+        if (buffer.Mapping)
+        {
+            std::memcpy(buffer.Mapping, data, bytes);
+            glFlushMappedBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes);
+        }
+        else
+            glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, bytes, data);
+        m_Bound   = m_Current;
+        m_Current = (m_Current + 1) % RING_SIZE;
+
+        // pixel pointers are offsets into the bound buffer
+        return nullptr;
+    }
+    // --------------------------------------------------------------------------------------------
+    int TextureUploader::Reserve(size_t bytes)
+    {
+        m_FrameBytes += bytes;
+        if (bytes > MAX_BUFFER_BYTES || m_Buffers[m_Current].Reserved) return -1;
+
+        Buffer &buffer = m_Buffers[m_Current];
+        waitFence(buffer.Fence);
+        allocate(buffer, bytes);
+
+        buffer.Reserved = buffer.Mapping;
+        if (!buffer.Reserved)
+        {
+            // stays mapped until submitted; the buffer isn't used by GL meanwhile
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.ID);
+            buffer.Reserved = (uint8_t *) glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            if (!buffer.Reserved)
+            {
+                vantor::Backlog::Log("OpenGLTextureUploader", "Failed to map pixel unpack buffer.", vantor::Backlog::LogLevel::ERR);
+                return -1;
+            }
+        }
+        buffer.Bytes = bytes;
+
+        int reserved = m_Current;
+        m_Current    = (m_Current + 1) % RING_SIZE;
+        return reserved;
+    }
+    // --------------------------------------------------------------------------------------------
+    uint8_t *TextureUploader::GetMapping(int buffer) { return m_Buffers[buffer].Reserved; }
+    // --------------------------------------------------------------------------------------------
+    const void *TextureUploader::Submit(int buffer)
+    {
+        Buffer &reserved = m_Buffers[buffer];
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, reserved.ID);
+        if (reserved.Mapping)
+            glFlushMappedBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, reserved.Bytes);
+        else if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_FALSE)
+            vantor::Backlog::Log("OpenGLTextureUploader", "Pixel unpack buffer got corrupted while mapped.", vantor::Backlog::LogLevel::WARNING);
+        reserved.Reserved = nullptr;
+        m_Bound           = buffer;
+
+        // pixel pointers are offsets into the bound buffer
+        return nullptr;
+    }
+    // --------------------------------------------------------------------------------------------
+    void TextureUploader::Cancel(int buffer)
+    {
+        Buffer &reserved = m_Buffers[buffer];
+        if (!reserved.Mapping)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, reserved.ID);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        reserved.Reserved = nullptr;
+    }
+    // --------------------------------------------------------------------------------------------
+    void TextureUploader::End()
+    {
+        if (m_Bound < 0) return;
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        m_Buffers[m_Bound].Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_Bound                  = -1;
+    }
+    // --------------------------------------------------------------------------------------------
+    void TextureUploader::Release()
+    {
+        for (Buffer &buffer : m_Buffers)
+        {
+            if (buffer.Fence) glDeleteSync(buffer.Fence);
+            // deleting a buffer unmaps it
+            if (buffer.ID) glDeleteBuffers(1, &buffer.ID);
+            buffer = Buffer();
+        }
+        m_Current = 0;
+        m_Bound   = -1;
+    }
+    // --------------------------------------------------------------------------------------------
+    void TextureUploader::allocate(Buffer &buffer, size_t bytes)
+    {
+        if (buffer.ID && buffer.Capacity >= bytes) return;
+        if (buffer.ID) glDeleteBuffers(1, &buffer.ID);
+
+        // whole megabytes; textures of a model tend to share their size
+        buffer.Capacity = (bytes + (1u << 20) - 1) & ~(size_t) ((1u << 20) - 1);
+        buffer.Mapping  = nullptr;
+
+        glGenBuffers(1, &buffer.ID);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.ID);
+        if (Extensions::BufferStorage)
+        {
+            // dynamic storage keeps glBufferSubData working should mapping fail
+            const GLbitfield storage = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_DYNAMIC_STORAGE_BIT;
+            const GLbitfield access  = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+            glBufferStorage(GL_PIXEL_UNPACK_BUFFER, buffer.Capacity, nullptr, storage);
+            buffer.Mapping = (uint8_t *) glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, buffer.Capacity, access);
+            if (!buffer.Mapping)
+                vantor::Backlog::Log("OpenGLTextureUploader", "Failed to map pixel unpack buffer persistently.", vantor::Backlog::LogLevel::ERR);
+        }
+        else
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, buffer.Capacity, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+} // namespace vantor::Graphics::RenderDevice::OpenGL
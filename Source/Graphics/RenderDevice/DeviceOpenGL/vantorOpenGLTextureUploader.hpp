@@ -0,0 +1,112 @@
+/*
+ *  ╔═══════════════════════════════════════════════════════════════╗
+ *  ║                          ~ Vantor ~                           ║
+ *  ║                                                               ║
+ *  ║  This file is part of the Vantor Engine.                      ║
+ *  ║  Automatically formatted by vantorFormat.py                   ║
+ *  ║                                                               ║
+ *  ╚═══════════════════════════════════════════════════════════════╝
+ *
+ *  Copyright (c) 2025 Lukas Rennhofer
+ *  Licensed under the GNU General Public License, Version 3.
+ *  See LICENSE file for more details.
+ *
+ *  Author: Lukas Rennhofer
+ *  Date: 2025-05-12
+ *
+ *  File: vantorOpenGLTextureUploader.hpp
+ *  Last Change: Automatically updated
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vantor::Graphics::RenderDevice::OpenGL
+{
+    // Streams texture data to the GPU through a ring of pixel unpack
+    // buffers. An upload copies its data into the next buffer and the
+    // glTex(Sub)Image calls read from there, so the driver copies nothing
+    // out of client memory behind the call. A fence per buffer keeps it from
+    // being overwritten while the GPU still reads it. With
+    // GL_ARB_buffer_storage the buffers stay mapped persistently, otherwise
+    // they're filled with glBufferSubData or mapped while reserved.
+    //
+    //   const void *pixels = TextureUploader::Begin(data, bytes);
+    //   glTexSubImage2D(..., pixels);
+    //   TextureUploader::End();
+    //
+    // Reserve() hands out a buffer's memory instead, so the copy can run on
+    // a worker and the render thread only issues the GL calls:
+    //
+    //   int      buffer = TextureUploader::Reserve(bytes);   // render thread
+    //   uint8_t *target = TextureUploader::GetMapping(buffer);
+    //   memcpy(target, data, bytes);                          // any thread
+    //   glTexSubImage2D(..., TextureUploader::Submit(buffer)); // render thread
+    //   TextureUploader::End();
+    class TextureUploader
+    {
+        public:
+            static constexpr unsigned int RING_SIZE = 4;
+            // larger uploads skip the ring rather than growing a buffer for them
+            static constexpr size_t MAX_BUFFER_BYTES = 64u << 20;
+
+        private:
+            struct Buffer
+            {
+                    unsigned int ID       = 0;
+                    size_t       Capacity = 0;
+                    uint8_t     *Mapping  = nullptr; // persistent, null without GL_ARB_buffer_storage
+                    GLsync       Fence    = nullptr; // signaled once the GPU read the last upload
+                    uint8_t     *Reserved = nullptr; // where the reserved bytes go until submitted
+                    size_t       Bytes    = 0;
+            };
+
+            static Buffer       m_Buffers[RING_SIZE];
+            static unsigned int m_Current;
+            static int          m_Bound; // -1 if none
+            static size_t       m_FrameBudget;
+            static size_t       m_FrameBytes;
+
+        public:
+            // bytes streamed per frame by callers that check CanUpload()
+            static void   SetFrameBudget(size_t bytes);
+            static size_t GetFrameBudget();
+            // starts counting the frame's bytes anew; once per frame
+            static void NewFrame();
+            // whether bytes fit into this frame's budget and the next buffer
+            // is free, i.e. Begin() or Reserve() wouldn't wait on the GPU. The
+            // first upload of a frame is always within budget.
+            static bool CanUpload(size_t bytes);
+
+            // copies data into the next buffer and binds it to
+            // GL_PIXEL_UNPACK_BUFFER; returns the offset to pass as pixel
+            // pointer. Waits for the buffer if the GPU still reads it. Data
+            // is read from client memory while the next buffer is reserved.
+            static const void *Begin(const void *data, size_t bytes);
+
+            // reserves the next buffer for bytes written later, possibly from
+            // another thread; -1 if they're to be read from client memory
+            // (too large, or the buffer is reserved already). Waits for the
+            // buffer if the GPU still reads it.
+            static int Reserve(size_t bytes);
+            // the memory of a reserved buffer, valid until Submit()/Cancel()
+            static uint8_t *GetMapping(int buffer);
+            // once the reserved bytes are written: binds the buffer like
+            // Begin() and returns the offset to pass as pixel pointer
+            static const void *Submit(int buffer);
+            // gives up a reservation without uploading from it
+            static void Cancel(int buffer);
+
+            // unbinds the buffer and fences the uploads issued from it
+            static void End();
+
+            static void Release();
+
+        private:
+            static void allocate(Buffer &buffer, size_t bytes);
+    };
+} // namespace vantor::Graphics::RenderDevice::OpenGL
@@ -25,7 +25,7 @@
 #include "../../../Core/Scene/vantorScene.hpp"
 #include "../../../Core/Resource/vantorResource.hpp"
 
-#include "../../Geometry/Primitives/vantorCube.hpp"
+#include "../../Geometry/Primitives/vantorPrimitiveCache.hpp"
 
 namespace vantor::Graphics
 {
@@ -36,7 +36,7 @@ namespace vantor::Graphics
 
         m_Shader = vantor::Resources::LoadShader("background", "res/intern/shaders/background.vs", "res/intern/shaders/background.fs");
         Material = new vantor::Graphics::RenderDevice::OpenGL::Material(m_Shader);
-        Mesh     = new vantor::Graphics::Geometry::Primitives::Cube;
+        Mesh     = vantor::Graphics::Geometry::Primitives::PrimitiveCache::GetCube();
         BoxMin   = glm::vec3(-99999.0);
         BoxMax   = glm::vec3(99999.0);
 
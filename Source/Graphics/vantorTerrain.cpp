@@ -237,13 +237,19 @@ namespace vantor::Graphics
     {
         if (posBuffer)
         {
-            this->deleteBuffer();
+            // orphan and refill instead of recreating the buffer and the
+            // attribute setup every time the camera changes tiles
+            glBindBuffer(GL_ARRAY_BUFFER, posBuffer);
+            glBufferData(GL_ARRAY_BUFFER, pos.size() * sizeof(glm::vec2), nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, pos.size() * sizeof(glm::vec2), &pos[0]);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            return;
         }
 
         // vertex Buffer Object
         glGenBuffers(1, &posBuffer);
         glBindBuffer(GL_ARRAY_BUFFER, posBuffer);
-        glBufferData(GL_ARRAY_BUFFER, pos.size() * sizeof(glm::vec2), &pos[0], GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, pos.size() * sizeof(glm::vec2), &pos[0], GL_DYNAMIC_DRAW);
 
         glBindVertexArray(planeVAO);
         glEnableVertexAttribArray(3);
@@ -195,7 +195,7 @@ namespace vantor::Helpers::FileSystem
         return filename;
     }
 
-    std::string RemoveExtension(const std::string &filename)
+    inline std::string RemoveExtension(const std::string &filename)
     {
         size_t idx = filename.rfind('.');
 
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #define SID(string) vantor::Helpers::hashString(string)
 
@@ -45,4 +46,17 @@ namespace vantor::Helpers
         std::string str(cStr);
         return hashString(str);
     }
+
+    // FNV-1a; constexpr so IDs built from string literals are folded at
+    // compile time (used for uniform and material parameter lookups).
+    constexpr unsigned int hashID(std::string_view str)
+    {
+        unsigned int hash = 2166136261u;
+        for (char c : str)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
 } // namespace vantor::Helpers
\ No newline at end of file
@@ -20,6 +20,10 @@
 
 #include "vantorWindow.h"
 
+#ifdef VANTOR_API_OPENGL
+#include "../Graphics/RenderDevice/DeviceOpenGL/vantorOpenGLExtensions.hpp"
+#endif
+
 // TODO: FullScreen for SDL2
 // !! WARNING: MUST BE CHANGED WHEN VULKAN USED!!
 
@@ -133,6 +137,9 @@ namespace vantor::Platform
             vantor::Backlog::Log("Window", "Failed to initialize GLAD with SDL2", vantor::Backlog::LogLevel::ERR);
             return 0;
         }
+#ifdef VANTOR_API_OPENGL
+        vantor::Graphics::RenderDevice::OpenGL::Extensions::Load((GLADloadproc) SDL_GL_GetProcAddress);
+#endif
         return 1;
 #endif
 #ifdef VANTOR_WM_GLFW
@@ -141,6 +148,9 @@ namespace vantor::Platform
             vantor::Backlog::Log("Window", "Failed to initialize GLAD with GLFW", vantor::Backlog::LogLevel::ERR);
             return 0;
         }
+#ifdef VANTOR_API_OPENGL
+        vantor::Graphics::RenderDevice::OpenGL::Extensions::Load((GLADloadproc) glfwGetProcAddress);
+#endif
         return 1;
 #endif
     }
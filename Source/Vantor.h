@@ -85,6 +85,7 @@ with RenderDevice Vulkan (Defined in CMake) (RESERVED, BUT NOT IN USE)
 #include "Graphics/Geometry/Primitives/vantorSphere.hpp"
 #include "Graphics/Geometry/Primitives/vantorLine.hpp"
 #include "Graphics/Geometry/Primitives/vantorPlane.hpp"
+#include "Graphics/Geometry/Primitives/vantorPrimitiveCache.hpp"
 #include "Graphics/Geometry/Primitives/vantorQuad.hpp"
 #include "Graphics/Geometry/Primitives/vantorSphere.hpp"
 #include "Graphics/Geometry/Primitives/vantorTorus.hpp"
@@ -4,7 +4,11 @@ in vec3 WorldPos;
 
 uniform samplerCube background;
 
-uniform float lodLevel;
+// per-material parameters, see Material::Bind
+layout (std140, binding = 1) uniform Material
+{
+    float lodLevel;
+};
 
 void main()
 {
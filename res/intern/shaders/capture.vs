@@ -5,6 +5,7 @@ layout (location = 1) in vec2 texCoords;
 layout (location = 2) in vec3 normal;
 
 #include common/uniforms.glsl
+#include common/vertex_format.glsl
 
 out vec2 TexCoords;
 out vec3 FragPos;
@@ -15,8 +16,8 @@ uniform mat4 model;
 void main()
 {
 	TexCoords = texCoords;
-	FragPos   = vec3(model * vec4(pos, 1.0f));
-	Normal    = mat3(model) * normal;
+	FragPos   = vec3(model * vec4(decodePosition(pos), 1.0f));
+	Normal    = mat3(model) * decodeNormal(normal);
 	
 	gl_Position =  projection * view * vec4(FragPos, 1.0);
 }
\ No newline at end of file
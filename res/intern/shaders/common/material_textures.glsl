@@ -0,0 +1,33 @@
+#ifndef MATERIAL_TEXTURES_GLSL
+#define MATERIAL_TEXTURES_GLSL
+// Material texture declarations for every MATERIAL_TEXTURE_MODE. Declare the
+// material's 2D textures between MATERIAL_TEXTURES_BEGIN/END and sample them
+// with SAMPLE_MATERIAL; in the bindless and array modes the list becomes the
+// shader's "Material" uniform block (binding 1).
+//
+//   MATERIAL_TEXTURES_BEGIN
+//       MATERIAL_TEXTURE(TexAlbedo)
+//   MATERIAL_TEXTURES_END
+//   ...
+//   vec4 albedo = SAMPLE_MATERIAL(TexAlbedo, UV0);
+#if defined(VANTOR_BINDLESS)
+    // resident texture handles (GL_ARB_bindless_texture)
+    #define MATERIAL_TEXTURES_BEGIN layout (std140, binding = 1) uniform Material {
+    #define MATERIAL_TEXTURES_END };
+    #define MATERIAL_TEXTURE(name) sampler2D name;
+    #define SAMPLE_MATERIAL(name, uv) texture(name, uv)
+#elif defined(VANTOR_TEXTURE_ARRAYS)
+    // {array, layer} into the shared arrays bound on units 16..23
+    uniform sampler2DArray TextureArrays[8];
+    #define MATERIAL_TEXTURES_BEGIN layout (std140, binding = 1) uniform Material {
+    #define MATERIAL_TEXTURES_END };
+    #define MATERIAL_TEXTURE(name) ivec2 name;
+    #define SAMPLE_MATERIAL(name, uv) texture(TextureArrays[name.x], vec3(uv, float(name.y)))
+#else
+    // one texture unit per sampler
+    #define MATERIAL_TEXTURES_BEGIN
+    #define MATERIAL_TEXTURES_END
+    #define MATERIAL_TEXTURE(name) uniform sampler2D name;
+    #define SAMPLE_MATERIAL(name, uv) texture(name, uv)
+#endif
+#endif
@@ -0,0 +1,56 @@
+#ifndef VERTEX_FORMAT_GLSL
+#define VERTEX_FORMAT_GLSL
+// Decodes the compact vertex formats a Mesh can be finalized with (see
+// VERTEX_FORMAT in vantorOpenGLMesh.hpp). Keep the usual attribute
+// declarations and pass them through these; for a float mesh they return
+// their input unchanged. The uniforms are set per draw by the renderer.
+//
+//   vec3 pos    = decodePosition(aPos);
+//   vec3 normal = decodeNormal(aNormal);
+
+#define VERTEX_QUANTIZED_POSITIONS 1
+#define VERTEX_OCTAHEDRAL_TBN      4
+
+uniform int  vertexFormat;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+vec3 octDecode(vec2 e)
+{
+    vec3  n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
+vec3 decodePosition(vec3 pos)
+{
+    // unorm16 in [0, 1] relative to the mesh's bounding box
+    if ((vertexFormat & VERTEX_QUANTIZED_POSITIONS) != 0)
+        return positionOffset + pos * positionScale;
+    return pos;
+}
+
+vec3 decodeNormal(vec3 normal)
+{
+    if ((vertexFormat & VERTEX_OCTAHEDRAL_TBN) != 0)
+        return octDecode(normal.xy);
+    return normal;
+}
+
+vec3 decodeTangent(vec3 tangent)
+{
+    if ((vertexFormat & VERTEX_OCTAHEDRAL_TBN) != 0)
+        return octDecode(tangent.xy);
+    return tangent;
+}
+
+// takes the decoded normal and tangent; the packed tangent carries the
+// bitangent's handedness in z
+vec3 decodeBitangent(vec3 bitangent, vec3 normal, vec3 tangent, vec3 packedTangent)
+{
+    if ((vertexFormat & VERTEX_OCTAHEDRAL_TBN) != 0)
+        return cross(normal, tangent) * packedTangent.z;
+    return bitangent;
+}
+#endif
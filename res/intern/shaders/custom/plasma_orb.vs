@@ -8,6 +8,7 @@ out vec3 FragPos;
 out vec3 Normal;
 
 #include ../common/uniforms.glsl
+#include ../common/vertex_format.glsl
 
 uniform mat4 model;
 
@@ -28,11 +29,11 @@ void main()
     vec3 noise2 = (normalize(texture(TexPerllin, uv2).rgb * 2.0 - 1.0)) * 0.5;
     vec3 noise3 = (normalize(texture(TexPerllin, uv3).rgb * 2.0 - 1.0)) * 0.25; 
     vec3 noise  = (noise1 + noise2 + noise3) / 1.75;
-    vec3 localPos = aPos + noise * Strength;
+    vec3 localPos = decodePosition(aPos) + noise * Strength;
     
 	TexCoords = aUV;
 	FragPos   = vec3(model * vec4(localPos, 1.0));
-	Normal    = mat3(model) * aNormal;
+	Normal    = mat3(model) * decodeNormal(aNormal);
     
 	gl_Position =  projection * view * vec4(FragPos, 1.0);
 }
\ No newline at end of file
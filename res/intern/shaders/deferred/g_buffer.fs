@@ -10,21 +10,26 @@ in mat3 TBN;
 in vec4 ClipSpacePos;
 in vec4 PrevClipSpacePos;
 
-uniform sampler2D TexAlbedo;
-uniform sampler2D TexNormal;
-uniform sampler2D TexMetallic;
-uniform sampler2D TexRoughness;
-uniform sampler2D TexAO;
+#include ../common/material_textures.glsl
+
+MATERIAL_TEXTURES_BEGIN
+    MATERIAL_TEXTURE(TexAlbedo)
+    MATERIAL_TEXTURE(TexNormal)
+    MATERIAL_TEXTURE(TexMetallic)
+    MATERIAL_TEXTURE(TexRoughness)
+    MATERIAL_TEXTURE(TexAO)
+MATERIAL_TEXTURES_END
 
 void main()
 {    
     // store the fragment position vector in the first gbuffer texture
     gPositionMetallic.rgb = FragPos;
-    gPositionMetallic.a = texture(TexMetallic, UV0).r;
+    gPositionMetallic.a = SAMPLE_MATERIAL(TexMetallic, UV0).r;
     // also store the per-fragment (bump-)normals into the gbuffer
-    float roughness = texture(TexRoughness, UV0).r;
-    vec3 N = texture(TexNormal, UV0).rgb;    
-    N = normalize(N * 2.0 - 1.0);
+    float roughness = SAMPLE_MATERIAL(TexRoughness, UV0).r;
+    // cooked normal maps are two channel (BC5), so z is rebuilt from x and y
+    vec2 NXY = SAMPLE_MATERIAL(TexNormal, UV0).rg * 2.0 - 1.0;
+    vec3 N = vec3(NXY, sqrt(max(1.0 - dot(NXY, NXY), 0.0)));
     // N = mix(N, vec3(0.0, 0.0, 1.0), pow(roughness, 0.5)); // smooth normal based on roughness (to reduce specular aliasing)
     // N.x *= 2.0;
     // N.y *= 2.0;
@@ -33,8 +38,8 @@ void main()
     gNormalRoughness.rgb = normalize(N);
     gNormalRoughness.a = roughness;
     // and the diffuse per-fragment color
-    gAlbedoAO.rgb = texture(TexAlbedo, UV0).rgb;
-    gAlbedoAO.a = texture(TexAO, UV0).r;
+    gAlbedoAO.rgb = SAMPLE_MATERIAL(TexAlbedo, UV0).rgb;
+    gAlbedoAO.a = SAMPLE_MATERIAL(TexAO, UV0).r;
     // per-fragment motion vector
     vec2 clipSpace = ClipSpacePos.xy / ClipSpacePos.w;
     vec2 prevClipSpace = PrevClipSpacePos.xy / PrevClipSpacePos.w;
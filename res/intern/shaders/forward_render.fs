@@ -9,24 +9,27 @@ in vec3 Normal;
 #include common/shadows.glsl
 #include common/uniforms.glsl
 #include pbr/pbr.glsl
+#include common/material_textures.glsl
 
-uniform sampler2D TexAlbedo;
-uniform sampler2D TexNormal;
-uniform sampler2D TexMetallic;
-uniform sampler2D TexRoughness;
-uniform sampler2D TexAO;
+MATERIAL_TEXTURES_BEGIN
+    MATERIAL_TEXTURE(TexAlbedo)
+    MATERIAL_TEXTURE(TexNormal)
+    MATERIAL_TEXTURE(TexMetallic)
+    MATERIAL_TEXTURE(TexRoughness)
+    MATERIAL_TEXTURE(TexAO)
+MATERIAL_TEXTURES_END
 
 uniform sampler2D lightShadowMap1;
 uniform mat4 lightShadowViewProjection1;
 
 void main()
 {
-    vec4 albedo = texture(TexAlbedo, TexCoords);
+    vec4 albedo = SAMPLE_MATERIAL(TexAlbedo, TexCoords);
     #ifdef ALPHA_BLEND
         albedo.rgb *= albedo.a; // pre-multiplied alpha
     #endif
-    float metallic = texture(TexMetallic, TexCoords).r;
-    float roughness = texture(TexRoughness, TexCoords).r;
+    float metallic = SAMPLE_MATERIAL(TexMetallic, TexCoords).r;
+    float roughness = SAMPLE_MATERIAL(TexRoughness, TexCoords).r;
     vec3 N = normalize(Normal); // TODO: normal mapping
     vec3 L = normalize(-dirLight0_Dir.xyz);
     
@@ -1,7 +1,11 @@
 #version 420 core
 out vec4 FragColor;
 
-uniform vec3 lightColor;
+// per-material parameters, see Material::Bind
+layout (std140, binding = 1) uniform Material
+{
+    vec3 lightColor;
+};
 
 void main()
 {